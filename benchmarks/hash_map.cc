@@ -0,0 +1,117 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  helix `map` (the swiss table in the prelude) against std::map and std::unordered_map:         //
+//    - insert 1M random integer keys, then look up every key and as many missing ones            //
+//    - the same with string keys                                                                 //
+//    - erase half of the keys, then insert as many new ones (tombstone reuse)                    //
+//                                                                                                //
+//  build and run (the prelude header comes from the dump-prelude target, see xmake.lua):         //
+//    xmake f -m release && xmake build bench-hash_map && xmake run bench-hash_map                //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+constexpr std::size_t elements = 1'000'000;
+
+template <typename Fn>
+double time_ms(Fn &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <typename Map, typename Key>
+void run(const char             *name,
+         const std::vector<Key> &present,
+         const std::vector<Key> &missing,
+         std::uint64_t          &sink) {
+    Map table;
+
+    const double insert_ms = time_ms([&] {
+        for (std::size_t i = 0; i < present.size(); ++i) {
+            table[present[i]] = i;
+        }
+    });
+
+    const double lookup_ms = time_ms([&] {
+        for (std::size_t i = 0; i < present.size(); ++i) {
+            sink += table.find(present[i])->second;
+            sink += table.find(missing[i]) == table.end() ? 1 : 0;
+        }
+    });
+
+    const double churn_ms = time_ms([&] {
+        for (std::size_t i = 0; i < present.size(); i += 2) {
+            table.erase(present[i]);
+            table[missing[i]] = i;
+        }
+    });
+
+    sink += table.size();
+
+    std::printf("  %-20s insert %8.1f ms   lookup %8.1f ms   erase+insert %8.1f ms\n",
+                name,
+                insert_ms,
+                lookup_ms,
+                churn_ms);
+}
+
+template <typename Key>
+void compare(const char *title, const std::vector<Key> &present, const std::vector<Key> &missing) {
+    std::uint64_t sink = 0;
+
+    std::printf("%s\n", title);
+    run<std::map<Key, std::uint64_t>>("std::map", present, missing, sink);
+    run<std::unordered_map<Key, std::uint64_t>>("std::unordered_map", present, missing, sink);
+    run<helix::std::hash_map<Key, std::uint64_t>>("helix map", present, missing, sink);
+    std::printf("  (checksum %llu)\n\n", static_cast<unsigned long long>(sink));
+}
+}  // namespace
+
+int main() {
+    std::mt19937_64 rng(42);
+
+    std::vector<std::uint64_t> ints(elements * 2);
+
+    for (auto &key : ints) {
+        key = rng();
+    }
+
+    const std::vector<std::uint64_t> present_ints(ints.begin(), ints.begin() + elements);
+    const std::vector<std::uint64_t> missing_ints(ints.begin() + elements, ints.end());
+
+    compare("u64 keys", present_ints, missing_ints);
+
+    std::vector<std::string> present_strings;
+    std::vector<std::string> missing_strings;
+
+    for (std::size_t i = 0; i < elements; ++i) {
+        present_strings.push_back("key_" + std::to_string(present_ints[i]));
+        missing_strings.push_back("key_" + std::to_string(missing_ints[i]));
+    }
+
+    compare("string keys", present_strings, missing_strings);
+}
@@ -0,0 +1,108 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  `parallel for` and the par_ algorithms of the prelude against their serial versions:          //
+//    - a loop over 10M elements doing a few dozen instructions each (par_for)                    //
+//    - summing 10M doubles (par_reduce), run twice to check the result does not change           //
+//    - sorting 10M random integers (par_sort against std::sort)                                  //
+//                                                                                                //
+//  build and run (the prelude header comes from the dump-prelude target, see xmake.lua):         //
+//    xmake f -m release && xmake build bench-parallel && xmake run bench-parallel                //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+constexpr std::size_t elements = 10'000'000;
+
+template <typename Fn>
+double time_ms(Fn &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+double work(double value) { return std::sqrt(value) * std::sin(value) + std::log1p(value); }
+}  // namespace
+
+int main() {
+    std::mt19937_64     rng(42);
+    std::vector<double> values(elements);
+
+    for (auto &value : values) {
+        value = static_cast<double>(rng() % 1'000'000) / 7.0;
+    }
+
+    std::vector<double> out(elements);
+
+    const double serial_for = time_ms([&] {
+        for (std::size_t i = 0; i < elements; ++i) {
+            out[i] = work(values[i]);
+        }
+    });
+
+    const double parallel_for = time_ms([&] {
+        helix::std::par_for(0UZ, elements, [&](std::size_t i) { out[i] = work(values[i]); });
+    });
+
+    const auto plus = [](double a, double b) { return a + b; };
+
+    double serial_sum   = 0;
+    double parallel_sum = 0;
+    double again_sum    = 0;
+
+    const double serial_reduce =
+        time_ms([&] { serial_sum = std::accumulate(values.begin(), values.end(), 0.0); });
+
+    const double parallel_reduce =
+        time_ms([&] { parallel_sum = helix::std::par_reduce(values, 0.0, plus); });
+
+    again_sum = helix::std::par_reduce(values, 0.0, plus);
+
+    std::vector<std::uint64_t> keys(elements);
+
+    for (auto &key : keys) {
+        key = rng();
+    }
+
+    auto serial_keys   = keys;
+    auto parallel_keys = keys;
+
+    const double serial_sort =
+        time_ms([&] { std::sort(serial_keys.begin(), serial_keys.end()); });
+    const double parallel_sort = time_ms([&] { helix::std::par_sort(parallel_keys); });
+
+    std::printf("%u threads\n", std::thread::hardware_concurrency());
+    std::printf("  for      serial %8.1f ms   parallel %8.1f ms\n", serial_for, parallel_for);
+    std::printf("  reduce   serial %8.1f ms   parallel %8.1f ms   (%.3f, %.3f, same: %s)\n",
+                serial_reduce,
+                parallel_reduce,
+                serial_sum,
+                parallel_sum,
+                parallel_sum == again_sum ? "yes" : "no");
+    std::printf("  sort     serial %8.1f ms   parallel %8.1f ms   (equal: %s)\n",
+                serial_sort,
+                parallel_sort,
+                serial_keys == parallel_keys ? "yes" : "no");
+}
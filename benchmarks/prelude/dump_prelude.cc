@@ -0,0 +1,23 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  Writes the prelude, a string inside the compiler, to stdout. The `dump-prelude` xmake target  //
+//  runs it after building and leaves the header in build/prelude/_H1HJA9ZLO_prelude.hh, where    //
+//  the benchmarks and the runtime tests include it from (see xmake.lua).                         //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <iostream>
+
+#include "generator/include/CX-IR/prelude.hh"
+
+int main() { std::cout << generator::CXIR::prelude; }
@@ -0,0 +1,104 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  Tight numeric loop, `for i in 0..n { sum += i * i; }`, lowered two ways:                      //
+//    - before: a range-for over an iterator object (what tests/range.hlx lowers to)              //
+//    - after:  the counted loop CXIR::emit_counted_for produces                                  //
+//                                                                                                //
+//  build and run:                                                                                //
+//    xmake f -m release && xmake build bench-range_for && xmake run bench-range_for              //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+template <typename T>
+class Range {
+  public:
+    class Iterator {
+      public:
+        explicit Iterator(T current)
+            : current(current) {}
+
+        T         operator*() const { return current; }
+        Iterator &operator++() {
+            ++current;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return current != other.current; }
+
+      private:
+        T current;
+    };
+
+    Range(T start, T end)
+        : start(start)
+        , end_(end) {}
+
+    // opaque to the optimizer the same way a separately compiled range type is
+    [[gnu::noinline]] Iterator begin() const { return Iterator(start); }
+    [[gnu::noinline]] Iterator end() const { return Iterator(end_); }
+
+  private:
+    T start;
+    T end_;
+};
+
+[[gnu::noinline]] std::int64_t before(std::int32_t n) {
+    std::int64_t sum = 0;
+
+    for (auto i : Range<std::int32_t>(0, n)) {
+        sum += static_cast<std::int64_t>(i) * i;
+    }
+
+    return sum;
+}
+
+[[gnu::noinline]] std::int64_t after(std::int32_t n) {
+    std::int64_t sum = 0;
+
+    for (::std::common_type_t<decltype(0), decltype(n)> i = 0, _H1HJA9ZLO_range_end = n;
+         i < _H1HJA9ZLO_range_end;
+         ++i) {
+        sum += static_cast<std::int64_t>(i) * i;
+    }
+
+    return sum;
+}
+
+template <typename Fn>
+double time_ms(Fn &&fn, std::int64_t &result) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int rep = 0; rep < 20; ++rep) {
+        result += fn(100'000'000 - rep);
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+int main() {
+    std::int64_t sink = 0;
+
+    const double before_ms = time_ms(before, sink);
+    const double after_ms  = time_ms(after, sink);
+
+    std::printf("range object : %8.1f ms\n", before_ms);
+    std::printf("counted loop : %8.1f ms\n", after_ms);
+    std::printf("speedup      : %8.2fx (checksum %lld)\n",
+                before_ms / after_ms,
+                static_cast<long long>(sink));
+}
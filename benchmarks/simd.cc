@@ -0,0 +1,143 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  helix::simd (f32x8) against the plain loops it replaces, over 16K floats:                     //
+//    - a dot product, the simd one keeps 8 partial sums and adds them with reduce_add            //
+//    - y = a * x + y (saxpy)                                                                     //
+//  the compiler may vectorize the plain saxpy loop on its own, it can not reorder the float      //
+//  additions of the dot product without -ffast-math                                              //
+//                                                                                                //
+//  build and run (the prelude header comes from the dump-prelude target, see xmake.lua), add     //
+//  --cxflags=-march=native to the xmake f line to use 256 bit registers:                         //
+//    xmake f -m release && xmake build bench-simd && xmake run bench-simd                        //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+constexpr std::size_t elements = 16 * 1024;  // fits in l1 and l2, memory does not hide the math
+constexpr int         rounds   = 10000;
+
+template <typename Fn>
+double time_ms(Fn &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+float dot_scalar(const std::vector<float> &a, const std::vector<float> &b) {
+    float sum = 0;
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+float dot_simd(const std::vector<float> &a, const std::vector<float> &b) {
+    f32x8 sum;
+
+    for (std::size_t i = 0; i < a.size(); i += f32x8::size()) {
+        sum += f32x8::load(a, i) * f32x8::load(b, i);
+    }
+
+    return reduce_add(sum);
+}
+
+void saxpy_scalar(float a, const std::vector<float> &x, std::vector<float> &y) {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        y[i] = a * x[i] + y[i];
+    }
+}
+
+void saxpy_simd(float a, const std::vector<float> &x, std::vector<float> &y) {
+    for (std::size_t i = 0; i < x.size(); i += f32x8::size()) {
+        (a * f32x8::load(x, i) + f32x8::load(y, i)).store(y, i);
+    }
+}
+}  // namespace
+
+int main() {
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+
+    for (std::size_t i = 0; i < elements; ++i) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+
+    float scalar_dot = 0;
+    float simd_dot   = 0;
+
+    // each round of a dot loop bumps one element of b so the call is not loop invariant, the
+    // bumps are undone after the loop so both loops see the same inputs
+    const auto undo = [&] {
+        for (int round = 0; round < rounds; ++round) {
+            b[static_cast<std::size_t>(round) % elements] -= 1.0F;
+        }
+    };
+
+    const double scalar_dot_ms = time_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            scalar_dot += dot_scalar(a, b);
+            b[static_cast<std::size_t>(round) % elements] += 1.0F;
+        }
+    });
+
+    undo();
+
+    const double simd_dot_ms = time_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            simd_dot += dot_simd(a, b);
+            b[static_cast<std::size_t>(round) % elements] += 1.0F;
+        }
+    });
+
+    undo();
+
+    std::vector<float> scalar_y = b;
+    std::vector<float> simd_y   = b;
+
+    const double scalar_saxpy_ms = time_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            saxpy_scalar(0.5F, a, scalar_y);
+        }
+    });
+
+    const double simd_saxpy_ms = time_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            saxpy_simd(0.5F, a, simd_y);
+        }
+    });
+
+    std::printf("  dot      scalar %8.1f ms   simd %8.1f ms   (%.3f, %.3f)\n",
+                scalar_dot_ms,
+                simd_dot_ms,
+                scalar_dot,
+                simd_dot);
+    std::printf("  saxpy    scalar %8.1f ms   simd %8.1f ms   (equal: %s)\n",
+                scalar_saxpy_ms,
+                simd_saxpy_ms,
+                scalar_y == simd_y ? "yes" : "no");
+}
@@ -0,0 +1,97 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  the small_vector and small_string of the prelude against std::vector and std::string:         //
+//    - 10M times build a list of 4 integers, grow it to 6 and sum it (argument pack sized)       //
+//    - 10M times build a 40 character key from two parts and hash it                             //
+//                                                                                                //
+//  build and run (the prelude header comes from the dump-prelude target, see xmake.lua):         //
+//    xmake f -m release && xmake build bench-small_vector && xmake run bench-small_vector        //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+constexpr std::size_t rounds = 10'000'000;
+
+template <typename Fn>
+double time_ms(Fn &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <typename List>
+std::uint64_t lists() {
+    std::uint64_t sum = 0;
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        List values = {int(i), int(i + 1), int(i + 2), int(i + 3)};
+        values.push_back(int(i + 4));
+        values.push_back(int(i + 5));
+
+        for (const int value : values) {
+            sum += static_cast<std::uint64_t>(value);
+        }
+    }
+
+    return sum;
+}
+
+template <typename String>
+std::uint64_t keys() {
+    const std::string_view prefix = "request/session/0123456789/";
+    std::uint64_t          sum    = 0;
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        String key(prefix);
+        key += "user-";
+        key += static_cast<char>('a' + i % 26);
+        key += "-profile";
+
+        sum += std::hash<std::string_view>()(std::string_view(key));
+    }
+
+    return sum;
+}
+}  // namespace
+
+int main() {
+    std::uint64_t vector_sum = 0;
+    std::uint64_t small_sum  = 0;
+    std::uint64_t string_sum = 0;
+    std::uint64_t inline_sum = 0;
+
+    const double vector_ms = time_ms([&] { vector_sum = lists<std::vector<int>>(); });
+    const double small_ms  = time_ms([&] { small_sum = lists<helix::std::small_vector<int>>(); });
+    const double string_ms = time_ms([&] { string_sum = keys<std::string>(); });
+    const double inline_ms = time_ms([&] { inline_sum = keys<helix::std::small_string<>>(); });
+
+    std::printf("  list of 6    std::vector %8.1f ms   small_vector %8.1f ms   (same: %s)\n",
+                vector_ms,
+                small_ms,
+                vector_sum == small_sum ? "yes" : "no");
+    std::printf("  40 chars     std::string %8.1f ms   small_string %8.1f ms   (same: %s)\n",
+                string_ms,
+                inline_ms,
+                string_sum == inline_sum ? "yes" : "no");
+}
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "controller/include/config/Controller_config.def"
 #include "neo-types/include/hxint.hh"
@@ -70,8 +71,13 @@ options:
     --emit-ast               Show AST in json format
     --emit-ir                Show intermediate representation. (C++)
     --emit-doc               Only extract doc-comments along with signatures in json format.
+    --inline-report          Show which functions were emitted inline and why.
 
-    --toolchain <options-3>  Set the toolchain to use
+    -j --jobs <n>            Compile the generated c++ with up to n jobs. (default: all cores)
+    --cache-stats            Show the hit rate and size of the object cache.
+    --run [-- <args>]        Run the program in memory with the JIT, no executable is written.
+
+    --toolchain <compiler>   Use this c++ compiler, [clang:|gcc:|msvc:]<path>. (see options-3)
 
     --config <file>          Specify configuration file.
     -r --release             Build in release mode.
@@ -125,7 +131,16 @@ __CONTROLLER_CLI_BEGIN {
         bool emit_ir     = false;
         bool emit_doc    = false;
 
+        bool inline_report = false;
+
+        u32  jobs        = 0;  ///< 0 means one job per hardware thread
+        bool cache_stats = false;
+
+        bool                     run = false;
+        std::vector<std::string> program_args;  ///< after `--`, passed to the program by --run
+
         struct tool_chain {
+            std::string compiler;  ///< --toolchain, empty to discover the host compiler
             std::string target;
             std::string arch;
             std::string cpu;
@@ -136,7 +151,7 @@ __CONTROLLER_CLI_BEGIN {
 
         std::string config_file;
 
-        MODE build_mode;
+        MODE build_mode = MODE::RELEASE;
         ABI  build_lib;  // if --lib is passed without [-py, -rs, -cx, -hlx] then assume -hlx
 
         std::vector<std::string> include_dirs;
@@ -0,0 +1,49 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#ifndef __JOB_POOL_HH__
+#define __JOB_POOL_HH__
+
+#include <functional>
+#include <vector>
+
+#include "controller/include/config/Controller_config.def"
+#include "neo-types/include/hxint.hh"
+
+__CONTROLLER_JOBS_BEGIN {
+    /// runs independent jobs (compiler invocations) on a bounded number of threads
+    ///
+    /// jobs are started in submission order, `wait` blocks until every job has finished and
+    /// rethrows the first exception a job threw. the pool can be reused after `wait`
+    class JobPool {
+      public:
+        /// `workers` == 0 uses one worker per hardware thread
+        explicit JobPool(size_t workers = 0);
+
+        JobPool(const JobPool &)            = delete;
+        JobPool(JobPool &&)                 = default;
+        JobPool &operator=(const JobPool &) = delete;
+        JobPool &operator=(JobPool &&)      = default;
+        ~JobPool()                          = default;
+
+        void submit(std::function<void()> job);
+        void wait();
+
+        [[nodiscard]] size_t worker_count() const { return workers; }
+
+      private:
+        size_t                             workers;
+        std::vector<std::function<void()>> pending;
+    };
+}  // __CONTROLLER_JOBS_BEGIN
+
+#endif  // __JOB_POOL_HH__
@@ -18,6 +18,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -38,6 +39,26 @@ __CONTROLLER_FS_BEGIN {
 
     std::optional<std::string> get_line(const std::string &filename, u64 line);
 
+    /// per user directory for build artifacts that outlive a single compile (pch, objects, ...)
+    /// `$HELIX_CACHE_DIR`, else the platform cache directory, else the temp directory
+    fs_path get_cache_dir();
+
+    /// write to a sibling temporary and rename it over `path`, a concurrent reader sees either
+    /// the old or the new contents but never a partial file
+    bool write_file_atomic(const fs_path &path, std::string_view contents);
+
+    /// a unique sibling of `path` to build into before renaming it over `path`
+    fs_path temporary_sibling(const fs_path &path);
+
+    /// fnv-1a, stable across runs and platforms, used to key on-disk caches
+    constexpr u64 content_hash(std::string_view data, u64 hash = 14695981039346656037ULL) {
+        for (const char chr : data) {
+            hash = (hash ^ static_cast<u8>(chr)) * 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
     class FileCache {
       public:
         static void add_file(const std::string &key, const std::string &value);
@@ -0,0 +1,119 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file object_cache.hh                                                                       ///
+///  @brief A content addressed cache for the outputs of the c++ compiler.                       ///
+///                                                                                              ///
+///  An entry is keyed by everything that decides the output: the generated sources, the         ///
+///     headers they `#include "..."`, the compiler identity (its `--version` output), the       ///
+///     flags and the prelude text. A hit copies the stored object or executable into place and  ///
+///     the c++ compiler is not run at all.                                                      ///
+///                                                                                              ///
+///     <cache>/objects/<first two hex digits>/<key>                                             ///
+///     <cache>/objects/stats                                                                    ///
+///                                                                                              ///
+///  Entries are written to a temporary sibling and renamed into place, so concurrent helix      ///
+///     processes never see a partial entry. A hit refreshes the entry's modification time and   ///
+///     the least recently used entries are evicted once the cache outgrows its size limit.      ///
+///     The stats file holds the counts and the total size and is updated the same way,          ///
+///     concurrent runs may lose a count but never corrupt it. The directory is only walked      ///
+///     when the total passes the limit, that walk also corrects the total.                      ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __OBJECT_CACHE_HH__
+#define __OBJECT_CACHE_HH__
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/config/Controller_config.def"
+#include "controller/include/shared/file_system.hh"
+#include "neo-types/include/hxint.hh"
+
+__CONTROLLER_FS_BEGIN {
+    class ObjectCache {
+      public:
+        struct Stats {
+            u64 hits    = 0;
+            u64 misses  = 0;
+            u64 entries = 0;
+            u64 size    = 0;  ///< bytes on disk
+            u64 limit   = 0;  ///< bytes
+        };
+
+        static constexpr u64 default_limit = u64(2) << 30;  ///< 2 GiB
+
+        /// `$HELIX_CACHE_LIMIT` (in MiB) overrides `limit`
+        explicit ObjectCache(u64 limit = default_limit);
+
+        /// key for an output built from `inputs` (files, read in order) and `identity` (compiler
+        /// version output and flags). the prelude text is always part of the key, and so is
+        /// every header the inputs `#include "..."`, looked up next to the file that includes it
+        [[nodiscard]] static std::string key(const std::vector<fs_path> &inputs,
+                                             std::string_view            identity);
+
+        /// same as above for inputs that only exist in memory, as if they were in `include_dir`
+        [[nodiscard]] static std::string key(const std::vector<std::string_view> &contents,
+                                             std::string_view                     identity,
+                                             const fs_path &include_dir = get_cwd());
+
+        ObjectCache(const ObjectCache &)            = delete;
+        ObjectCache(ObjectCache &&)                 = delete;
+        ObjectCache &operator=(const ObjectCache &) = delete;
+        ObjectCache &operator=(ObjectCache &&)      = delete;
+        ~ObjectCache()                              = default;
+
+        /// copy the entry for `key` to `dest`, false on a miss
+        bool fetch(const std::string &key, const fs_path &dest);
+
+        /// store a copy of `src` as the entry for `key` and evict old entries if needed
+        void store(const std::string &key, const fs_path &src);
+
+        /// lifetime hit and miss counts plus the current size of the cache, from the stats file
+        [[nodiscard]] Stats stats() const;
+
+        /// human readable form of stats(), used by --cache-stats
+        [[nodiscard]] std::string report() const;
+
+      private:
+        struct Entry {
+            fs_path                         path;
+            u64                             size;
+            std::filesystem::file_time_type used;
+        };
+
+        fs_path    dir;
+        u64        limit;
+        u64        run_hits   = 0;
+        u64        run_misses = 0;
+        std::mutex stats_mutex;  ///< fetch and store are called from the compile jobs
+
+        [[nodiscard]] fs_path entry(const std::string &key) const;
+        void                  record(bool hit);
+
+        /// the stats file, its totals come from a scan (and `scanned` is set) if it has none yet
+        [[nodiscard]] Stats load(bool *scanned = nullptr) const;
+        void                save(const Stats &current) const;
+
+        /// every entry on disk, `current` gets the exact totals
+        std::vector<Entry> scan(Stats &current) const;
+
+        /// drop the least recently used entries until `current` is back under the limit
+        void evict(Stats &current) const;
+    };
+}  // __CONTROLLER_FS_BEGIN
+
+#endif  // __OBJECT_CACHE_HH__
@@ -0,0 +1,56 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file prelude_cache.hh                                                                      ///
+///  @brief On-disk home of the prelude header and its precompiled form.                         ///
+///                                                                                              ///
+///  Every (compiler, flag set, prelude text) triple gets its own directory under the cache dir: ///
+///                                                                                              ///
+///     <cache>/prelude/<key>/_H1HJA9ZLO_prelude.hh                                              ///
+///     <cache>/prelude/<key>/_H1HJA9ZLO_prelude.hh.pch   (clang)                                ///
+///     <cache>/prelude/<key>/_H1HJA9ZLO_prelude.hh.gch   (gcc)                                  ///
+///                                                                                              ///
+///  Both compilers pick the pch up on their own when the header is passed with `-include`, and ///
+///     fall back to parsing the header if it is missing or was built with other flags.          ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __PRELUDE_CACHE_HH__
+#define __PRELUDE_CACHE_HH__
+
+#include <string>
+
+#include "controller/include/config/Controller_config.def"
+#include "controller/include/shared/file_system.hh"
+
+__CONTROLLER_FS_BEGIN {
+    class PreludeCache {
+      public:
+        /// `compiler_id` is whatever identifies the compiler build (the `--version` output),
+        /// `flags` are the flags the pch and every translation unit using it are compiled with
+        PreludeCache(const std::string &compiler_id, const std::string &flags);
+
+        [[nodiscard]] const fs_path &directory() const { return dir; }
+        [[nodiscard]] const fs_path &header() const { return header_path; }
+        [[nodiscard]] fs_path        pch(bool is_clang) const;
+
+        /// write the header into the cache if it is not there yet
+        [[nodiscard]] bool ensure_header() const;
+        [[nodiscard]] bool has_pch(bool is_clang) const;
+
+      private:
+        fs_path dir;
+        fs_path header_path;
+    };
+}  // __CONTROLLER_FS_BEGIN
+
+#endif  // __PRELUDE_CACHE_HH__
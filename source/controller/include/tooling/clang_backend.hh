@@ -0,0 +1,100 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file clang_backend.hh                                                                      ///
+///  @brief Compiles cx-ir with the clang and lld libraries helix is linked against.             ///
+///                                                                                              ///
+///  The clang driver turns the usual command line into a compiler invocation, the sources are   ///
+///     served from memory through an overlay file system and clang runs in this process. The    ///
+///     diagnostics are collected by a consumer instead of being printed, their locations are    ///
+///     presumed locations so `#line` directives in the cx-ir map them back to helix source.     ///
+///                                                                                              ///
+///  `compile_to_module` stops after code generation to ir, the jit takes the module from there. ///
+///                                                                                              ///
+///  Linking asks the driver for the link job (so crt objects, library paths and the c++         ///
+///     runtime are found the same way `clang++` finds them) and runs it with lld in-process.    ///
+///     lld can not always run twice in one process, so a build links once.                      ///
+///                                                                                              ///
+///  clang needs its resource directory (stddef.h, intrinsics, ...) next to the helix binary,    ///
+///     `$HELIX_CLANG_RESOURCE_DIR` overrides it. Without one `available` is false and the       ///
+///     caller falls back to running the system c++ compiler.                                    ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CLANG_BACKEND_HH__
+#define __CLANG_BACKEND_HH__
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/config/Controller_config.def"
+#include "controller/include/shared/file_system.hh"
+#include "controller/include/tooling/diagnostics.hh"
+#include "neo-types/include/hxint.hh"
+
+namespace llvm::orc {
+class ThreadSafeModule;
+}  // namespace llvm::orc
+
+__CONTROLLER_TOOL_BEGIN {
+    class ClangBackend {
+      public:
+        using fs_path = __CONTROLLER_FS_N::fs_path;
+
+        struct Result {
+            bool                    success = true;
+            std::vector<Diagnostic> diagnostics;
+            std::string             output;  ///< linker output, never parsed
+
+            void merge(Result &&other);
+        };
+
+        /// a file only present in memory, it shadows a file with the same path on disk
+        struct VirtualFile {
+            fs_path          path;
+            std::string_view contents;
+        };
+
+        /// the clang version string, part of every cache key in place of `c++ --version`
+        [[nodiscard]] static const std::string &version();
+
+        /// false if the clang resource directory can not be found
+        [[nodiscard]] static bool available();
+
+        /// compile `source` to `object`, `flags` are clang driver flags. `files` are visible to
+        /// the compiler (and may include `source`) without ever being written to disk.
+        /// safe to call from several threads at once
+        [[nodiscard]] static Result compile(const fs_path                  &source,
+                                            const std::vector<VirtualFile> &files,
+                                            const fs_path                  &object,
+                                            const std::vector<std::string> &flags);
+
+        /// compile `source` to llvm ir held in memory, for the jit. `module` is only set on success
+        [[nodiscard]] static Result compile_to_module(const fs_path                  &source,
+                                                      const std::vector<VirtualFile> &files,
+                                                      const std::vector<std::string> &flags,
+                                                      ::llvm::orc::ThreadSafeModule  &module);
+
+        /// precompile `header` to `pch`, the pch is found by `-include <header>` later on
+        [[nodiscard]] static Result precompile_header(const fs_path                  &header,
+                                                      const fs_path                  &pch,
+                                                      const std::vector<std::string> &flags);
+
+        /// link `objects` into the executable `out` with lld
+        [[nodiscard]] static Result link(const std::vector<fs_path>     &objects,
+                                         const fs_path                  &out,
+                                         const std::vector<std::string> &flags);
+    };
+}  // __CONTROLLER_TOOL_BEGIN
+
+#endif  // __CLANG_BACKEND_HH__
@@ -0,0 +1,72 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file diagnostics.hh                                                                        ///
+///  @brief Diagnostics of the c++ compiler as data, and the way back to helix source.           ///
+///                                                                                              ///
+///  The host compiler is asked for machine readable diagnostics, clang writes a SARIF log and   ///
+///     gcc a json array, both are read with glaze. Anything in the output that is not one of    ///
+///     those documents (linker messages) is kept as plain text.                                 ///
+///                                                                                              ///
+///  A diagnostic may point into the generated c++ instead of helix source (clang's SARIF        ///
+///     writer ignores `#line`), a LineMap built from the generated file undoes that.            ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __DIAGNOSTICS_HH__
+#define __DIAGNOSTICS_HH__
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/config/Controller_config.def"
+#include "neo-types/include/hxint.hh"
+
+__CONTROLLER_TOOL_BEGIN {
+    struct Diagnostic {
+        enum class Level : u8 { Note, Warning, Error };
+
+        Level       level = Level::Error;
+        std::string file;  ///< empty if the compiler had no location for it
+        u64         line   = 0;
+        u64         column = 0;
+        std::string message;
+    };
+
+    /// the `#line` directives of one generated file
+    class LineMap {
+      public:
+        LineMap() = default;
+
+        /// `generated` is the path the compiler reports, `source` the text it compiled
+        LineMap(std::string generated, std::string_view source);
+
+        /// point `diagnostic` at the helix source if it is in the generated file after a `#line`
+        void apply(Diagnostic &diagnostic) const;
+
+      private:
+        struct Directive {
+            u64         generated_line = 0;  ///< the line of the directive itself
+            u64         line           = 0;
+            std::string file;
+        };
+
+        std::string            generated;
+        std::vector<Directive> directives;  ///< in source order
+    };
+
+    /// every SARIF log and gcc json array in the compiler output, other text goes to `rest`
+    std::vector<Diagnostic> parse_diagnostics(std::string_view output, std::string *rest = nullptr);
+}  // __CONTROLLER_TOOL_BEGIN
+
+#endif  // __DIAGNOSTICS_HH__
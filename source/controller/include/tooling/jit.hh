@@ -0,0 +1,92 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file jit.hh                                                                                ///
+///  @brief Runs helix programs from memory with llvm's ORC LLLazyJIT, used by `helix --run`.    ///
+///                                                                                              ///
+///  A program is an llvm module, from LLVMEmitter or from cx-ir compiled by ClangBackend. Each  ///
+///     program gets its own JITDylib that also sees the symbols of this process (libc, the c++  ///
+///     runtime). Functions are compiled the first time they are called, so `main` starts        ///
+///     running before the rest of the program has been through code generation.                 ///
+///                                                                                              ///
+///  The session lives until `shutdown` and remembers every program by the key it was added      ///
+///     under, running the same key again skips the front-end. Every run loads a copy of the     ///
+///     module into a fresh JITDylib, so static constructors run and globals start over each     ///
+///     time, and the static destructors run once `main` returns, before the dylib is removed.   ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __JIT_HH__
+#define __JIT_HH__
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "controller/include/config/Controller_config.def"
+
+namespace llvm::orc {
+class JITDylib;
+class LLLazyJIT;
+class ThreadSafeModule;
+}  // namespace llvm::orc
+
+__CONTROLLER_TOOL_BEGIN {
+    class JITSession {
+      public:
+        JITSession(const JITSession &)            = delete;
+        JITSession(JITSession &&)                 = delete;
+        JITSession &operator=(const JITSession &) = delete;
+        JITSession &operator=(JITSession &&)      = delete;
+        ~JITSession();
+
+        /// the session of this process, started on first use
+        static JITSession &global();
+
+        /// end the session, every program is unloaded. the next `global` starts a new one
+        static void shutdown();
+
+        /// false if the jit could not be created for the host, see `get_unavailable_reason`
+        [[nodiscard]] bool available() const { return jit != nullptr; }
+        [[nodiscard]] const std::string &get_unavailable_reason() const { return reason; }
+
+        /// true if a program was added under `key` before
+        [[nodiscard]] bool contains(const std::string &key) const;
+
+        /// add a program, nothing is compiled yet. false with `error` set if it fails
+        bool add(const std::string &key, ::llvm::orc::ThreadSafeModule module, std::string &error);
+
+        /// call `main` of the program added under `key` in a dylib of its own, `args[0]` is the
+        /// program name. the exit code of the program, nullopt with `error` set if it could not
+        /// be started or torn down
+        std::optional<int>
+        run(const std::string &key, const std::vector<std::string> &args, std::string &error);
+
+      private:
+        JITSession();
+
+        struct Program {
+            std::unique_ptr<::llvm::orc::ThreadSafeModule> module;  ///< cloned for every run
+        };
+
+        std::unique_ptr<::llvm::orc::LLLazyJIT>  jit;
+        std::unordered_map<std::string, Program> programs;
+        size_t                                   runs = 0;  ///< names the dylibs
+        mutable std::mutex                       lock;      ///< guards `programs` and `runs`
+        std::string                              reason;
+    };
+}  // __CONTROLLER_TOOL_BEGIN
+
+#endif  // __JIT_HH__
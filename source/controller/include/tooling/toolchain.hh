@@ -0,0 +1,62 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file toolchain.hh                                                                          ///
+///  @brief Discovery of the host c++ compiler, probed once and remembered across runs.          ///
+///                                                                                              ///
+///  Probing runs the compiler (`--version` and one run per optional flag), on windows it runs   ///
+///     vswhere to find msvc. The result is stored as json under the cache dir, keyed by the     ///
+///     path of the binary, and reused for as long as the binary has the same modification time  ///
+///     and size, so an upgraded compiler is probed again:                                       ///
+///                                                                                              ///
+///     <cache>/toolchains/<hash of the path>.json                                               ///
+///                                                                                              ///
+///  `--toolchain [clang:|gcc:|msvc:]<path>` names the compiler explicitly, nothing is run and   ///
+///     the optional flags are assumed from the vendor.                                          ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __TOOLCHAIN_HH__
+#define __TOOLCHAIN_HH__
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "controller/include/config/Controller_config.def"
+#include "controller/include/shared/file_system.hh"
+#include "neo-types/include/hxint.hh"
+
+__CONTROLLER_TOOL_BEGIN {
+    struct Toolchain {
+        using fs_path = __CONTROLLER_FS_N::fs_path;
+
+        enum class Vendor : u8 { Unknown, Clang, GCC, MSVC };
+
+        fs_path     path;  ///< the compiler, for msvc the vcvars64.bat that sets up `cl`
+        Vendor      vendor = Vendor::Unknown;
+        std::string identity;  ///< `--version` output, part of every cache key
+
+        bool sarif_diagnostics = false;  ///< accepts `-fdiagnostics-format=sarif` (clang)
+        bool json_diagnostics  = false;  ///< accepts `-fdiagnostics-format=json` (gcc)
+
+        [[nodiscard]] std::string_view vendor_name() const;
+
+        /// the compiler named by `--toolchain`, nullopt if the vendor can not be told from `spec`
+        static std::optional<Toolchain> from_spec(const std::string &spec);
+
+        /// `c++` on the PATH (msvc through vswhere on windows), probed or taken from the cache
+        static std::optional<Toolchain> discover();
+    };
+}  // __CONTROLLER_TOOL_BEGIN
+
+#endif  // __TOOLCHAIN_HH__
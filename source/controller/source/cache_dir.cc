@@ -0,0 +1,106 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "controller/include/shared/file_system.hh"
+
+__CONTROLLER_FS_BEGIN {
+    fs_path get_cache_dir() {
+        const auto from_env = [](const char *name) -> std::optional<fs_path> {
+            const char *value = std::getenv(name);
+
+            if (value == nullptr || *value == '\0') {
+                return std::nullopt;
+            }
+
+            return fs_path(value);
+        };
+
+        fs_path dir;
+
+        if (auto env = from_env("HELIX_CACHE_DIR")) {
+            dir = *env;
+        }
+#if defined(_WIN32) || defined(_WIN64)
+        else if (auto env = from_env("LOCALAPPDATA")) {
+            dir = *env / "helix" / "cache";
+        }
+#else
+        else if (auto env = from_env("XDG_CACHE_HOME")) {
+            dir = *env / "helix";
+        } else if (auto env = from_env("HOME")) {
+            dir = *env / ".cache" / "helix";
+        }
+#endif
+        else {
+            dir = std::filesystem::temp_directory_path() / "helix-cache";
+        }
+
+        std::error_code err;
+        std::filesystem::create_directories(dir, err);
+
+        return dir;
+    }
+
+    fs_path temporary_sibling(const fs_path &path) {
+        // the thread id and the clock are enough to not collide with another compiler process
+        const auto unique = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                            static_cast<size_t>(
+                                std::chrono::steady_clock::now().time_since_epoch().count());
+
+        fs_path tmp = path;
+        tmp += ".tmp" + std::to_string(unique);
+
+        return tmp;
+    }
+
+    bool write_file_atomic(const fs_path &path, std::string_view contents) {
+        std::error_code err;
+        std::filesystem::create_directories(path.parent_path(), err);
+
+        const fs_path tmp = temporary_sibling(path);
+
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+
+            if (!file) {
+                return false;
+            }
+
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+            if (!file) {
+                file.close();
+                std::filesystem::remove(tmp, err);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmp, path, err);
+
+        if (err) {
+            std::filesystem::remove(tmp, err);
+            return false;
+        }
+
+        return true;
+    }
+}  // __CONTROLLER_FS_BEGIN
@@ -0,0 +1,350 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticIDs.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Basic/Version.h>
+#include <clang/CodeGen/CodeGenAction.h>
+#include <clang/Driver/Compilation.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Driver/Job.h>
+#include <clang/Driver/Tool.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/Utils.h>
+#include <clang/FrontendTool/Utils.h>
+#include <lld/Common/Driver.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "controller/include/tooling/clang_backend.hh"
+
+LLD_HAS_DRIVER(elf)
+LLD_HAS_DRIVER(macho)
+LLD_HAS_DRIVER(coff)
+
+namespace {
+using Backend    = __CONTROLLER_TOOL_N::ClangBackend;
+using Diagnostic = __CONTROLLER_TOOL_N::Diagnostic;
+
+/// keeps every diagnostic instead of printing it, helix reports them as its own errors
+class CollectingConsumer : public clang::DiagnosticConsumer {
+  public:
+    explicit CollectingConsumer(std::vector<Diagnostic> &out)
+        : out(out) {}
+
+    void HandleDiagnostic(clang::DiagnosticsEngine::Level level,
+                          const clang::Diagnostic        &info) override {
+        DiagnosticConsumer::HandleDiagnostic(level, info);  // keeps the error count
+
+        Diagnostic diagnostic;
+
+        switch (level) {
+            case clang::DiagnosticsEngine::Ignored:
+                return;
+            case clang::DiagnosticsEngine::Note:
+            case clang::DiagnosticsEngine::Remark:
+                diagnostic.level = Diagnostic::Level::Note;
+                break;
+            case clang::DiagnosticsEngine::Warning:
+                diagnostic.level = Diagnostic::Level::Warning;
+                break;
+            case clang::DiagnosticsEngine::Error:
+            case clang::DiagnosticsEngine::Fatal:
+                diagnostic.level = Diagnostic::Level::Error;
+                break;
+        }
+
+        llvm::SmallString<256> message;
+        info.FormatDiagnostic(message);
+        diagnostic.message = message.str().str();
+
+        if (info.getLocation().isValid() && info.hasSourceManager()) {
+            // presumed locations follow `#line`, which is how cx-ir points back at helix code
+            const clang::PresumedLoc loc =
+                info.getSourceManager().getPresumedLoc(info.getLocation());
+
+            if (loc.isValid()) {
+                diagnostic.file   = loc.getFilename();
+                diagnostic.line   = loc.getLine();
+                diagnostic.column = loc.getColumn();
+            }
+        }
+
+        out.push_back(std::move(diagnostic));
+    }
+
+  private:
+    std::vector<Diagnostic> &out;
+};
+
+const std::string &executable() {
+    // the address of any function in helix finds the binary without argv[0]
+    static const std::string path =
+        llvm::sys::fs::getMainExecutable(nullptr, reinterpret_cast<void *>(&executable));
+    return path;
+}
+
+const std::string &resource_dir() {
+    static const std::string dir = [] {
+        if (const char *env = std::getenv("HELIX_CLANG_RESOURCE_DIR"); env != nullptr) {
+            return std::string(env);
+        }
+
+        return clang::driver::Driver::GetResourcesPath(executable());
+    }();
+
+    return dir;
+}
+
+void initialize_llvm() {
+    static std::once_flag once;
+
+    std::call_once(once, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+
+/// the driver is named after helix, so the mode has to be given explicitly
+std::vector<std::string> driver_args(const std::vector<std::string> &flags) {
+    std::vector<std::string> args = {
+        executable(), "--driver-mode=g++", "-resource-dir", resource_dir()};
+    args.insert(args.end(), flags.begin(), flags.end());
+
+    return args;
+}
+
+std::vector<const char *> to_argv(const std::vector<std::string> &args) {
+    std::vector<const char *> argv;
+    argv.reserve(args.size());
+
+    for (const auto &arg : args) {
+        argv.push_back(arg.c_str());
+    }
+
+    return argv;
+}
+
+/// run a single frontend job (compile or precompile) described by a driver command line,
+/// `action` replaces the one the command line asks for (an object file, a pch)
+Backend::Result run_frontend(const std::vector<std::string>          &args,
+                             const std::vector<Backend::VirtualFile> &files,
+                             clang::FrontendAction                   *action = nullptr) {
+    initialize_llvm();
+
+    Backend::Result result;
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memory(
+        new llvm::vfs::InMemoryFileSystem);
+
+    for (const auto &file : files) {
+        memory->addFile(file.path.string(),
+                        0,
+                        llvm::MemoryBuffer::getMemBufferCopy(
+                            llvm::StringRef(file.contents.data(), file.contents.size()),
+                            file.path.string()));
+    }
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> vfs(
+        new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem()));
+    vfs->pushOverlay(memory);
+
+    CollectingConsumer consumer(result.diagnostics);
+
+    llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diag_options(new clang::DiagnosticOptions);
+    clang::CreateInvocationOptions                     options;
+
+    options.Diags =
+        clang::CompilerInstance::createDiagnostics(diag_options.get(), &consumer, false);
+    options.VFS              = vfs;
+    options.ProbePrecompiled = true;  // `-include x.hh` uses x.hh.pch when it is there
+
+    const auto                                 argv = to_argv(args);
+    std::shared_ptr<clang::CompilerInvocation> invocation = clang::createInvocation(argv, options);
+
+    if (invocation == nullptr) {
+        result.success = false;
+        return result;
+    }
+
+    // the driver asks cc1 to leak everything on exit, this process keeps running
+    invocation->getFrontendOpts().DisableFree = false;
+
+    clang::CompilerInstance instance;
+    instance.setInvocation(std::move(invocation));
+    instance.createDiagnostics(&consumer, false);
+    instance.createFileManager(vfs);
+
+    result.success =
+        (action != nullptr ? instance.ExecuteAction(*action)
+                           : clang::ExecuteCompilerInvocation(&instance)) &&
+        consumer.getNumErrors() == 0;
+
+    return result;
+}
+
+/// lld picks the object format from the name it is invoked as
+const char *lld_flavor() {
+    const llvm::Triple triple(llvm::sys::getDefaultTargetTriple());
+
+    if (triple.isOSDarwin()) {
+        return "ld64.lld";
+    }
+
+    if (triple.isWindowsMSVCEnvironment()) {
+        return "lld-link";
+    }
+
+    return "ld.lld";
+}
+}  // namespace
+
+__CONTROLLER_TOOL_BEGIN {
+    void ClangBackend::Result::merge(Result &&other) {
+        success = success && other.success;
+        output += other.output;
+
+        diagnostics.insert(diagnostics.end(),
+                           std::make_move_iterator(other.diagnostics.begin()),
+                           std::make_move_iterator(other.diagnostics.end()));
+    }
+
+    const std::string &ClangBackend::version() {
+        static const std::string version = clang::getClangFullVersion();
+        return version;
+    }
+
+    bool ClangBackend::available() {
+        static const bool found = [] {
+            std::error_code err;
+            return std::filesystem::is_directory(fs_path(resource_dir()) / "include", err);
+        }();
+
+        return found;
+    }
+
+    ClangBackend::Result ClangBackend::compile(const fs_path                  &source,
+                                               const std::vector<VirtualFile> &files,
+                                               const fs_path                  &object,
+                                               const std::vector<std::string> &flags) {
+        std::vector<std::string> args = driver_args(flags);
+        args.insert(args.end(), {"-c", source.string(), "-o", object.string()});
+
+        return run_frontend(args, files);
+    }
+
+    ClangBackend::Result ClangBackend::compile_to_module(const fs_path                  &source,
+                                                         const std::vector<VirtualFile> &files,
+                                                         const std::vector<std::string> &flags,
+                                                         ::llvm::orc::ThreadSafeModule  &module) {
+        auto context = std::make_unique<llvm::LLVMContext>();
+
+        // `-c` only makes the driver build a compile job, nothing is written to `-o`
+        std::vector<std::string> args = driver_args(flags);
+        args.insert(args.end(), {"-c", source.string(), "-o", "-"});
+
+        clang::EmitLLVMOnlyAction action(context.get());
+        Result                    result = run_frontend(args, files, &action);
+
+        std::unique_ptr<llvm::Module> ir = action.takeModule();
+
+        if (!result.success || ir == nullptr) {
+            result.success = false;
+            return result;
+        }
+
+        module = ::llvm::orc::ThreadSafeModule(std::move(ir), std::move(context));
+        return result;
+    }
+
+    ClangBackend::Result ClangBackend::precompile_header(const fs_path                  &header,
+                                                         const fs_path                  &pch,
+                                                         const std::vector<std::string> &flags) {
+        std::vector<std::string> args = driver_args(flags);
+        args.insert(args.end(), {"-x", "c++-header", header.string(), "-o", pch.string()});
+
+        return run_frontend(args, {});
+    }
+
+    ClangBackend::Result ClangBackend::link(const std::vector<fs_path>     &objects,
+                                            const fs_path                  &out,
+                                            const std::vector<std::string> &flags) {
+        Result             result;
+        CollectingConsumer consumer(result.diagnostics);
+
+        // --ld-path only has to name something executable, the job is never run as a process
+        std::vector<std::string> args = driver_args(flags);
+        args.insert(args.end(), {"-fuse-ld=lld", "--ld-path=" + executable()});
+
+        for (const auto &object : objects) {
+            args.push_back(object.string());
+        }
+
+        args.insert(args.end(), {"-o", out.string()});
+
+        clang::DiagnosticsEngine diags(new clang::DiagnosticIDs,
+                                       new clang::DiagnosticOptions,
+                                       &consumer,
+                                       false);
+        clang::driver::Driver    driver(executable(), llvm::sys::getDefaultTargetTriple(), diags);
+
+        const auto                                  argv = to_argv(args);
+        std::unique_ptr<clang::driver::Compilation> compilation(driver.BuildCompilation(argv));
+
+        if (compilation == nullptr || consumer.getNumErrors() != 0) {
+            result.success = false;
+            return result;
+        }
+
+        for (const clang::driver::Command &job : compilation->getJobs()) {
+            if (!job.getCreator().isLinkJob()) {
+                continue;  // dsymutil and the like are not needed to run the program
+            }
+
+            std::vector<const char *> lld_args = {lld_flavor()};
+            lld_args.insert(lld_args.end(), job.getArguments().begin(), job.getArguments().end());
+
+            llvm::raw_string_ostream output(result.output);
+            const lld::Result        linked = lld::lldMain(lld_args,
+                                                    output,
+                                                    output,
+                                                    {{lld::Gnu, &lld::elf::link},
+                                                            {lld::Darwin, &lld::macho::link},
+                                                            {lld::WinLink, &lld::coff::link}});
+            output.flush();
+
+            result.success = result.success && linked.retCode == 0;
+        }
+
+        return result;
+    }
+}  // __CONTROLLER_TOOL_BEGIN
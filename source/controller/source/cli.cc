@@ -72,9 +72,30 @@ Thank you for using Helix!
                             "emit-doc",
                             "Extract and output doc-comments along with signatures in JSON format",
                             {"emit-doc"});
+        args::Flag inline_report(parser,
+                                 "inline-report",
+                                 "Output the inlining decision made for every function",
+                                 {"inline-report"});
+        args::ValueFlag<u32> jobs(parser,
+                                  "jobs",
+                                  "Compile the generated C++ with up to n parallel jobs",
+                                  {'j', "jobs"});
+        args::Flag cache_stats(parser,
+                               "cache-stats",
+                               "Output the hit rate and size of the compiled object cache",
+                               {"cache-stats"});
+        args::Flag run(parser,
+                       "run",
+                       "Run the program in memory with the JIT instead of writing an executable",
+                       {"run"});
 
         args::Group toolchain_group(
             parser, "Cross Compilation Toolchain Options", args::Group::Validators::AtMostOne);
+        args::ValueFlag<std::string> toolchain_compiler(
+            parser,
+            "toolchain",
+            "Use this C++ compiler instead of probing the host, [clang:|gcc:|msvc:]<path>",
+            {"toolchain"});
         args::ValueFlag<std::string> toolchain_target(
             parser, "target", "Specify target triple for cross-compilation", {"target"});
         args::ValueFlag<std::string> toolchain_arch(
@@ -133,6 +154,8 @@ Thank you for using Helix!
         args::ValueFlagList<std::string> module_dirs(
             parser, "moddir", "Specify Helix modules directories", {'m'});
         args::Positional<std::string> input_file(parser, "file", "Specify input file path");
+        args::PositionalList<std::string> program_args(
+            parser, "args", "Arguments passed to the program with --run, after '--'");
 
         parser.LongSeparator(" ");
 
@@ -210,6 +233,17 @@ https://helix-lang.com/ for more information.
             this->emit_ir     = emit_ir;
             this->emit_doc    = emit_doc;
 
+            this->inline_report = inline_report;
+
+            if (jobs) {
+                this->jobs = args::get(jobs);
+            }
+
+            this->cache_stats = cache_stats;
+
+            this->run          = run;
+            this->program_args = args::get(program_args);
+
             if (verbose && quiet) {
                 std::cerr << colors::fg16::red << "Error:" << colors::reset
                           << " Cannot specify both verbose and quiet options." << '\n';
@@ -237,6 +271,9 @@ https://helix-lang.com/ for more information.
                 }
             }
 
+            if (toolchain_compiler) {
+                toolchain.compiler = args::get(toolchain_compiler);
+            }
             if (toolchain_target) {
                 toolchain.target = args::get(toolchain_target);
             }
@@ -277,6 +314,12 @@ https://helix-lang.com/ for more information.
                 "    emit ir: " + std::to_string(static_cast<int>(emit_ir)) + ", \n";
             this->get_all_flags +=
                 "    emit doc: " + std::to_string(static_cast<int>(emit_doc)) + ", \n";
+            this->get_all_flags +=
+                "    inline report: " + std::to_string(static_cast<int>(inline_report)) + ", \n";
+            this->get_all_flags += "    jobs: " + std::to_string(this->jobs) + ", \n";
+            this->get_all_flags +=
+                "    cache stats: " + std::to_string(static_cast<int>(cache_stats)) + ", \n";
+            this->get_all_flags += "    run: " + std::to_string(static_cast<int>(run)) + ", \n";
             this->get_all_flags +=
                 "    release: " + std::to_string(static_cast<int>(release)) + ", \n";
             this->get_all_flags += "    debug: " + std::to_string(static_cast<int>(debug)) + ", \n";
@@ -292,6 +335,7 @@ https://helix-lang.com/ for more information.
 
             this->get_all_flags += "    config file: " + config_file.Get() + ", \n";
             this->get_all_flags += "    output file: " + output_file.Get() + ", \n";
+            this->get_all_flags += "    toolchain: " + toolchain_compiler.Get() + ", \n";
             this->get_all_flags += "    toolchain target: " + toolchain_target.Get() + ", \n";
             this->get_all_flags += "    toolchain arch: " + toolchain_arch.Get() + ", \n";
             this->get_all_flags += "    toolchain cpu: " + toolchain_cpu.Get() + ", \n";
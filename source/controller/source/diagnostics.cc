@@ -0,0 +1,321 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <glaze-json/include/glaze/glaze.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/tooling/diagnostics.hh"
+
+namespace {
+using Diagnostic = __CONTROLLER_TOOL_N::Diagnostic;
+
+// only the parts of the formats helix reads, everything else is skipped by glaze
+
+struct SarifRegion {
+    u64 startLine   = 0;
+    u64 startColumn = 0;
+};
+
+struct SarifArtifactLocation {
+    std::string uri;
+};
+
+struct SarifPhysicalLocation {
+    SarifArtifactLocation artifactLocation;
+    SarifRegion           region;
+};
+
+struct SarifLocation {
+    SarifPhysicalLocation physicalLocation;
+};
+
+struct SarifMessage {
+    std::string text;
+};
+
+struct SarifResult {
+    std::string                level;
+    SarifMessage               message;
+    std::vector<SarifLocation> locations;
+};
+
+struct SarifRun {
+    std::vector<SarifResult> results;
+};
+
+struct SarifLog {
+    std::vector<SarifRun> runs;
+};
+
+struct GccCaret {
+    std::string file;
+    u64         line   = 0;
+    u64         column = 0;
+};
+
+struct GccLocation {
+    GccCaret caret;
+};
+
+struct GccDiagnostic {
+    std::string                kind;
+    std::string                message;
+    std::vector<GccLocation>   locations;
+    std::vector<GccDiagnostic> children;  ///< the notes attached to this diagnostic
+};
+
+constexpr glz::opts lenient{.error_on_unknown_keys = false};
+
+Diagnostic::Level level_of(std::string_view level) {
+    if (level.find("error") != std::string_view::npos) {  // gcc also has "fatal error"
+        return Diagnostic::Level::Error;
+    }
+
+    if (level.find("warning") != std::string_view::npos) {
+        return Diagnostic::Level::Warning;
+    }
+
+    return Diagnostic::Level::Note;
+}
+
+/// `file:///a%20b/c.cc` to `/a b/c.cc`
+std::string path_of_uri(std::string_view uri) {
+    if (uri.starts_with("file://")) {
+        uri.remove_prefix(7);
+    }
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    if (uri.size() > 2 && uri[0] == '/' && uri[2] == ':') {  // `/C:/...`
+        uri.remove_prefix(1);
+    }
+#endif
+
+    std::string path;
+    path.reserve(uri.size());
+
+    for (size_t i = 0; i < uri.size(); ++i) {
+        u8 chr = 0;
+
+        if (uri[i] == '%' && i + 2 < uri.size() &&
+            std::from_chars(uri.data() + i + 1, uri.data() + i + 3, chr, 16).ec == std::errc{}) {
+            path += static_cast<char>(chr);
+            i += 2;
+            continue;
+        }
+
+        path += uri[i];
+    }
+
+    return path;
+}
+
+void append_sarif(const SarifLog &log, std::vector<Diagnostic> &out) {
+    for (const auto &run : log.runs) {
+        for (const auto &result : run.results) {
+            Diagnostic diagnostic{.level   = level_of(result.level),
+                                  .file    = {},
+                                  .line    = 0,
+                                  .column  = 0,
+                                  .message = result.message.text};
+
+            if (!result.locations.empty()) {
+                const auto &location = result.locations.front().physicalLocation;
+
+                diagnostic.file   = path_of_uri(location.artifactLocation.uri);
+                diagnostic.line   = location.region.startLine;
+                diagnostic.column = location.region.startColumn;
+            }
+
+            out.push_back(std::move(diagnostic));
+        }
+    }
+}
+
+void append_gcc(const std::vector<GccDiagnostic> &diagnostics, std::vector<Diagnostic> &out) {
+    for (const auto &entry : diagnostics) {
+        Diagnostic diagnostic{.level   = level_of(entry.kind),
+                              .file    = {},
+                              .line    = 0,
+                              .column  = 0,
+                              .message = entry.message};
+
+        if (!entry.locations.empty()) {
+            const auto &caret = entry.locations.front().caret;
+
+            diagnostic.file   = caret.file;
+            diagnostic.line   = caret.line;
+            diagnostic.column = caret.column;
+        }
+
+        out.push_back(std::move(diagnostic));
+        append_gcc(entry.children, out);
+    }
+}
+
+/// one past the bracket closing the one at `start`, npos if it is never closed
+size_t end_of_document(std::string_view text, size_t start) {
+    size_t depth     = 0;
+    bool   in_string = false;
+
+    for (size_t i = start; i < text.size(); ++i) {
+        const char chr = text[i];
+
+        if (in_string) {
+            if (chr == '\\') {
+                ++i;
+            } else if (chr == '"') {
+                in_string = false;
+            }
+
+            continue;
+        }
+
+        switch (chr) {
+            case '"':
+                in_string = true;
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0) {
+                    return i + 1;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/// true if `document` was one of the two formats, its diagnostics are appended to `out`
+bool parse_document(std::string_view document, std::vector<Diagnostic> &out) {
+    std::string buffer(document);  // glaze wants a null terminated buffer
+
+    if (document.front() == '{') {
+        SarifLog log;
+
+        if (glz::read<lenient>(log, buffer)) {
+            return false;
+        }
+
+        append_sarif(log, out);
+        return true;
+    }
+
+    std::vector<GccDiagnostic> diagnostics;
+
+    if (glz::read<lenient>(diagnostics, buffer)) {
+        return false;
+    }
+
+    append_gcc(diagnostics, out);
+    return true;
+}
+}  // namespace
+
+__CONTROLLER_TOOL_BEGIN {
+    LineMap::LineMap(std::string generated, std::string_view source)
+        : generated(std::filesystem::path(generated).lexically_normal().string()) {
+        u64 line_no = 1;
+
+        for (size_t start = 0; start < source.size(); ++line_no) {
+            size_t end = source.find('\n', start);
+            end        = end == std::string_view::npos ? source.size() : end;
+
+            std::string_view line = source.substr(start, end - start);
+            start                 = end + 1;
+
+            // written by CXIR::write_tokens as `#line <n> "<file>"`
+            if (!line.starts_with("#line ")) {
+                continue;
+            }
+
+            line.remove_prefix(6);
+
+            Directive  directive{.generated_line = line_no, .line = 0, .file = {}};
+            const auto parsed =
+                std::from_chars(line.data(), line.data() + line.size(), directive.line);
+            const auto open   = line.find('"');
+            const auto close  = line.rfind('"');
+
+            if (parsed.ec != std::errc{} || open == close) {
+                continue;
+            }
+
+            directive.file = std::string(line.substr(open + 1, close - open - 1));
+            directives.push_back(std::move(directive));
+        }
+    }
+
+    void LineMap::apply(Diagnostic &diagnostic) const {
+        if (directives.empty() || diagnostic.file.empty() ||
+            std::filesystem::path(diagnostic.file).lexically_normal().string() != generated) {
+            return;
+        }
+
+        // the last directive before the line, the directive names the line that follows it
+        const auto after = std::upper_bound(
+            directives.begin(),
+            directives.end(),
+            diagnostic.line,
+            [](u64 line, const Directive &directive) { return line <= directive.generated_line; });
+
+        if (after == directives.begin()) {
+            return;  // the prelude or anything else emitted before the first helix token
+        }
+
+        const Directive &directive = *std::prev(after);
+
+        diagnostic.file = directive.file;
+        diagnostic.line = directive.line + (diagnostic.line - directive.generated_line - 1);
+    }
+
+    std::vector<Diagnostic> parse_diagnostics(std::string_view output, std::string *rest) {
+        std::vector<Diagnostic> diagnostics;
+
+        for (size_t start = 0; start < output.size();) {
+            const bool at_line_start = start == 0 || output[start - 1] == '\n';
+
+            if (at_line_start && (output[start] == '{' || output[start] == '[')) {
+                const size_t end = end_of_document(output, start);
+
+                if (end != std::string_view::npos &&
+                    parse_document(output.substr(start, end - start), diagnostics)) {
+                    start = end;
+                    continue;
+                }
+            }
+
+            size_t end = output.find('\n', start);
+            end        = end == std::string_view::npos ? output.size() : end + 1;
+
+            if (rest != nullptr) {
+                rest->append(output.substr(start, end - start));
+            }
+
+            start = end;
+        }
+
+        return diagnostics;
+    }
+}  // __CONTROLLER_TOOL_BEGIN
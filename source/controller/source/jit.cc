@@ -0,0 +1,182 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/TargetProcess/TargetExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "controller/include/tooling/jit.hh"
+
+namespace {
+void initialize_llvm() {
+    static std::once_flag once;
+
+    std::call_once(once, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+
+std::unique_ptr<__CONTROLLER_TOOL_N::JITSession> &instance() {
+    static std::unique_ptr<__CONTROLLER_TOOL_N::JITSession> session;
+    return session;
+}
+
+std::mutex &instance_lock() {
+    static std::mutex lock;
+    return lock;
+}
+}  // namespace
+
+__CONTROLLER_TOOL_BEGIN {
+    JITSession::JITSession() {
+        initialize_llvm();
+
+        auto created = llvm::orc::LLLazyJITBuilder().create();
+
+        if (!created) {
+            reason = llvm::toString(created.takeError());
+            return;
+        }
+
+        jit = std::move(*created);
+
+        // one partition per function, only what is called gets compiled
+        jit->setPartitionFunction(llvm::orc::CompileOnDemandLayer::compileRequested);
+    }
+
+    JITSession::~JITSession() = default;
+
+    JITSession &JITSession::global() {
+        std::lock_guard<std::mutex> guard(instance_lock());
+
+        if (instance() == nullptr) {
+            instance().reset(new JITSession());
+        }
+
+        return *instance();
+    }
+
+    void JITSession::shutdown() {
+        std::lock_guard<std::mutex> guard(instance_lock());
+        instance().reset();
+    }
+
+    bool JITSession::contains(const std::string &key) const {
+        std::lock_guard<std::mutex> guard(lock);
+        return programs.contains(key);
+    }
+
+    bool JITSession::add(const std::string          &key,
+                         llvm::orc::ThreadSafeModule module,
+                         std::string                &error) {
+        if (!available()) {
+            error = reason;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        if (!programs.contains(key)) {  // else the new module is the same program
+            programs.emplace(
+                key, Program{std::make_unique<llvm::orc::ThreadSafeModule>(std::move(module))});
+        }
+
+        return true;
+    }
+
+    std::optional<int> JITSession::run(const std::string              &key,
+                                       const std::vector<std::string> &args,
+                                       std::string                    &error) {
+        llvm::orc::ThreadSafeModule module;
+        std::string                 name = "helix.";
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            const auto                  found = programs.find(key);
+
+            if (found == programs.end()) {
+                error = "no program was added as '" + key + "'";
+                return std::nullopt;
+            }
+
+            // the kept module stays untouched, the jit takes ownership of what it is given
+            module = llvm::orc::cloneToNewContext(*found->second.module);
+            name += std::to_string(runs++);
+        }
+
+        const auto fail = [&](llvm::Error err) -> std::optional<int> {
+            error = llvm::toString(std::move(err));
+            return std::nullopt;
+        };
+
+        auto dylib = jit->createJITDylib(name);
+
+        if (!dylib) {
+            return fail(dylib.takeError());
+        }
+
+        // the c library and the c++ runtime come from this process, the same ones helix uses
+        auto process = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            jit->getDataLayout().getGlobalPrefix());
+
+        if (!process) {
+            return fail(process.takeError());
+        }
+
+        dylib->addGenerator(std::move(*process));
+
+        if (auto err = jit->addLazyIRModule(*dylib, std::move(module))) {
+            return fail(std::move(err));
+        }
+
+        if (auto err = jit->initialize(*dylib)) {
+            return fail(std::move(err));
+        }
+
+        // looking main up compiles main, whatever it calls is compiled on the first call
+        auto main = jit->lookup(*dylib, "main");
+
+        if (!main) {
+            return fail(main.takeError());
+        }
+
+        const std::string program = args.empty() ? key : args.front();
+        const auto        rest    = args.empty() ? llvm::ArrayRef<std::string>()
+                                                 : llvm::ArrayRef<std::string>(args).drop_front();
+
+        const int exit_code =
+            llvm::orc::runAsMain(main->toPtr<int (*)(int, char *[])>(), rest, program);
+
+        // static destructors and atexit handlers, while the code they call is still there
+        if (auto err = jit->deinitialize(*dylib)) {
+            return fail(std::move(err));
+        }
+
+        if (auto err = jit->getExecutionSession().removeJITDylib(*dylib)) {
+            return fail(std::move(err));
+        }
+
+        return exit_code;
+    }
+}  // __CONTROLLER_TOOL_BEGIN
@@ -0,0 +1,73 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "controller/include/jobs/job_pool.hh"
+
+__CONTROLLER_JOBS_BEGIN {
+    JobPool::JobPool(size_t workers)
+        : workers(workers != 0 ? workers : std::max(1U, std::thread::hardware_concurrency())) {}
+
+    void JobPool::submit(std::function<void()> job) { pending.push_back(std::move(job)); }
+
+    void JobPool::wait() {
+        std::vector<std::function<void()>> jobs = std::move(pending);
+        pending.clear();
+
+        std::atomic<size_t> next = 0;
+        std::exception_ptr  error;
+        std::mutex          error_mutex;
+
+        // the jobs are coarse (whole compiler processes), a shared counter is all the
+        // scheduling they need
+        const auto worker = [&] {
+            for (size_t i = next++; i < jobs.size(); i = next++) {
+                try {
+                    jobs[i]();
+                } catch (...) {
+                    const std::lock_guard<std::mutex> lock(error_mutex);
+
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        const size_t threads = std::min(workers, jobs.size());
+
+        if (threads <= 1) {
+            worker();
+        } else {
+            std::vector<std::jthread> pool;
+            pool.reserve(threads - 1);
+
+            for (size_t i = 1; i < threads; ++i) {
+                pool.emplace_back(worker);
+            }
+
+            worker();  // the calling thread is one of the workers
+        }  // jthreads join here
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}  // __CONTROLLER_JOBS_BEGIN
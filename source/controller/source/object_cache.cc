@@ -0,0 +1,378 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "controller/include/shared/object_cache.hh"
+#include "generator/include/CX-IR/prelude.hh"
+
+namespace {
+/// a second, independent fnv offset basis so two passes give a 128 bit key
+constexpr u64 second_basis = 0x84222325cbf29ce4ULL;
+
+std::string read_binary(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/// the names of the `#include "..."` lines of `text`, an include in a comment or a disabled
+/// #if block is listed too and only costs a file read
+std::vector<std::string_view> quoted_includes(std::string_view text) {
+    std::vector<std::string_view> names;
+
+    const auto skip_blanks = [](std::string_view &line) {
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+            line.remove_prefix(1);
+        }
+    };
+
+    while (!text.empty()) {
+        const size_t     end  = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        skip_blanks(line);
+
+        if (!line.starts_with('#')) {
+            continue;
+        }
+
+        line.remove_prefix(1);
+        skip_blanks(line);
+
+        if (!line.starts_with("include")) {
+            continue;
+        }
+
+        line.remove_prefix(7);
+        skip_blanks(line);
+
+        if (!line.starts_with('"')) {
+            continue;  // <...> is found on the compiler's own paths, part of its identity
+        }
+
+        line.remove_prefix(1);
+
+        if (const size_t close = line.find('"'); close != std::string_view::npos) {
+            names.push_back(line.substr(0, close));
+        }
+    }
+
+    return names;
+}
+
+/// the key of `sources` (each with the directory its quoted includes are looked up in) plus
+/// every header they include by a quoted name, transitively, so editing a header that an
+/// `ffi "c++" import` pulls in is a different key
+std::string hash_key(const std::vector<std::pair<std::string_view, std::filesystem::path>> &sources,
+                     std::string_view identity) {
+    using std::filesystem::path;
+    using __CONTROLLER_FS_N::content_hash;
+
+    u64 low  = content_hash(generator::CXIR::prelude);
+    u64 high = content_hash(generator::CXIR::prelude, second_basis);
+
+    const auto mix = [&](std::string_view data) {
+        // the length first, so moving bytes between two inputs changes the key
+        const std::string length = std::to_string(data.size()) + ':';
+
+        low  = content_hash(data, content_hash(length, low));
+        high = content_hash(data, content_hash(length, high));
+    };
+
+    std::vector<path> headers;
+    std::set<path>    seen;
+
+    const auto follow = [&](std::string_view text, const path &from) {
+        for (const auto name : quoted_includes(text)) {
+            // the prelude is in the key already, the split header is one of the sources
+            if (name.starts_with("_H1HJA9ZLO_")) {
+                continue;
+            }
+
+            std::error_code err;
+            path            header = from / name;
+
+            if (!std::filesystem::is_regular_file(header, err)) {
+                continue;
+            }
+
+            header = std::filesystem::weakly_canonical(header, err);
+
+            if (!err && seen.insert(header).second) {
+                headers.push_back(header);
+            }
+        }
+    };
+
+    mix(identity);
+
+    for (const auto &[content, include_dir] : sources) {
+        mix(content);
+        follow(content, include_dir);
+    }
+
+    for (size_t i = 0; i < headers.size(); ++i) {  // grows while it is walked
+        const std::string text = read_binary(headers[i]);
+
+        mix(text);
+        follow(text, headers[i].parent_path());
+    }
+
+    return std::format("{:016x}{:016x}", high, low);
+}
+}  // namespace
+
+__CONTROLLER_FS_BEGIN {
+    ObjectCache::ObjectCache(u64 limit)
+        : dir(get_cache_dir() / "objects")
+        , limit(limit) {
+        if (const char *env = std::getenv("HELIX_CACHE_LIMIT"); env != nullptr) {
+            const u64 mib = std::strtoull(env, nullptr, 10);
+
+            if (mib != 0) {
+                this->limit = mib << 20;
+            }
+        }
+    }
+
+    std::string ObjectCache::key(const std::vector<fs_path> &inputs, std::string_view identity) {
+        std::vector<std::string>                          contents;
+        std::vector<std::pair<std::string_view, fs_path>> sources;
+
+        contents.reserve(inputs.size());
+
+        for (const auto &input : inputs) {
+            sources.emplace_back(contents.emplace_back(read_binary(input)), input.parent_path());
+        }
+
+        return hash_key(sources, identity);
+    }
+
+    std::string ObjectCache::key(const std::vector<std::string_view> &contents,
+                                 std::string_view                     identity,
+                                 const fs_path                       &include_dir) {
+        std::vector<std::pair<std::string_view, fs_path>> sources;
+
+        for (const auto content : contents) {
+            sources.emplace_back(content, include_dir);
+        }
+
+        return hash_key(sources, identity);
+    }
+
+    fs_path ObjectCache::entry(const std::string &key) const {
+        return dir / key.substr(0, 2) / key;
+    }
+
+    bool ObjectCache::fetch(const std::string &key, const fs_path &dest) {
+        const fs_path   path = entry(key);
+        std::error_code err;
+
+        if (!std::filesystem::exists(path, err)) {
+            record(false);
+            return false;
+        }
+
+        // copy next to the destination and rename, the destination may be a running executable
+        const fs_path tmp = temporary_sibling(dest);
+        std::filesystem::copy_file(path, tmp, std::filesystem::copy_options::overwrite_existing, err);
+
+        if (!err) {
+            std::filesystem::rename(tmp, dest, err);
+        }
+
+        if (err) {
+            std::filesystem::remove(tmp, err);
+            record(false);
+            return false;
+        }
+
+        // the modification time is the lru clock
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), err);
+
+        record(true);
+        return true;
+    }
+
+    void ObjectCache::store(const std::string &key, const fs_path &src) {
+        const fs_path   path = entry(key);
+        const fs_path   tmp  = temporary_sibling(path);
+        std::error_code err;
+
+        // an entry that is replaced leaves the total, the new one joins it
+        const bool existed  = std::filesystem::is_regular_file(path, err);
+        const u64  replaced = existed ? std::filesystem::file_size(path, err) : 0;
+
+        std::filesystem::create_directories(path.parent_path(), err);
+        std::filesystem::copy_file(src, tmp, std::filesystem::copy_options::overwrite_existing, err);
+
+        if (!err) {
+            std::filesystem::rename(tmp, path, err);
+        }
+
+        if (err) {
+            std::filesystem::remove(tmp, err);
+            return;
+        }
+
+        const u64 size = std::filesystem::file_size(path, err);
+
+        const std::lock_guard<std::mutex> lock(stats_mutex);
+        bool                              scanned = false;
+        Stats                             current = load(&scanned);
+
+        if (!scanned) {  // a scan has counted the new entry already
+            current.size = current.size + (err ? 0 : size) - std::min(current.size, replaced);
+            current.entries += existed ? 0 : 1;
+        }
+
+        if (current.size > limit) {
+            evict(current);
+        }
+
+        save(current);
+    }
+
+    void ObjectCache::record(bool hit) {
+        const std::lock_guard<std::mutex> lock(stats_mutex);
+        ++(hit ? run_hits : run_misses);
+
+        Stats current = load();
+        ++(hit ? current.hits : current.misses);
+
+        save(current);
+    }
+
+    ObjectCache::Stats ObjectCache::stats() const { return load(); }
+
+    ObjectCache::Stats ObjectCache::load(bool *scanned) const {
+        Stats result{.limit = limit};
+        bool  sized = false;
+
+        std::istringstream stats(read_binary(dir / "stats"));
+
+        for (std::string name; stats >> name;) {
+            if (name == "hits") {
+                stats >> result.hits;
+            } else if (name == "misses") {
+                stats >> result.misses;
+            } else if (name == "entries") {
+                stats >> result.entries;
+            } else if (name == "size") {
+                stats >> result.size;
+                sized = true;
+            }
+        }
+
+        if (!sized) {  // a new cache, or one an older helix wrote without the totals
+            scan(result);
+        }
+
+        if (scanned != nullptr) {
+            *scanned = !sized;
+        }
+
+        return result;
+    }
+
+    void ObjectCache::save(const Stats &current) const {
+        write_file_atomic(dir / "stats",
+                          "hits " + std::to_string(current.hits) + "\nmisses " +
+                              std::to_string(current.misses) + "\nentries " +
+                              std::to_string(current.entries) + "\nsize " +
+                              std::to_string(current.size) + "\n");
+    }
+
+    std::vector<ObjectCache::Entry> ObjectCache::scan(Stats &current) const {
+        std::vector<Entry> entries;
+        std::error_code    err;
+
+        current.entries = 0;
+        current.size    = 0;
+
+        for (std::filesystem::recursive_directory_iterator iter(dir, err), end;
+             !err && iter != end;
+             iter.increment(err)) {
+            if (iter->is_regular_file(err) && iter->path().parent_path() != dir) {
+                const u64 size = iter->file_size(err);
+
+                entries.push_back({iter->path(), size, iter->last_write_time(err)});
+                ++current.entries;
+                current.size += size;
+            }
+        }
+
+        return entries;
+    }
+
+    std::string ObjectCache::report() const {
+        const Stats result = stats();
+        const u64   total  = result.hits + result.misses;
+
+        return std::format(
+            "cache directory: {}\n"
+            "entries:         {}\n"
+            "size:            {:.1f} MiB of {:.1f} MiB\n"
+            "hits:            {} ({} this run)\n"
+            "misses:          {} ({} this run)\n"
+            "hit rate:        {:.1f}%",
+            dir.string(),
+            result.entries,
+            static_cast<double>(result.size) / (1 << 20),
+            static_cast<double>(result.limit) / (1 << 20),
+            result.hits,
+            run_hits,
+            result.misses,
+            run_misses,
+            total == 0 ? 0.0 : 100.0 * static_cast<double>(result.hits) / total);
+    }
+
+    void ObjectCache::evict(Stats &current) const {
+        // the running total only says when to look, other processes may have skewed it
+        std::vector<Entry> entries = scan(current);
+
+        if (current.size <= limit) {
+            return;
+        }
+
+        // evict down to 90% so the next few stores do not each pay for a scan and eviction
+        std::sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) {
+            return lhs.used < rhs.used;
+        });
+
+        const u64       target = limit / 10 * 9;
+        std::error_code err;
+
+        for (const auto &old : entries) {
+            if (current.size <= target) {
+                break;
+            }
+
+            if (std::filesystem::remove(old.path, err)) {
+                current.size -= old.size;
+                --current.entries;
+            }
+        }
+    }
+}  // __CONTROLLER_FS_BEGIN
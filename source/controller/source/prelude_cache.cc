@@ -0,0 +1,52 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <filesystem>
+#include <format>
+#include <string>
+
+#include "controller/include/shared/prelude_cache.hh"
+#include "generator/include/CX-IR/prelude.hh"
+
+__CONTROLLER_FS_BEGIN {
+    PreludeCache::PreludeCache(const std::string &compiler_id, const std::string &flags) {
+        u64 key = content_hash(generator::CXIR::prelude);
+        key     = content_hash(compiler_id, key);
+        key     = content_hash(flags, key);
+
+        dir         = get_cache_dir() / "prelude" / std::format("{:016x}", key);
+        header_path = dir / generator::CXIR::prelude_header_name;
+    }
+
+    fs_path PreludeCache::pch(bool is_clang) const {
+        fs_path path = header_path;
+        path += is_clang ? ".pch" : ".gch";
+
+        return path;
+    }
+
+    bool PreludeCache::ensure_header() const {
+        std::error_code err;
+
+        // the key covers the prelude text, an existing header is always the right one
+        if (std::filesystem::exists(header_path, err)) {
+            return true;
+        }
+
+        return write_file_atomic(header_path, generator::CXIR::prelude);
+    }
+
+    bool PreludeCache::has_pch(bool is_clang) const {
+        std::error_code err;
+        return std::filesystem::exists(pch(is_clang), err);
+    }
+}  // __CONTROLLER_FS_BEGIN
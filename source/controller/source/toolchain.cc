@@ -0,0 +1,386 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <glaze-json/include/glaze/glaze.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "controller/include/tooling/toolchain.hh"
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+#define HELIX_POPEN _popen
+#define HELIX_PCLOSE _pclose
+#else
+#define HELIX_POPEN popen
+#define HELIX_PCLOSE pclose
+#endif
+
+namespace {
+using Toolchain = __CONTROLLER_TOOL_N::Toolchain;
+using fs_path   = __CONTROLLER_FS_N::fs_path;
+
+/// what is stored in the cache file, `mtime` and `size` describe the binary that was probed
+struct ProbeRecord {
+    std::string path;
+    i64         mtime = 0;
+    u64         size  = 0;
+    std::string vendor;
+    std::string identity;
+    bool        sarif_diagnostics = false;
+    bool        json_diagnostics  = false;
+};
+
+struct RunResult {
+    std::string output;
+    int         return_code = 0;
+};
+
+RunResult run(const std::string &cmd) {
+    std::array<char, 128> buffer{};
+    RunResult             result;
+
+    auto *pipe = HELIX_POPEN(cmd.c_str(), "r");
+
+    if (pipe == nullptr) {
+        result.return_code = -1;
+        return result;
+    }
+
+    while (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+        result.output += buffer.data();
+    }
+
+    result.return_code = HELIX_PCLOSE(pipe);
+    return result;
+}
+
+Toolchain::Vendor vendor_from_name(std::string_view name) {
+    if (name == "clang") {
+        return Toolchain::Vendor::Clang;
+    }
+
+    if (name == "gcc") {
+        return Toolchain::Vendor::GCC;
+    }
+
+    if (name == "msvc") {
+        return Toolchain::Vendor::MSVC;
+    }
+
+    return Toolchain::Vendor::Unknown;
+}
+
+/// clang names itself in `--version` (apple clang included), gcc installed as `c++` may only
+/// name the distribution and the fsf
+Toolchain::Vendor vendor_from_version(const std::string &version) {
+    if (version.find("clang") != std::string::npos) {
+        return Toolchain::Vendor::Clang;
+    }
+
+    if (version.find("gcc") != std::string::npos || version.find("g++") != std::string::npos ||
+        version.find("GCC") != std::string::npos ||
+        version.find("Free Software Foundation") != std::string::npos) {
+        return Toolchain::Vendor::GCC;
+    }
+
+    return Toolchain::Vendor::Unknown;
+}
+
+/// modification time and size of the file `path` finally points to, nullopt if it is gone
+std::optional<std::pair<i64, u64>> stat_binary(const fs_path &path) {
+    std::error_code err;
+    const fs_path   target = std::filesystem::canonical(path, err);  // c++ is usually a symlink
+
+    if (err) {
+        return std::nullopt;
+    }
+
+    const auto mtime = std::filesystem::last_write_time(target, err);
+
+    if (err) {
+        return std::nullopt;
+    }
+
+    const u64 size = std::filesystem::file_size(target, err);
+
+    if (err) {
+        return std::nullopt;
+    }
+
+    return std::pair<i64, u64>{static_cast<i64>(mtime.time_since_epoch().count()), size};
+}
+
+fs_path record_path(const fs_path &binary) {
+    return __CONTROLLER_FS_N::get_cache_dir() / "toolchains" /
+           std::format("{:016x}.json", __CONTROLLER_FS_N::content_hash(binary.string()));
+}
+
+/// the record for `binary` if it was written for the binary as it is now
+std::optional<ProbeRecord> load_record(const fs_path &binary, std::pair<i64, u64> stat) {
+    ProbeRecord record;
+    std::string buffer;
+
+    if (glz::read_file_json(record, record_path(binary).string(), buffer)) {
+        return std::nullopt;
+    }
+
+    if (record.path != binary.string() || record.mtime != stat.first ||
+        record.size != stat.second) {
+        return std::nullopt;
+    }
+
+    return record;
+}
+
+void save_record(const fs_path &binary, const ProbeRecord &record) {
+    const auto json = glz::write_json(record);
+
+    if (json) {
+        // a cache, a failed write only means the next run probes again
+        __CONTROLLER_FS_N::write_file_atomic(record_path(binary), *json);
+    }
+}
+
+Toolchain from_record(const ProbeRecord &record, const fs_path &binary) {
+    // for msvc the probed binary is vswhere, the toolchain is the vcvars64.bat it found
+    return {.path              = record.vendor == "msvc" ? fs_path(record.identity) : binary,
+            .vendor            = vendor_from_name(record.vendor),
+            .identity          = record.identity,
+            .sarif_diagnostics = record.sarif_diagnostics,
+            .json_diagnostics  = record.json_diagnostics};
+}
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+constexpr std::string_view vswhere =
+    R"(C:\Program Files (x86)\Microsoft Visual Studio\Installer\vswhere.exe)";
+
+/// vswhere stands in for the compiler binary, the visual studio installer updates it
+std::optional<ProbeRecord> probe(const fs_path &binary, std::pair<i64, u64> stat) {
+    auto result = run("\"" + std::string(vswhere) +
+                      "\" -latest -products * -requires "
+                      "Microsoft.VisualStudio.Component.VC.Tools.x86.x64 "
+                      "-property installationPath");
+
+    if (result.return_code != 0 || result.output.empty()) {
+        return std::nullopt;
+    }
+
+    std::string vs_path = result.output;
+    vs_path.erase(vs_path.find_last_not_of(" \n\r\t") + 1);
+
+    const fs_path vcvars = fs_path(vs_path) / "VC" / "Auxiliary" / "Build" / "vcvars64.bat";
+
+    std::error_code err;
+
+    if (!std::filesystem::exists(vcvars, err)) {
+        return std::nullopt;
+    }
+
+    return ProbeRecord{.path     = binary.string(),
+                       .mtime    = stat.first,
+                       .size     = stat.second,
+                       .vendor   = "msvc",
+                       .identity = vcvars.string()};
+}
+#else
+/// the first `name` on the PATH, nullopt if there is none
+std::optional<fs_path> find_program(const std::string &name) {
+    const char *env = std::getenv("PATH");
+
+    if (env == nullptr) {
+        return std::nullopt;
+    }
+
+    const std::string_view paths(env);
+    std::error_code        err;
+
+    for (size_t start = 0; start <= paths.size();) {
+        size_t end = paths.find(':', start);
+        end        = end == std::string_view::npos ? paths.size() : end;
+
+        if (end != start) {
+            const fs_path candidate = fs_path(paths.substr(start, end - start)) / name;
+
+            if (std::filesystem::is_regular_file(candidate, err)) {
+                return candidate;
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return std::nullopt;
+}
+
+bool accepts_flag(const fs_path &binary, std::string_view flag) {
+    return run("\"" + binary.string() + "\" " + std::string(flag) +
+               " -fsyntax-only -x c++ /dev/null 2>&1")
+               .return_code == 0;
+}
+
+std::optional<ProbeRecord> probe(const fs_path &binary, std::pair<i64, u64> stat) {
+    auto result = run("\"" + binary.string() + "\" --version 2>&1");
+
+    if (result.return_code != 0) {
+        return std::nullopt;
+    }
+
+    const Toolchain::Vendor vendor = vendor_from_version(result.output);
+    ProbeRecord             record{.path     = binary.string(),
+                                   .mtime    = stat.first,
+                                   .size     = stat.second,
+                                   .vendor   = vendor == Toolchain::Vendor::Clang ? "clang"
+                                               : vendor == Toolchain::Vendor::GCC ? "gcc"
+                                                                                  : "unknown",
+                                   .identity = result.output};
+
+    if (vendor == Toolchain::Vendor::Clang) {
+        record.sarif_diagnostics = accepts_flag(binary, "-fdiagnostics-format=sarif");
+    } else if (vendor == Toolchain::Vendor::GCC) {
+        record.json_diagnostics = accepts_flag(binary, "-fdiagnostics-format=json");
+    }
+
+    return record;
+}
+
+/// the diagnostics flags of a compiler named by `--toolchain`, probed once for the binary as it
+/// is now and cached like the probe of `discover`. a binary that can not be found keeps both off
+void probe_diagnostics(Toolchain &toolchain) {
+    const auto stat = stat_binary(toolchain.path);
+
+    if (!stat.has_value()) {
+        return;
+    }
+
+    auto record = load_record(toolchain.path, *stat);
+
+    if (!record.has_value()) {
+        record = ProbeRecord{.path     = toolchain.path.string(),
+                             .mtime    = stat->first,
+                             .size     = stat->second,
+                             .vendor   = std::string(toolchain.vendor_name()),
+                             .identity = toolchain.identity};
+
+        if (toolchain.vendor == Toolchain::Vendor::Clang) {
+            record->sarif_diagnostics = accepts_flag(toolchain.path, "-fdiagnostics-format=sarif");
+        } else if (toolchain.vendor == Toolchain::Vendor::GCC) {
+            record->json_diagnostics = accepts_flag(toolchain.path, "-fdiagnostics-format=json");
+        }
+
+        save_record(toolchain.path, *record);
+    }
+
+    // a record written by `discover` probed the flag of the vendor it found
+    toolchain.sarif_diagnostics =
+        toolchain.vendor == Toolchain::Vendor::Clang && record->sarif_diagnostics;
+    toolchain.json_diagnostics =
+        toolchain.vendor == Toolchain::Vendor::GCC && record->json_diagnostics;
+}
+#endif
+}  // namespace
+
+__CONTROLLER_TOOL_BEGIN {
+    std::string_view Toolchain::vendor_name() const {
+        switch (vendor) {
+            case Vendor::Clang:
+                return "clang";
+            case Vendor::GCC:
+                return "gcc";
+            case Vendor::MSVC:
+                return "msvc";
+            case Vendor::Unknown:
+                break;
+        }
+
+        return "unknown";
+    }
+
+    std::optional<Toolchain> Toolchain::from_spec(const std::string &spec) {
+        Toolchain toolchain;
+
+        const size_t colon = spec.find(':');
+
+        // `C:\...` is a path, only a known vendor counts as a prefix
+        if (colon != std::string::npos &&
+            vendor_from_name(std::string_view(spec).substr(0, colon)) != Vendor::Unknown) {
+            toolchain.vendor = vendor_from_name(std::string_view(spec).substr(0, colon));
+            toolchain.path   = spec.substr(colon + 1);
+        } else {
+            const std::string name = fs_path(spec).filename().string();
+
+            toolchain.path   = spec;
+            toolchain.vendor = name.find("clang") != std::string::npos    ? Vendor::Clang
+                               : name.find("g++") != std::string::npos ||
+                                         name.find("gcc") != std::string::npos
+                                   ? Vendor::GCC
+                               : name.find("vcvars") != std::string::npos ? Vendor::MSVC
+                                                                          : Vendor::Unknown;
+        }
+
+        if (toolchain.vendor == Vendor::Unknown) {
+            return std::nullopt;
+        }
+
+        // no --version to go by, the spec and the binary's stat have to identify the compiler
+        toolchain.identity = spec;
+
+        if (const auto stat = stat_binary(toolchain.path); stat.has_value()) {
+            toolchain.identity += std::format(" {} {}", stat->first, stat->second);
+        }
+
+#if !defined(_WIN32) && !defined(WIN32) && !defined(_WIN64) && !defined(WIN64)
+        if (toolchain.vendor == Vendor::Clang || toolchain.vendor == Vendor::GCC) {
+            probe_diagnostics(toolchain);  // not every version has the machine readable format
+        }
+#endif
+
+        return toolchain;
+    }
+
+    std::optional<Toolchain> Toolchain::discover() {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        const std::optional<fs_path> binary = fs_path(vswhere);
+#else
+        const std::optional<fs_path> binary = find_program("c++");
+#endif
+
+        if (!binary.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto stat = stat_binary(*binary);
+
+        if (!stat.has_value()) {
+            return std::nullopt;
+        }
+
+        if (const auto record = load_record(*binary, *stat); record.has_value()) {
+            return from_record(*record, *binary);
+        }
+
+        const auto record = probe(*binary, *stat);
+
+        if (!record.has_value()) {
+            return std::nullopt;
+        }
+
+        save_record(*binary, *record);
+        return from_record(*record, *binary);
+    }
+}  // __CONTROLLER_TOOL_BEGIN
@@ -13,6 +13,7 @@
 #include <clang/Format/Format.h>
 #include <llvm/ADT/StringRef.h>
 
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <regex>
@@ -21,11 +22,22 @@
 
 using namespace clang;
 
+#include <limits>
 #include <memory>
 #include <optional>
+#include <ostream>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "generator/include/CX-IR/escape.hh"
+#include "generator/include/CX-IR/generators.hh"
+#include "generator/include/CX-IR/inline.hh"
+#include "generator/include/CX-IR/instantiations.hh"
+#include "generator/include/CX-IR/partition.hh"
+#include "generator/include/CX-IR/prelude.hh"
 #include "generator/include/CX-IR/tokens.def"
 #include "generator/include/config/Gen_config.def"
 #include "parser/ast/include/AST.hh"
@@ -138,78 +150,184 @@ UseTab:          Never
 GENERATE_CXIR_TOKENS_ENUM_AND_MAPPING;
 
 __CXIR_CODEGEN_BEGIN {
-    class CX_Token {
-      private:
-        u64         line{};
-        u64         column{};
-        u64         length{};
-        cxir_tokens type{};
-        std::string file_name;
-        std::string value;
+    /// text of every fixed token, indexed by cxir_tokens so a lookup is a single load
+    inline constexpr std::array<std::string_view, CXX_TOKENS_COUNT> cxir_tokens_text = [] {
+        std::array<std::string_view, CXX_TOKENS_COUNT> text{};
 
-      public:
-        CX_Token() = default;
-        CX_Token(const token::Token &tok, cxir_tokens set_type)
-            : line(tok.line_number())
-            , column(tok.column_number())
-            , length(tok.length())
-            , type(set_type)
-            , file_name(std::filesystem::path(tok.file_name()).generic_string())
-            , value(std::string(tok.value())) {}
-
-        explicit CX_Token(cxir_tokens type)
-            : length(1)
-            , type(type)
-            , file_name("_H1HJA9ZLO_17.helix-compiler.cxir")
-            , value(cxir_tokens_map.at(type).has_value()
-                        ? std::string(cxir_tokens_map.at(type).value())
-                        : " /* Unknown Token */ ") {}
-
-        CX_Token(cxir_tokens type, std::string value)
-            : length(value.length())
-            , type(type)
-            , file_name("_H1HJA9ZLO_17.helix-compiler.cxir")
-            , value(std::move(value)) {}
-
-        CX_Token(const CX_Token &)            = default;
-        CX_Token(CX_Token &&)                 = delete;
-        CX_Token &operator=(const CX_Token &) = default;
-        CX_Token &operator=(CX_Token &&)      = delete;
-        ~CX_Token()                           = default;
-
-        [[nodiscard]] u64         get_line() const { return line; }
-        [[nodiscard]] u64         get_column() const { return column; }
-        [[nodiscard]] u64         get_length() const { return length; }
-        [[nodiscard]] cxir_tokens get_type() const { return type; }
-        [[nodiscard]] std::string get_file_name() const { return file_name; }
-        [[nodiscard]] std::string get_value() const { return value; }
-        [[nodiscard]] std::string to_CXIR() const {
-            if (value[0] == '#') {
-                return "\n" + value + " ";
+        for (const auto &[kind, str] : cxir_tokens_map.data) {
+            if (!str.empty()) {
+                text[kind] = str;
             }
+        }
+
+        return text;
+    }();
+
+    /// flat storage for the emitted cx-ir tokens, one column per field (struct of arrays).
+    ///
+    /// fixed tokens (keywords, punctuation) store no text at all, their text comes from
+    /// `cxir_tokens_text`. identifiers, literals and other variable text is appended to a single
+    /// string pool and referenced by offset. file names are interned, a token only stores the id.
+    class CX_TokenBuffer {
+      public:
+        static constexpr u32 no_value       = std::numeric_limits<u32>::max();
+        static constexpr u32 synthetic_file = 0;  ///< tokens the compiler made up, line is 0
+
+        CX_TokenBuffer() { file_names.emplace_back("_H1HJA9ZLO_17.helix-compiler.cxir"); }
+
+        CX_TokenBuffer(const CX_TokenBuffer &)            = default;
+        CX_TokenBuffer(CX_TokenBuffer &&)                 = default;
+        CX_TokenBuffer &operator=(const CX_TokenBuffer &) = default;
+        CX_TokenBuffer &operator=(CX_TokenBuffer &&)      = default;
+        ~CX_TokenBuffer()                                 = default;
 
-            if (value == ";") {
-                return "\n" + value + " ";
+        /// a fixed token, e.g. `CXX_LPAREN`
+        void push(cxir_tokens kind) { append(kind, synthetic_file, 0, no_value, 0); }
+
+        /// a token with compiler generated text
+        void push_value(cxir_tokens kind, std::string_view value) {
+            append(kind, synthetic_file, 0, intern(value), static_cast<u32>(value.size()));
+        }
+
+        /// a token that maps back to a token in the helix source
+        void push_token(cxir_tokens kind, const token::Token &tok) {
+            const std::string &value = tok.get_value();
+
+            append(kind,
+                   file_id(tok),
+                   tok.line_number(),
+                   intern(value),
+                   static_cast<u32>(value.size()));
+        }
+
+        void pop_back() {
+            if (offsets.back() != no_value) {
+                pool.resize(offsets.back());  // values are appended in order, this is the last
             }
 
-            if (line == 0) {
-                return " " + value + "\n";
+            kinds.pop_back();
+            files.pop_back();
+            lines.pop_back();
+            offsets.pop_back();
+            lengths.pop_back();
+        }
+
+        [[nodiscard]] size_t      size() const { return kinds.size(); }
+        [[nodiscard]] bool        empty() const { return kinds.empty(); }
+        [[nodiscard]] cxir_tokens kind(size_t i) const { return kinds[i]; }
+        [[nodiscard]] u32         line(size_t i) const { return lines[i]; }
+        [[nodiscard]] u32         file_id(size_t i) const { return files[i]; }
+
+        [[nodiscard]] const std::string &file(size_t i) const { return file_names[files[i]]; }
+
+        [[nodiscard]] std::string_view value(size_t i) const {
+            if (offsets[i] == no_value) {
+                const std::string_view text = cxir_tokens_text[kinds[i]];
+                return text.empty() ? " /* Unknown Token */ " : text;
             }
 
-            return "\n#line " + std::to_string(line) + " \"" + file_name + "\"\n" + value + "\n";
+            return {pool.data() + offsets[i], lengths[i]};
+        }
+
+      private:
+        std::vector<cxir_tokens> kinds;
+        std::vector<u32>         files;
+        std::vector<u32>         lines;
+        std::vector<u32>         offsets;
+        std::vector<u32>         lengths;
+        std::string              pool;
+
+        std::vector<std::string>             file_names;
+        std::unordered_map<std::string, u32> file_ids;  ///< keyed by the raw token file name
+        std::string                          last_file;  ///< one entry cache in front of file_ids
+        u32                                  last_file_id = synthetic_file;
+
+        void append(cxir_tokens kind, u32 file, u32 line, u32 offset, u32 length) {
+            kinds.push_back(kind);
+            files.push_back(file);
+            lines.push_back(line);
+            offsets.push_back(offset);
+            lengths.push_back(length);
+        }
+
+        u32 intern(std::string_view value) {
+            const auto offset = static_cast<u32>(pool.size());
+            pool.append(value);
+
+            return offset;
         }
 
-        [[nodiscard]] std::string to_clean_CXIR() const {
-            if (value[0] == '#') {
-                return value + " ";
+        u32 file_id(const token::Token &tok) {
+            const std::string &name = tok.get_file_name();  // no copy, this runs for every token
+
+            // consecutive tokens almost always come from the same file
+            if (name == last_file && last_file_id != synthetic_file) {
+                return last_file_id;
+            }
+
+            auto [iter, inserted] = file_ids.try_emplace(name, static_cast<u32>(file_names.size()));
+
+            if (inserted) {
+                file_names.emplace_back(std::filesystem::path(name).generic_string());
             }
-            return value + "\n";
+
+            last_file    = name;  // only when the file changes, reuses the capacity
+            last_file_id = iter->second;
+
+            return last_file_id;
         }
     };
 
+    /// the program split into a shared header and the units that include it, see partition.hh
+    struct CX_Units {
+        CX_TokenBuffer              header;
+        std::vector<CX_TokenBuffer> sources;
+    };
+
     class CXIR : public __AST_VISITOR::Visitor {
       private:
-        std::vector<std::unique_ptr<CX_Token>> tokens;
+        CX_TokenBuffer         tokens;
+        InstantiationCollector instantiations;
+        EscapeAnalysis         escapes;
+        GeneratorAnalysis      generators;
+        InlineCostModel        inlining;
+        UnitPartition          partition;
+        CX_Units               units;
+        size_t                 max_units = 1;
+        std::string            units_header;
+        bool                   prelude_by_reference = false;
+        bool                   declarations_only    = false;  ///< function bodies are skipped
+        bool                   in_generator         = false;  ///< `return` is `co_return`
+        bool                   in_async             = false;  ///< `return` and `await` suspend
+        bool                   in_parallel_for      = false;  ///< `return` and `yield` are errors
+        bool                   loop_is_parallel     = false;  ///< `continue` ends the lambda
+        bool                   break_leaves_switch  = false;  ///< and not the loop
+        bool                   in_finally           = false;  ///< `return` and panic are errors
+        bool                   loop_leaves_finally  = false;  ///< so are `break` and `continue`
+
+        /// template parameter name -> concrete argument, only set while emitting an instantiation
+        std::unordered_map<std::string, __AST_N::NodeT<>> generic_substitutions;
+
+        /// lower `for i in a..b` to a counted loop, false if the range is not a range literal
+        bool emit_counted_for(const __AST_NODE::ForPyStatementCore &node);
+
+        /// lower `parallel for` to helix::std::par_for or par_each, the body becomes a lambda
+        void emit_parallel_for(const __AST_NODE::ForState &node);
+
+        /// the c++ return type of `node`, wrapped for generators and async functions
+        void emit_return_type(const __AST_NODE::FuncDecl &node);
+
+        /// `helix::generator<T>`, the return type of a function that yields (see generators.hh)
+        void emit_generator_type(const __AST_NODE::FuncDecl &node, const YieldType &yields);
+
+        /// the license banner and the prelude (or a reference to it) every output starts with
+        void emit_preamble();
+
+        /// fill `units` from `node`, only called when more than one unit was requested
+        void emit_units(const __AST_NODE::Program &node);
+
+        /// emit `decls` for the shared header (`unit` is nullopt) or for one unit
+        void emit_unit_decls(const __AST_N::NodeV<> &decls, std::optional<size_t> unit);
         
       public:
         CXIR()                        = default;
@@ -224,53 +342,78 @@ __CXIR_CODEGEN_BEGIN {
                 return std::nullopt;
             }
 
-            for (const auto &token : tokens) {
-                if (token->get_line() != 0) {
-                    return token->get_file_name();
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                if (tokens.line(i) != 0) {
+                    return tokens.file(i);
                 }
             }
 
             return std::nullopt;
         }
 
-        [[nodiscard]] std::string to_CXIR() const {
-            std::string cxir;
-            u64         current_line_no = 0;
-
-            // normalize tokens
-            // if tokens has a line number, add a new line
-            for (u64 i = 0; i < tokens.size(); ++i) {
-                // normalize so there arent multiple #line
-                if (tokens[i]->get_value()[0] == '#') {
-                    cxir +=  "\n" + tokens[i]->get_value() + " " + tokens[i+1]->get_value() + "\n";
-                    ++i;
-                } else if (tokens[i]->get_value() == ";") {
-                    cxir +=  " " + tokens[i]->get_value() + "\n";
-                } else if (tokens[i]->get_line() == 0 || tokens[i]->get_line() == current_line_no) {
-                    cxir += " " + tokens[i]->get_value() + " ";
-                } else {
-                    cxir += "\n#line " + std::to_string(tokens[i]->get_line()) + " \"" +
-                            tokens[i]->get_file_name() + "\"\n";
-                    cxir += " " + tokens[i]->get_value() + " ";
-                    current_line_no = tokens[i]->get_line();
+        /// stream the cx-ir to `out` in a single pass, a `#line` directive is only written when
+        /// the source line or file of the next token differs from the previous one
+        void write_CXIR(std::ostream &out) const { write_tokens(tokens, out); }
+
+        /// see write_CXIR, used for the header and units of a split program as well
+        static void write_tokens(const CX_TokenBuffer &tokens, std::ostream &out) {
+            u32 current_file    = CX_TokenBuffer::synthetic_file;
+            u64 current_line_no = 0;
+
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                const std::string_view value = tokens.value(i);
+
+                // preprocessor directives (the prelude, #include) take the next token as argument
+                if (!value.empty() && value[0] == '#') {
+                    out << '\n' << value << ' ';
+
+                    if (i + 1 < tokens.size()) {
+                        out << tokens.value(++i);
+                    }
+
+                    out << '\n';
+                    continue;
+                }
+
+                if (value == ";") {
+                    out << " ;\n";
+                    continue;
+                }
+
+                const u64 line = tokens.line(i);
+
+                // file ids are interned, comparing them is the same as comparing the names
+                if (line != 0 && (line != current_line_no || tokens.file_id(i) != current_file)) {
+                    current_line_no = line;
+                    current_file    = tokens.file_id(i);
+
+                    out << "\n#line " << line << " \"" << tokens.file(i) << "\"\n";
                 }
+
+                out << ' ' << value << ' ';
             }
+        }
 
-            // If cxir is empty, log and return early
-            if (cxir.empty()) {
+        [[nodiscard]] std::string to_CXIR() const {
+            std::ostringstream cxir;
+            write_CXIR(cxir);
+
+            if (tokens.empty()) {
                 print("CXIR is empty after processing tokens.");
-                return cxir;
             }
 
-            return cxir;
+            return std::move(cxir).str();
         }
 
         [[nodiscard]] std::string to_readable_CXIR() const {
             std::string cxir;
 
             // Build the CXIR string from tokens
-            for (const auto &token : tokens) {
-                cxir += token->to_clean_CXIR();
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                const std::string_view value = tokens.value(i);
+
+                cxir += value;
+                cxir += !value.empty() && value[0] == '#' ? ' ' : '\n';
             }
 
             // If cxir is empty, log and return early
@@ -283,6 +426,38 @@ __CXIR_CODEGEN_BEGIN {
             return format_cxir(cxir);
         }
 
+        /// emit `#include "<prelude_header_name>"` instead of the prelude text, the caller is
+        /// responsible for making the header (and its pch) visible to the c++ compiler
+        void reference_prelude(bool by_reference) { prelude_by_reference = by_reference; }
+
+        /// also emit the program as up to `count` units sharing a header, which the units
+        /// include as `header_name`. programs that can not be split produce no units
+        void split_units(size_t count, std::string header_name) {
+            max_units    = count;
+            units_header = std::move(header_name);
+        }
+
+        /// the split program, empty unless split_units was called and the program could be split
+        [[nodiscard]] const CX_Units &get_units() const { return units; }
+
+        /// why the program was emitted as a single unit, see UnitPartition
+        [[nodiscard]] const std::string &get_split_reason() const {
+            return partition.get_reason();
+        }
+
+        /// every concrete generic instantiation in the program, collected when visiting it
+        [[nodiscard]] const InstantiationCollector &get_instantiations() const {
+            return instantiations;
+        }
+
+        /// the inlining decision made for every free function in the program
+        [[nodiscard]] const InlineCostModel &get_inlining() const { return inlining; }
+
+        /// emit an explicit instantiation for every generic function in `collected`, as `extern
+        /// template` declarations for the units that use them or as definitions for the one unit
+        /// that instantiates them. classes and structs are skipped, see the definition
+        void emit_instantiations(const InstantiationCollector &collected, bool as_extern);
+
         [[nodiscard]] static std::string format_cxir(const std::string &cxir) {
             // Get the configuration as a string
             std::string config = get_neo_clang_format_config();
@@ -367,6 +542,7 @@ __CXIR_CODEGEN_BEGIN {
         void visit(const parser ::ast ::node ::CatchState &node) override;
         void visit(const parser ::ast ::node ::FinallyState &node) override;
         void visit(const parser ::ast ::node ::TryState &node) override;
+        void visit(const parser ::ast ::node ::WithState &node) override;
         void visit(const parser ::ast ::node ::PanicState &node) override;
         void visit(const parser ::ast ::node ::ExprState &node) override;
         void visit(const parser ::ast ::node ::RequiresParamDecl &node) override;
@@ -0,0 +1,102 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file escape.hh                                                                             ///
+///  @brief Intraprocedural escape analysis for list literals bound to local variables.         ///
+///                                                                                              ///
+///  `let x: list::<i32> = [1, 2, 3];` lowers to a heap allocating std::vector. When `x` is a    ///
+///     local that is only ever indexed, iterated over, or asked for its size it can not grow    ///
+///     and never leaves the function, so the emitter can lower it to a std::array instead.      ///
+///     A short literal that is also grown in place (`x.push_back(4)`) but still never leaves    ///
+///     lowers to a helix::std::small_vector, which keeps the first elements inside the object.  ///
+///                                                                                              ///
+///  Any use of the variable that is not one of the following is treated as an escape:          ///
+///     - `x[i]`             (read or write an element)                                          ///
+///     - `x.size()` etc.    (a member std::array also has, see `fixed_size_members`)             ///
+///     - `x.push_back(e)`   (grows it, only small_vector is left, see `growing_members`)        ///
+///     - `for e in x`       (range for)                                                         ///
+///                                                                                              ///
+///  Tuple literals and object initializers already lower to value types, and set/map          ///
+///     literals to hash tables reserved up front, so only list literals are considered.         ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_ESCAPE_HH__
+#define __CXIR_ESCAPE_HH__
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+__CXIR_CODEGEN_BEGIN {
+    class EscapeAnalysis : public __AST_VISITOR::Walker {
+      public:
+        EscapeAnalysis()                                  = default;
+        EscapeAnalysis(const EscapeAnalysis &)            = default;
+        EscapeAnalysis(EscapeAnalysis &&)                 = default;
+        EscapeAnalysis &operator=(const EscapeAnalysis &) = default;
+        EscapeAnalysis &operator=(EscapeAnalysis &&)      = default;
+        ~EscapeAnalysis() override                        = default;
+
+        /// literals with more elements than this stay on the heap to keep stack frames small
+        static constexpr size_t max_stack_elements = 256;
+
+        /// literals that are grown become small_vectors only if they start with at most this
+        /// many elements, the inline capacity of a small_vector of a small type
+        static constexpr size_t max_small_elements = 8;
+
+        /// analyze every function in the program, any previous result is discarded
+        void analyze(const __AST_NODE::Program &program);
+
+        /// true if `decl` binds a list literal that can be lowered to a std::array
+        [[nodiscard]] bool is_stack_literal(const __AST_NODE::VarDecl &decl) const {
+            return stack_literals.contains(&decl);
+        }
+
+        /// true if `decl` binds a list literal that can be lowered to a helix::std::small_vector
+        [[nodiscard]] bool is_small_literal(const __AST_NODE::VarDecl &decl) const {
+            return small_literals.contains(&decl);
+        }
+
+        using Walker::visit;
+
+        void visit(const __AST_NODE::IdentExpr &node) override;
+        void visit(const __AST_NODE::ArrayAccessExpr &node) override;
+        void visit(const __AST_NODE::DotPathExpr &node) override;
+        void visit(const __AST_NODE::ForPyStatementCore &node) override;
+        void visit(const __AST_NODE::VarDecl &node) override;
+        void visit(const __AST_NODE::LetDecl &node) override;
+        void visit(const __AST_NODE::FuncDecl &node) override;
+
+      private:
+        /// per function state, saved and restored around nested functions
+        struct Frame {
+            std::unordered_map<std::string, const __AST_NODE::VarDecl *> candidates;
+            std::unordered_set<std::string>                             escaped;
+            std::unordered_set<std::string>                             grown;
+        };
+
+        std::vector<Frame>                                frames;
+        std::unordered_set<const __AST_NODE::VarDecl *>  stack_literals;
+        std::unordered_set<const __AST_NODE::VarDecl *>  small_literals;
+
+        [[nodiscard]] bool is_candidate(const __AST_N::NodeT<> &node) const;
+        void               escape(const std::string &name);
+    };
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_ESCAPE_HH__
@@ -0,0 +1,86 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file generators.hh                                                                         ///
+///  @brief Finds the functions that `yield` and the type of the values they yield.              ///
+///                                                                                              ///
+///  A function with a `yield` in its body is a coroutine, the emitter gives it the return type  ///
+///     `helix::generator<T>` (see the prelude) instead of the declared one. T is:               ///
+///     - the declared return type, `fn count(n: i32) -> i32 { ... yield i; }`                   ///
+///     - otherwise the type of the first yielded value, if it is a literal or a parameter or a  ///
+///       local with a declared type or a literal initializer (`let a = 0; yield a;`)            ///
+///                                                                                              ///
+///  Anything else can not be known before the c++ compiler runs, the function must declare it.  ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_GENERATORS_HH__
+#define __CXIR_GENERATORS_HH__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+__CXIR_CODEGEN_BEGIN {
+    /// what a yielding function produces, exactly one of the two is set if it is known
+    struct YieldType {
+        __AST_N::NodeT<__AST_NODE::Type> type;     ///< a declared type
+        __AST_N::NodeT<>                 literal;  ///< a literal, the type is its decltype
+        const __AST_NODE::YieldState    *first = nullptr;
+
+        [[nodiscard]] bool known() const { return type != nullptr || literal != nullptr; }
+    };
+
+    class GeneratorAnalysis : public __AST_VISITOR::Walker {
+      public:
+        GeneratorAnalysis()                                     = default;
+        GeneratorAnalysis(const GeneratorAnalysis &)            = default;
+        GeneratorAnalysis(GeneratorAnalysis &&)                 = default;
+        GeneratorAnalysis &operator=(const GeneratorAnalysis &) = default;
+        GeneratorAnalysis &operator=(GeneratorAnalysis &&)      = default;
+        ~GeneratorAnalysis() override                           = default;
+
+        /// analyze every function in the program, any previous result is discarded
+        void analyze(const __AST_NODE::Program &program);
+
+        /// the yielded type of `func`, null if it never yields
+        [[nodiscard]] const YieldType *yield_type_of(const __AST_NODE::FuncDecl &func) const {
+            const auto found = generators.find(&func);
+            return found == generators.end() ? nullptr : &found->second;
+        }
+
+        using Walker::visit;
+
+        void visit(const __AST_NODE::YieldState &node) override;
+        void visit(const __AST_NODE::LetDecl &node) override;
+        void visit(const __AST_NODE::FuncDecl &node) override;
+
+      private:
+        /// per function state, saved and restored around nested functions
+        struct Frame {
+            std::unordered_map<std::string, YieldType> names;  ///< params and locals
+            YieldType                                  yields;  ///< from the first yield
+        };
+
+        std::vector<Frame>                                          frames;
+        std::unordered_map<const __AST_NODE::FuncDecl *, YieldType> generators;
+
+        /// what is known about the type of `decl`, nothing if it has neither type nor literal
+        static YieldType type_of(const __AST_NODE::VarDecl &decl);
+    };
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_GENERATORS_HH__
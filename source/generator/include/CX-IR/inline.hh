@@ -0,0 +1,126 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file inline.hh                                                                             ///
+///  @brief A size based cost model that decides which free functions are emitted `inline`.     ///
+///                                                                                              ///
+///  The cost of a function is a rough count of the work in its body: one per statement or      ///
+///     operator, plus a penalty for every call and every loop. Small functions, and slightly    ///
+///     larger leaf functions (no calls, no loops) are emitted `inline` so they can live in a    ///
+///     shared header and be inlined across translation units. A function the user marked       ///
+///     `inline` is always emitted with `[[gnu::always_inline]]`.                                ///
+///                                                                                              ///
+///  Methods are not considered since they are defined in the class body and already inline.   ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_INLINE_HH__
+#define __CXIR_INLINE_HH__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "generator/include/config/Gen_config.def"
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+__CXIR_CODEGEN_BEGIN {
+    struct InlineDecision {
+        enum class Kind : u8 { None, Inline, AlwaysInline };
+
+        Kind        kind = Kind::None;
+        std::string name;
+        std::string file;
+        u64         line = 0;
+        u64         cost = 0;
+        bool        leaf = false;
+        std::string reason;
+    };
+
+    class InlineCostModel : public __AST_VISITOR::Walker {
+      public:
+        InlineCostModel()                                   = default;
+        InlineCostModel(const InlineCostModel &)            = default;
+        InlineCostModel(InlineCostModel &&)                 = default;
+        InlineCostModel &operator=(const InlineCostModel &) = default;
+        InlineCostModel &operator=(InlineCostModel &&)      = default;
+        ~InlineCostModel() override                         = default;
+
+        static constexpr u64 call_cost      = 5;
+        static constexpr u64 loop_cost      = 10;
+        static constexpr u64 inline_budget  = 15;  ///< any function up to this cost
+        static constexpr u64 leaf_budget    = 30;  ///< functions without calls or loops
+
+        /// decide for every free function in the program, any previous result is discarded
+        void analyze(const __AST_NODE::Program &program);
+
+        [[nodiscard]] InlineDecision::Kind decision_for(const __AST_NODE::FuncDecl &decl) const {
+            const auto found = decisions.find(&decl);
+            return found != decisions.end() ? order[found->second].kind : InlineDecision::Kind::None;
+        }
+
+        /// the estimated size of a free function, 0 for anything that was not considered
+        [[nodiscard]] u64 cost_of(const __AST_NODE::FuncDecl &decl) const {
+            const auto found = decisions.find(&decl);
+            return found != decisions.end() ? order[found->second].cost : 0;
+        }
+
+        /// decisions in source order
+        [[nodiscard]] const std::vector<InlineDecision> &get_decisions() const { return order; }
+
+        /// one line per function, used by --inline-report
+        [[nodiscard]] std::string report() const;
+
+        using Walker::visit;
+
+        void visit(const __AST_NODE::BinaryExpr &node) override;
+        void visit(const __AST_NODE::UnaryExpr &node) override;
+        void visit(const __AST_NODE::FunctionCallExpr &node) override;
+        void visit(const __AST_NODE::ForState &node) override;
+        void visit(const __AST_NODE::WhileState &node) override;
+        void visit(const __AST_NODE::IfState &node) override;
+        void visit(const __AST_NODE::SwitchCaseState &node) override;
+        void visit(const __AST_NODE::TryState &node) override;
+        void visit(const __AST_NODE::ReturnState &node) override;
+        void visit(const __AST_NODE::ExprState &node) override;
+        void visit(const __AST_NODE::LetDecl &node) override;
+        void visit(const __AST_NODE::ClassDecl &node) override;
+        void visit(const __AST_NODE::StructDecl &node) override;
+        void visit(const __AST_NODE::InterDecl &node) override;
+        void visit(const __AST_NODE::OpDecl &node) override;
+        void visit(const __AST_NODE::FuncDecl &node) override;
+
+      private:
+        struct Frame {
+            std::string name;
+            u64         cost      = 0;
+            u64         calls     = 0;
+            u64         loops     = 0;
+            bool        recursive = false;
+        };
+
+        std::vector<Frame>                                     frames;
+        std::unordered_map<const __AST_NODE::FuncDecl *, size_t> decisions;
+        std::vector<InlineDecision>                            order;
+        u64                                                    skip_depth = 0;  ///< inside a type or operator
+
+        void charge(u64 cost) {
+            if (!frames.empty()) {
+                frames.back().cost += cost;
+            }
+        }
+    };
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_INLINE_HH__
@@ -0,0 +1,121 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file instantiations.hh                                                                     ///
+///  @brief Collects every concrete instantiation of a helix generic across the whole program.   ///
+///                                                                                              ///
+///  Helix generics lower 1:1 to c++ templates, so every translation unit that uses `foo::<i32>` ///
+///     makes the c++ compiler instantiate `foo<i32>` again. The collector finds each unique     ///
+///     instantiation whose arguments are fully concrete, so the emitter can declare them all    ///
+///     `extern template` and explicitly instantiate them exactly once.                          ///
+///                                                                                              ///
+///  Only namespace scope generics are considered and only when the use site names every        ///
+///     template argument explicitly (there is no type information yet to deduce the rest).      ///
+///     Overloaded or otherwise ambiguous names are skipped, and so are instantiations that      ///
+///     depend on a template parameter or name a type that is not visible at namespace scope.    ///
+///                                                                                              ///
+///  @code                                                                                       ///
+///  InstantiationCollector collector;                                                           ///
+///  collector.collect(program);                                                                 ///
+///                                                                                              ///
+///  for (const auto &inst : collector.get_instantiations()) {                                   ///
+///      print(inst.key);                                                                        ///
+///  }                                                                                           ///
+///  @endcode                                                                                    ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_INSTANTIATIONS_HH__
+#define __CXIR_INSTANTIATIONS_HH__
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "generator/include/config/Gen_config.def"
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+__CXIR_CODEGEN_BEGIN {
+    /// a single concrete use of a generic declaration, e.g. `foo::<i32>(...)` or `Box::<f64>`
+    struct Instantiation {
+        enum class Kind : u8 { Function, Class, Struct };
+
+        Kind                     kind;
+        std::string              key;     ///< canonical spelling, e.g. "math::max<i32>"
+        std::vector<std::string> scope;   ///< enclosing modules of the generic declaration
+        std::string              name;    ///< unqualified name of the generic declaration
+        std::vector<std::string> params;  ///< template parameter names, in declaration order
+
+        __AST_N::NodeT<__AST_NODE::GenericInvokeExpr> args;  ///< concrete arguments (first use)
+        __AST_N::NodeT<__AST_NODE::FuncDecl>          func;  ///< only set for Kind::Function
+    };
+
+    class InstantiationCollector : public __AST_VISITOR::Walker {
+      public:
+        InstantiationCollector()                                          = default;
+        InstantiationCollector(const InstantiationCollector &)            = default;
+        InstantiationCollector(InstantiationCollector &&)                 = default;
+        InstantiationCollector &operator=(const InstantiationCollector &) = default;
+        InstantiationCollector &operator=(InstantiationCollector &&)      = default;
+        ~InstantiationCollector() override                                = default;
+
+        /// walk the entire program, any previously collected state is discarded
+        void collect(const __AST_NODE::Program &program);
+
+        [[nodiscard]] const std::vector<Instantiation> &get_instantiations() const {
+            return instantiations;
+        }
+
+        [[nodiscard]] bool empty() const { return instantiations.empty(); }
+
+        using Walker::visit;
+
+        void visit(const __AST_NODE::FunctionCallExpr &node) override;
+        void visit(const __AST_NODE::Type &node) override;
+        void visit(const __AST_NODE::FuncDecl &node) override;
+        void visit(const __AST_NODE::ClassDecl &node) override;
+        void visit(const __AST_NODE::StructDecl &node) override;
+        void visit(const __AST_NODE::InterDecl &node) override;
+        void visit(const __AST_NODE::TypeDecl &node) override;
+
+      private:
+        /// a namespace scope declaration that has a 'requires' clause
+        struct GenericDecl {
+            Instantiation::Kind                  kind;
+            std::vector<std::string>             scope;
+            std::vector<std::string>             params;
+            __AST_N::NodeT<__AST_NODE::FuncDecl> func;
+        };
+
+        std::unordered_map<std::string, std::vector<GenericDecl>> generic_decls;
+        std::unordered_set<std::string>                           namespace_types;
+        std::unordered_set<std::string>                           seen;
+        std::vector<std::vector<std::string>>                     template_params;
+        std::vector<Instantiation>                                instantiations;
+
+        void register_decls(const __AST_N::NodeV<> &decls, std::vector<std::string> &scope);
+        void record(const std::string                                   &name,
+                    const __AST_N::NodeT<__AST_NODE::GenericInvokeExpr> &args);
+
+        [[nodiscard]] bool is_concrete(const __AST_N::NodeT<__AST_NODE::GenericInvokeExpr> &args);
+        void push_params(const __AST_N::NodeT<__AST_NODE::RequiresDecl> &generics);
+        void pop_params(const __AST_N::NodeT<__AST_NODE::RequiresDecl> &generics);
+    };
+
+    /// spell a node as a compact string, used to compare generic arguments between use sites
+    std::string spell_node(const __AST_N::NodeT<> &node);
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_INSTANTIATIONS_HH__
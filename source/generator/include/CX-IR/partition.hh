@@ -0,0 +1,91 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file partition.hh                                                                          ///
+///  @brief Splits a program into translation units that can be compiled in parallel.            ///
+///                                                                                              ///
+///  The split keeps every declaration in one shared header (types, generics, inline functions, ///
+///     ffi includes) and only moves the bodies of out-of-line free functions into the units.   ///
+///     The header declares those functions in their original position, so name lookup sees the ///
+///     same declarations it would in a single unit.                                             ///
+///                                                                                              ///
+///  Functions are distributed by their size from the inline cost model, largest first, each    ///
+///     to the unit with the least work so far.                                                  ///
+///                                                                                              ///
+///  A function is only moved when its signature can be declared twice without change: it has  ///
+///     a body, is not generic or inline, has a plain name and no default arguments. Anything   ///
+///     at namespace scope that would be defined once per unit (globals, operators) makes the    ///
+///     program unsplittable and it is emitted as a single unit as before.                       ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_PARTITION_HH__
+#define __CXIR_PARTITION_HH__
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "generator/include/CX-IR/inline.hh"
+#include "generator/include/config/Gen_config.def"
+#include "neo-types/include/hxint.hh"
+#include "parser/ast/include/AST.hh"
+
+__CXIR_CODEGEN_BEGIN {
+    class UnitPartition {
+      public:
+        UnitPartition()                                 = default;
+        UnitPartition(const UnitPartition &)            = default;
+        UnitPartition(UnitPartition &&)                 = default;
+        UnitPartition &operator=(const UnitPartition &) = default;
+        UnitPartition &operator=(UnitPartition &&)      = default;
+        ~UnitPartition()                                = default;
+
+        /// the least amount of work (in inline cost units) worth giving its own unit
+        static constexpr u64 min_unit_cost = 100;
+
+        /// assign the out-of-line functions of `program` to at most `max_units` units, any
+        /// previous result is discarded
+        void partition(const __AST_NODE::Program &program,
+                       const InlineCostModel     &costs,
+                       size_t                     max_units);
+
+        /// the number of units, 0 if the program has to be emitted as a single unit
+        [[nodiscard]] size_t unit_count() const { return units; }
+
+        /// the unit that defines `decl`, nullopt if it stays in the shared header
+        [[nodiscard]] std::optional<size_t> unit_of(const __AST_NODE::FuncDecl &decl) const {
+            const auto found = assignment.find(&decl);
+
+            if (found == assignment.end()) {
+                return std::nullopt;
+            }
+
+            return found->second;
+        }
+
+        /// why the program was not split, empty if it was
+        [[nodiscard]] const std::string &get_reason() const { return reason; }
+
+      private:
+        std::unordered_map<const __AST_NODE::FuncDecl *, size_t> assignment;
+        std::vector<const __AST_NODE::FuncDecl *>                movable;
+        size_t                                                   units = 0;
+        std::string                                              reason;
+
+        /// false if `decls` contains something that can not be shared between units
+        bool collect(const __AST_N::NodeV<> &decls, const InlineCostModel &costs);
+    };
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_PARTITION_HH__
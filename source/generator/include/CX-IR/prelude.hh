@@ -0,0 +1,3911 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file prelude.hh                                                                            ///
+///  @brief The c++ runtime prelude every generated translation unit depends on.                 ///
+///                                                                                              ///
+///  The prelude is written once per compiler and flag set into the cache directory as a header  ///
+///     and precompiled there (see controller/include/shared/prelude_cache.hh). The cx-ir then   ///
+///     only carries an `#include` of `prelude_header_name` instead of the whole text, so the    ///
+///     c++ front-end does not re-parse <iostream>, <map>, <variant>, ... on every build.        ///
+///                                                                                              ///
+///  The text is wrapped in an include guard so it can be force included (`-include`, which is  ///
+///     what makes clang pick up the pch) and still be included by the cx-ir itself.             ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
+
+#ifndef __CXIR_PRELUDE_HH__
+#define __CXIR_PRELUDE_HH__
+
+#include <string>
+#include <string_view>
+
+#include "generator/include/config/Gen_config.def"
+
+__CXIR_CODEGEN_BEGIN {
+    /// the name the cx-ir includes the prelude by, resolved through the prelude cache directory
+    inline constexpr std::string_view prelude_header_name = "_H1HJA9ZLO_prelude.hh";
+
+    /// the prelude text in pieces, msvc rejects a single string literal over 16380 bytes (C2026)
+    /// and a whole string over 64k, so the text is kept as separate literals joined at startup.
+    /// a piece may end anywhere at a line boundary, keep each one below the limit when editing
+    inline constexpr std::string_view prelude_parts[] = {
+        R"(#ifndef _H1HJA9ZLO_PRELUDE
+#define _H1HJA9ZLO_PRELUDE
+
+// auto c++ includes for the core of the language
+#include <set>
+#include <map>
+#include <algorithm>
+#include <tuple>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <variant>
+#include <sstream>
+#include <utility>
+#include <charconv>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <iostream>
+#include <initializer_list>
+#include <stdexcept>
+#include <thread>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<format>)
+    #include <format>
+#endif
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    #include <io.h>
+#else
+    #include <poll.h>
+    #include <pthread.h>
+    #include <sys/socket.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+    #define _H1HJA9ZLO_PROCESS_POOL
+#endif
+
+// `helix --run`: the jit links a thread_local as one variable all threads share (see
+// thread_slot), and the per thread output buffer would be flushed after the jit freed the program
+#if defined(_H1HJA9ZLO_NO_THREAD_LOCALS) && !defined(_H1HJA9ZLO_UNBUFFERED_OUTPUT)
+    #define _H1HJA9ZLO_UNBUFFERED_OUTPUT
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define _H1HJA9ZLO_SSE2_GROUPS
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define _H1HJA9ZLO_VECTOR_EXTENSIONS
+#endif
+
+#ifdef __GNUG__
+    #include <cxxabi.h>
+    #include <memory>
+#endif
+
+/// language primitive types
+
+/// ensure cross-platform compatibility for 128-bit and 256-bit types.
+/// gcc/clang support these types, but MSVC may not. We can conditionally include them.
+
+using u8   = unsigned char;
+using i8   = signed char;
+using u16  = unsigned short;
+using i16  = signed short;
+using u32  = unsigned int;
+using i32  = signed int;
+using u64  = unsigned long long;
+using i64  = signed long long;
+
+#if !defined(_MSC_VER)
+    using u128 = __uint128_t;
+    using i128 = __int128_t;
+#endif
+
+using f32 = float;
+using f64 = double;
+using f80 = long double;
+
+using usize = std::size_t;
+using isize = std::ptrdiff_t;
+
+using byte = std::byte;
+using string = std::string;
+
+template <typename ...Args>
+using tuple = std::tuple<Args...>;
+template <typename ...Args>
+using list = std::vector<Args...>;
+
+#if __cplusplus < 202002L
+static_assert(false, "helix requires c++20 or higher");
+#endif
+
+/// \include belongs to the helix standard library.
+/// \brief namespace for helix standard library in c++
+namespace helix {
+/// \include belongs to the helix standard library.
+/// \brief namespace for helix standard library
+namespace std {
+/// \include belongs to the helix standard library.
+/// \brief namespace for internal interfaces
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief concept for converting a type to a string
+    ///
+    /// This concept checks if a type has a to_string method that returns a string
+    ///
+    template <typename T>
+    concept ToString = requires(T a) {
+        { a.to_string() } -> ::std::convertible_to<::string>;
+    };
+
+    /// \include belongs to the helix standard library.
+    /// \brief concept for converting a type to a ostream
+    ///
+    /// This concept checks if a type has an ostream operator
+    ///
+    template <typename T>
+    concept OStream = requires(::std::ostream &os, T a) {
+        { os << a } -> ::std::convertible_to<::std::ostream &>;
+    };
+
+    /// \include belongs to the helix standard library.
+    /// \brief concept for converting a type to a string
+    ///
+    /// This concept checks if a type can be converted to a string
+    ///
+    template <typename T>
+    concept CanConvertToStringForm = ToString<T> || OStream<T>;
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief convert any type to a string
+///
+/// This function will try to convert the argument to a string using the following methods:
+/// - if the argument has a to_string method, it will use that
+/// - if the argument has a ostream operator, it will use that
+/// - if the argument is an arithmetic type, it will use std::to_string
+/// - if all else fails, it will convert the address of the argument to a string
+///
+template <typename Expr>
+constexpr ::string any_to_string(Expr &&arg) {
+    if constexpr (__internal_interfaces::ToString<Expr>) {
+        return arg.to_string();
+    } else if constexpr (__internal_interfaces::OStream<Expr>) {
+        ::std::stringstream ss;
+        ss << arg;
+        return ss.str();
+    } else if constexpr (::std::is_arithmetic_v<Expr>) {
+        return ::std::to_string(arg);
+    } else {
+        ::std::stringstream ss;
+    
+#       ifdef __GNUG__
+            int status;
+            char *realname = abi::__cxa_demangle(typeid(arg).name(), 0, 0, &status);
+            ss << "[" << realname << " at 0x" << ::std::hex << &arg << "]";
+            free(realname);
+#       else
+            ss << "[" << typeid(arg).name() << " at 0x" << ::std::hex << &arg << "]";
+#       endif
+
+        return ss.str();
+    }
+}
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief append the text of `arg` to `out`, the same text any_to_string gives
+    ///
+    /// strings and numbers are appended in place (numbers through std::to_chars), the char
+    /// types (i8 and u8 too) as the character, as an ostream writes them. a type with an ostream
+    /// operator goes through a stringstream. the one difference is a type any_to_string can
+    /// only print the address of: if std::format knows it (a vector, a map) it is formatted
+    ///
+    template <typename Expr>
+    void append_to_string(::string &out, Expr &&arg) {
+        using T = ::std::remove_cvref_t<Expr>;
+
+        if constexpr (ToString<T>) {
+            out += arg.to_string();
+        } else if constexpr (::std::is_convertible_v<const T &, ::std::string_view>) {
+            out += ::std::string_view(arg);
+        } else if constexpr (::std::is_same_v<T, char> || ::std::is_same_v<T, signed char> ||
+                             ::std::is_same_v<T, unsigned char>) {
+            out += static_cast<char>(arg);
+        } else if constexpr (::std::is_same_v<T, bool>) {
+            out += arg ? '1' : '0';  // what an ostream writes without boolalpha
+        } else if constexpr (::std::is_integral_v<T> || ::std::is_floating_point_v<T>) {
+            char buffer[64];
+            ::std::to_chars_result result;
+
+            if constexpr (::std::is_floating_point_v<T>) {
+                // %g with 6 digits, the default of an ostream
+                result = ::std::to_chars(
+                    buffer, buffer + sizeof(buffer), arg, ::std::chars_format::general, 6);
+            } else {
+                result = ::std::to_chars(buffer, buffer + sizeof(buffer), arg);
+            }
+
+            out.append(buffer, result.ptr);
+#if defined(__cpp_lib_format_ranges)
+        } else if constexpr (!OStream<T> && ::std::formattable<T, char>) {
+            ::std::format_to(::std::back_inserter(out), "{}", arg);
+#endif
+        } else {
+            out += any_to_string(::std::forward<Expr>(arg));
+        }
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief write all of `text` to stdout with write(2), short writes are retried
+    ///
+    /// stdio is flushed first so what printf (or std::cout, which goes through stdio) wrote
+    /// before still comes out before `text`
+    ///
+    inline void write_stdout(::std::string_view text) {
+        ::std::fflush(stdout);
+
+        while (!text.empty()) {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+            const auto written = ::_write(1, text.data(), static_cast<unsigned>(text.size()));
+#else
+            const auto written = ::write(1, text.data(), text.size());
+#endif
+
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return;  // stdout is gone, there is nowhere left to report it
+            }
+
+            text.remove_prefix(static_cast<size_t>(written));
+        }
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief true if stdout is a terminal, asked once per process
+    ///
+    inline bool stdout_is_terminal() {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        static const bool terminal = ::_isatty(1) != 0;
+#else
+        static const bool terminal = ::isatty(1) != 0;
+#endif
+        return terminal;
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief a `thread_local T` that also holds one value per thread in code run by the jit
+    ///
+    /// orc links the thread locals of jit'd code without a platform runtime, so they end up as
+    /// one variable every thread shares. with _H1HJA9ZLO_NO_THREAD_LOCALS (`helix --run`) the
+    /// value lives in a pthread key instead, malloc'd and freed by the c library when the thread
+    /// exits so no jit'd code runs then. `Tag` makes each slot its own variable
+    ///
+    template <typename T, typename Tag>
+    T &thread_slot() {
+        static_assert(::std::is_trivially_destructible_v<T>, "a slot is never destroyed");
+
+#if defined(_H1HJA9ZLO_NO_THREAD_LOCALS) && defined(_H1HJA9ZLO_PROCESS_POOL)
+        static const pthread_key_t key = [] {
+            pthread_key_t made{};
+
+            if (::pthread_key_create(&made, ::std::free) != 0) {
+                throw ::std::runtime_error("could not create a thread key");
+            }
+
+            return made;
+        }();
+
+        auto *value = static_cast<T *>(::pthread_getspecific(key));
+
+        if (value == nullptr) {
+            value = static_cast<T *>(::std::malloc(sizeof(T)));
+
+            if (value == nullptr) {
+                throw ::std::bad_alloc();
+            }
+
+            ::new (static_cast<void *>(value)) T(Tag::initial);
+            ::pthread_setspecific(key, value);
+        }
+
+        return *value;
+#else
+        thread_local T value = Tag::initial;
+        return value;
+#endif
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the text `print` has formatted but not yet written, one per thread
+    ///
+    /// a print call only appends to the buffer of its own thread, so there is no lock and the
+    /// lines of two threads never interleave mid-line. the buffer is written when a print call
+    /// ends and stdout is a terminal (so prompts show up), when it holds `capacity` bytes or
+    /// more, and when the thread (or the program) exits. a thread also writes it before it
+    /// hands work to another thread: when it starts a task, when a future gets its value and
+    /// when a coroutine suspends on `await`, so output a task caused comes after the output
+    /// that caused the task
+    ///
+    class output_buffer {
+      public:
+        static constexpr size_t capacity = 1 << 16;
+
+        output_buffer() { text.reserve(capacity); }
+        ~output_buffer() { flush(); }
+
+        output_buffer(const output_buffer &)            = delete;
+        output_buffer(output_buffer &&)                 = delete;
+        output_buffer &operator=(const output_buffer &) = delete;
+        output_buffer &operator=(output_buffer &&)      = delete;
+
+        ::string &get() { return text; }
+
+        /// the end of one print call
+        void commit() {
+            if (text.size() >= capacity || stdout_is_terminal()) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (!text.empty()) {
+                write_stdout(text);
+                text.clear();
+            }
+        }
+
+      private:
+        ::string text;
+    };
+
+    inline output_buffer &stdout_buffer() {
+        thread_local output_buffer buffer;
+        return buffer;
+    }
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief write what print has buffered on this thread to stdout
+///
+inline void flush_output() {
+#if !defined(_H1HJA9ZLO_UNBUFFERED_OUTPUT)
+    __internal_interfaces::stdout_buffer().flush();
+#endif
+}
+
+/// \include belongs to the helix standard library.
+/// \brief format a string with arguments
+///
+/// TODO: = is not yet suppoted
+///
+/// the literal is split at compile time, `segments` are the pieces between the arguments. the
+/// result is built in a single buffer that is reserved once
+///
+/// the following calls can happen in helix and becomes the following c++:
+///
+/// f"hi: {var}"   -> format_string({"hi: ", ""}, var)
+/// f"hi: {var1=}" -> format_string({"hi: var1=", ""}, var1)
+///
+/// f"hi: {(some_expr() + 12)=}" -> format_string({"hi: (some_expr() + 12)=", ""}, some_expr())
+/// f"hi: {some_expr() + 12}!"   -> format_string({"hi: ", "!"}, some_expr() + 12)
+///
+template <typename... Expr>
+::string format_string(const ::std::array<::std::string_view, sizeof...(Expr) + 1> &segments,
+                       Expr &&...args) {
+    size_t size = 0;
+
+    for (const auto &segment : segments) {
+        size += segment.size();
+    }
+
+    ::string out;
+    out.reserve(size + sizeof...(Expr) * 16);  // a guess for the arguments, numbers fit
+    out += segments[0];
+
+    size_t next = 1;
+    ((__internal_interfaces::append_to_string(out, ::std::forward<Expr>(args)),
+      out += segments[next++]),
+     ...);
+
+    return out;
+}
+
+/// \include belongs to the helix standard library.
+/// \brief run a callable when the enclosing scope exits, used to lower `finally`
+///
+/// the callable is stored inline and the guard can not be copied or moved, so there is no heap
+/// allocation and no type erasure. leaving the scope costs a single (inlinable) call
+///
+/// try { a } catch e { b } finally { c }  ->  { helix::std::finally _([&]() { c }); try { a } catch (e) { b } }
+///
+/// the destructor is noexcept, a `finally` body that throws terminates the program
+///
+template <typename Fn>
+class finally {
+  public:
+    constexpr explicit finally(Fn fn) noexcept(::std::is_nothrow_move_constructible_v<Fn>)
+        : fn(::std::move(fn)) {}
+
+    finally(const finally &)            = delete;
+    finally(finally &&)                 = delete;
+    finally &operator=(const finally &) = delete;
+    finally &operator=(finally &&)      = delete;
+
+    constexpr ~finally() noexcept { fn(); }
+
+  private:
+    Fn fn;
+};
+
+)",
+        R"(/// \include belongs to the helix standard library.
+/// \brief the guard of a `with` statement, calls `enter()` on the value and `exit()` at the end
+///
+/// with value as name { body }  ->  { auto &&name = value; helix::std::context _(name); body }
+///
+/// either member can be left out. `exit()` also runs when the body throws
+///
+template <typename T>
+class context {
+  public:
+    explicit context(T &managed)
+        : managed(managed) {
+        if constexpr (requires { managed.enter(); }) {
+            managed.enter();
+        }
+    }
+
+    context(const context &)            = delete;
+    context(context &&)                 = delete;
+    context &operator=(const context &) = delete;
+    context &operator=(context &&)      = delete;
+
+    ~context() {
+        if constexpr (requires { managed.exit(); }) {
+            managed.exit();
+        }
+    }
+
+  private:
+    T &managed;
+};
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief control bytes of a swiss table, a full slot holds the low 7 bits of its hash
+    ///
+    inline constexpr i8 ctrl_empty   = -128;  // 0b10000000
+    inline constexpr i8 ctrl_deleted = -2;    // 0b11111110
+
+    /// \include belongs to the helix standard library.
+    /// \brief the slots of a group that matched, `Shift` turns a bit index into a slot index
+    ///
+    template <typename T, int Shift>
+    class bitmask {
+      public:
+        explicit bitmask(T mask)
+            : mask(mask) {}
+
+        explicit operator bool() const { return mask != 0; }
+        size_t   lowest() const { return static_cast<size_t>(::std::countr_zero(mask)) >> Shift; }
+        void     drop_lowest() { mask &= mask - 1; }
+
+      private:
+        T mask;
+    };
+
+#if defined(_H1HJA9ZLO_SSE2_GROUPS)
+    /// \include belongs to the helix standard library.
+    /// \brief 16 control bytes compared at once with sse2
+    ///
+    class group {
+      public:
+        static constexpr size_t width = 16;
+        using mask_t                  = bitmask<u32, 0>;
+
+        explicit group(const i8 *pos)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+        mask_t match(i8 h2) const {
+            const __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl);
+            return mask_t(static_cast<u32>(_mm_movemask_epi8(equal)));
+        }
+
+        mask_t match_empty() const { return match(ctrl_empty); }
+
+        /// empty or deleted, the only control bytes with the sign bit set
+        mask_t match_free() const { return mask_t(static_cast<u32>(_mm_movemask_epi8(ctrl))); }
+
+      private:
+        __m128i ctrl;
+    };
+#else
+    /// \include belongs to the helix standard library.
+    /// \brief 8 control bytes compared at once in a 64 bit word, for targets without sse2
+    ///
+    /// `match` can report a false positive above a real match, always on a full slot, the key
+    /// comparison that follows every match filters it out
+    ///
+    class group {
+      public:
+        static constexpr size_t width = 8;
+        using mask_t                  = bitmask<u64, 3>;
+
+        explicit group(const i8 *pos) {
+            for (size_t i = 0; i < width; ++i) {  // a single load on little endian targets
+                ctrl |= static_cast<u64>(static_cast<u8>(pos[i])) << (i * 8);
+            }
+        }
+
+        mask_t match(i8 h2) const {
+            const u64 x = ctrl ^ (lsbs * static_cast<u8>(h2));
+            return mask_t((x - lsbs) & ~x & msbs);
+        }
+
+        mask_t match_empty() const { return mask_t(ctrl & ~(ctrl << 6) & msbs); }
+        mask_t match_free() const { return mask_t(ctrl & msbs); }
+
+      private:
+        static constexpr u64 lsbs = 0x0101010101010101ULL;
+        static constexpr u64 msbs = 0x8080808080808080ULL;
+
+        u64 ctrl = 0;
+    };
+#endif
+
+    /// \include belongs to the helix standard library.
+    /// \brief spread the bits of a std::hash result, which is the identity for integers
+    ///
+    inline size_t mix_hash(size_t hash) {
+        u64 x = static_cast<u64>(hash);
+
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+
+        return static_cast<size_t>(x);
+    }
+
+    struct map_key {
+        template <typename Slot>
+        const auto &operator()(const Slot &slot) const {
+            return slot.first;
+        }
+    };
+
+    struct set_key {
+        template <typename Slot>
+        const Slot &operator()(const Slot &slot) const {
+            return slot;
+        }
+    };
+
+)",
+        R"(    /// \include belongs to the helix standard library.
+    /// \brief open addressing hash table after abseil's swiss table, the core of hash_map and
+    /// hash_set
+    ///
+    /// slots live in one flat array next to an array of control bytes, one per slot. a lookup
+    /// hashes once, the high bits pick where probing starts and the low 7 bits (h2) are compared
+    /// against a whole group of control bytes at a time, only the slots whose h2 matched have
+    /// their key compared. a group with an empty slot ends the probe. the table grows at 7/8
+    /// full, erased slots become tombstones that the next rehash drops
+    ///
+    /// the first `width` control bytes are mirrored after the last one, so a group can be read
+    /// starting at any slot without wrapping
+    ///
+    template <typename Slot, typename Key, typename KeyOf, typename Hash, typename Eq>
+    class swiss_table {
+      public:
+        using key_type        = Key;
+        using value_type      = Slot;
+        using size_type       = size_t;
+        using difference_type = ::std::ptrdiff_t;
+        using hasher          = Hash;
+        using key_equal       = Eq;
+        using reference       = value_type &;
+        using const_reference = const value_type &;
+
+        template <bool Const>
+        class basic_iterator {
+          public:
+            using iterator_category = ::std::forward_iterator_tag;
+            using value_type        = Slot;
+            using difference_type   = ::std::ptrdiff_t;
+            using pointer           = ::std::conditional_t<Const, const Slot *, Slot *>;
+            using reference         = ::std::conditional_t<Const, const Slot &, Slot &>;
+
+            basic_iterator() = default;
+            basic_iterator(const swiss_table *table, size_t index)
+                : table(table)
+                , index(index) {}
+
+            template <bool Other>
+                requires(Const && !Other)
+            basic_iterator(const basic_iterator<Other> &other)  // NOLINT: to a const_iterator
+                : table(other.table)
+                , index(other.index) {}
+
+            reference operator*() const { return table->slots[index]; }
+            pointer   operator->() const { return table->slots + index; }
+
+            basic_iterator &operator++() {
+                index = table->next_full(index + 1);
+                return *this;
+            }
+
+            basic_iterator operator++(int) {
+                basic_iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const basic_iterator &other) const { return index == other.index; }
+
+          private:
+            friend class swiss_table;
+            template <bool>
+            friend class basic_iterator;
+
+            const swiss_table *table = nullptr;
+            size_t             index = 0;
+        };
+
+        using iterator       = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        swiss_table() = default;
+
+        swiss_table(const swiss_table &other)
+            : hash_fn(other.hash_fn)
+            , eq_fn(other.eq_fn) {
+            reserve(other.size());
+
+            for (const auto &slot : other) {
+                const size_t hash = hash_of(KeyOf()(slot));
+                construct_at(find_free(hash), hash, slot);
+            }
+        }
+
+        swiss_table(swiss_table &&other) noexcept
+            : ctrl(::std::exchange(other.ctrl, nullptr))
+            , slots(::std::exchange(other.slots, nullptr))
+            , cap(::std::exchange(other.cap, 0))
+            , used(::std::exchange(other.used, 0))
+            , growth_left(::std::exchange(other.growth_left, 0))
+            , hash_fn(::std::move(other.hash_fn))
+            , eq_fn(::std::move(other.eq_fn)) {}
+
+        swiss_table &operator=(swiss_table other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~swiss_table() { release(); }
+
+        iterator       begin() { return {this, next_full(0)}; }
+        iterator       end() { return {this, cap}; }
+        const_iterator begin() const { return {this, next_full(0)}; }
+        const_iterator end() const { return {this, cap}; }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        [[nodiscard]] size_t size() const { return used; }
+        [[nodiscard]] bool   empty() const { return used == 0; }
+        [[nodiscard]] size_t capacity() const { return cap; }
+
+        void clear() {
+            destroy_slots();
+
+            if (cap != 0) {
+                ::std::memset(ctrl, ctrl_empty, cap + group::width);
+            }
+
+            used        = 0;
+            growth_left = max_load(cap);
+        }
+
+        /// make room for `n` elements, no rehash happens until there are more
+        void reserve(size_t n) {
+            if (n > used + growth_left) {
+                rehash(capacity_for(n));
+            }
+        }
+
+        iterator       find(const Key &key) { return {this, find_index(key)}; }
+        const_iterator find(const Key &key) const { return {this, find_index(key)}; }
+
+        [[nodiscard]] bool   contains(const Key &key) const { return find_index(key) != cap; }
+        [[nodiscard]] size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+        size_t erase(const Key &key) {
+            const size_t index = find_index(key);
+
+            if (index == cap) {
+                return 0;
+            }
+
+            erase_at(index);
+            return 1;
+        }
+
+        iterator erase(const_iterator pos) {
+            erase_at(pos.index);
+            return {this, next_full(pos.index + 1)};
+        }
+
+        void swap(swiss_table &other) noexcept {
+            ::std::swap(ctrl, other.ctrl);
+            ::std::swap(slots, other.slots);
+            ::std::swap(cap, other.cap);
+            ::std::swap(used, other.used);
+            ::std::swap(growth_left, other.growth_left);
+            ::std::swap(hash_fn, other.hash_fn);
+            ::std::swap(eq_fn, other.eq_fn);
+        }
+
+        hasher    hash_function() const { return hash_fn; }
+        key_equal key_eq() const { return eq_fn; }
+
+      protected:
+        /// the slot holding `key`, or a new one built from `args` if there is none. `args` are
+        /// only used when the key is missing, `key` may refer into them
+        template <typename... Args>
+        ::std::pair<iterator, bool> emplace_key(const Key &key, Args &&...args) {
+            const size_t hash  = hash_of(key);
+            const size_t found = find_index(key, hash);
+
+            if (found != cap) {
+                return {iterator(this, found), false};
+            }
+
+            if (growth_left == 0) {
+                // tombstones use up growth too, if they are most of it a same size rehash will do
+                rehash(used * 2 < max_load(cap) ? cap : capacity_for(used + 1));
+            }
+
+            const size_t index = find_free(hash);
+            construct_at(index, hash, ::std::forward<Args>(args)...);
+
+            return {iterator(this, index), true};
+        }
+
+      private:
+        i8    *ctrl        = nullptr;
+        Slot  *slots       = nullptr;
+        size_t cap         = 0;  ///< a power of two, at least group::width, or 0
+        size_t used        = 0;
+        size_t growth_left = 0;  ///< empty slots that can still be filled before the next rehash
+
+        [[no_unique_address]] Hash hash_fn;
+        [[no_unique_address]] Eq   eq_fn;
+
+        static size_t h1(size_t hash) { return hash >> 7; }
+        static i8     h2(size_t hash) { return static_cast<i8>(hash & 0x7f); }
+
+        static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+        static size_t capacity_for(size_t n) {
+            size_t capacity = group::width;
+
+            while (max_load(capacity) < n) {
+                capacity *= 2;
+            }
+
+            return capacity;
+        }
+
+        size_t hash_of(const Key &key) const { return mix_hash(hash_fn(key)); }
+
+        size_t next_full(size_t index) const {
+            while (index < cap && ctrl[index] < 0) {
+                ++index;
+            }
+
+            return index;
+        }
+
+        size_t find_index(const Key &key) const {
+            return used == 0 ? cap : find_index(key, hash_of(key));
+        }
+
+        size_t find_index(const Key &key, size_t hash) const {
+            if (cap == 0) {
+                return cap;
+            }
+
+            const size_t mask   = cap - 1;
+            size_t       offset = h1(hash) & mask;
+
+            // triangular probing over groups, visits every group once for a power of two
+            for (size_t step = group::width;; step += group::width) {
+                const group probe(ctrl + offset);
+
+                for (auto match = probe.match(h2(hash)); match; match.drop_lowest()) {
+                    const size_t index = (offset + match.lowest()) & mask;
+
+                    if (eq_fn(KeyOf()(slots[index]), key)) {
+                        return index;
+                    }
+                }
+
+                if (probe.match_empty()) {
+                    return cap;
+                }
+
+                offset = (offset + step) & mask;
+            }
+        }
+
+        /// the first empty or deleted slot on the probe sequence of `hash`, the table has one
+        size_t find_free(size_t hash) const {
+            const size_t mask   = cap - 1;
+            size_t       offset = h1(hash) & mask;
+
+            for (size_t step = group::width;; step += group::width) {
+                if (const auto free = group(ctrl + offset).match_free()) {
+                    return (offset + free.lowest()) & mask;
+                }
+
+                offset = (offset + step) & mask;
+            }
+        }
+
+        void set_ctrl(size_t index, i8 value) {
+            ctrl[index] = value;
+
+            if (index < group::width) {
+                ctrl[cap + index] = value;  // the mirrored copy
+            }
+        }
+
+        template <typename... Args>
+        void construct_at(size_t index, size_t hash, Args &&...args) {
+            ::new (static_cast<void *>(slots + index)) Slot(::std::forward<Args>(args)...);
+
+            growth_left -= ctrl[index] == ctrl_empty ? 1 : 0;  // a reused tombstone was counted
+            set_ctrl(index, h2(hash));
+            ++used;
+        }
+
+        void erase_at(size_t index) {
+            slots[index].~Slot();
+            set_ctrl(index, ctrl_deleted);
+            --used;
+        }
+
+        void rehash(size_t capacity) {
+            i8          *old_ctrl  = ctrl;
+            Slot        *old_slots = slots;
+            const size_t old_cap   = cap;
+
+            ctrl  = new i8[capacity + group::width];
+            slots = ::std::allocator<Slot>().allocate(capacity);
+            cap   = capacity;
+            used  = 0;
+
+            ::std::memset(ctrl, ctrl_empty, capacity + group::width);
+            growth_left = max_load(capacity);
+
+            for (size_t i = 0; i < old_cap; ++i) {
+                if (old_ctrl[i] >= 0) {
+                    const size_t hash = hash_of(KeyOf()(old_slots[i]));
+
+                    construct_at(find_free(hash), hash, ::std::move(old_slots[i]));
+                    old_slots[i].~Slot();
+                }
+            }
+
+            if (old_cap != 0) {
+                delete[] old_ctrl;
+                ::std::allocator<Slot>().deallocate(old_slots, old_cap);
+            }
+        }
+
+        void destroy_slots() {
+            if constexpr (!::std::is_trivially_destructible_v<Slot>) {
+                for (size_t i = 0; i < cap; ++i) {
+                    if (ctrl[i] >= 0) {
+                        slots[i].~Slot();
+                    }
+                }
+            }
+        }
+
+        void release() {
+            if (cap == 0) {
+                return;
+            }
+
+            destroy_slots();
+            delete[] ctrl;
+            ::std::allocator<Slot>().deallocate(slots, cap);
+        }
+    };
+
+    /// \include belongs to the helix standard library.
+    /// \brief the type a literal element is stored as, string literals become strings
+    ///
+    template <typename T>
+    using literal_t = ::std::conditional_t<::std::is_same_v<::std::decay_t<T>, const char *> ||
+                                               ::std::is_same_v<::std::decay_t<T>, char *>,
+                                           ::string,
+                                           ::std::decay_t<T>>;
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief unordered map, the `map` of helix. see __internal_interfaces::swiss_table
+///
+/// iteration order is unspecified, `ordered_map` is the sorted tree. inserting may move the
+/// elements, iterators and references do not survive an insert
+///
+template <typename K,
+          typename V,
+          typename Hash = ::std::hash<K>,
+          typename Eq   = ::std::equal_to<K>>
+class hash_map
+    : public __internal_interfaces::
+          swiss_table<::std::pair<const K, V>, K, __internal_interfaces::map_key, Hash, Eq> {
+    using base = __internal_interfaces::
+        swiss_table<::std::pair<const K, V>, K, __internal_interfaces::map_key, Hash, Eq>;
+
+  public:
+    using mapped_type = V;
+    using typename base::iterator;
+    using typename base::value_type;
+
+    hash_map() = default;
+
+    hash_map(::std::initializer_list<value_type> init) {
+        this->reserve(init.size());
+
+        for (const auto &entry : init) {
+            insert(entry);
+        }
+    }
+
+    /// a map literal with other key or value types, `let m: map::<i64, f64> = {1: 2}`
+    template <typename K2, typename V2>
+        requires(!::std::is_same_v<hash_map<K2, V2>, hash_map> &&
+                 ::std::is_constructible_v<K, const K2 &> && ::std::is_constructible_v<V, V2 &&>)
+    hash_map(hash_map<K2, V2> &&other) {  // NOLINT: converts implicitly like the literal would
+        this->reserve(other.size());
+
+        for (auto &entry : other) {
+            try_emplace(K(entry.first), V(::std::move(entry.second)));
+        }
+    }
+
+    template <typename... Args>
+    ::std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+        return this->emplace_key(key,
+                                 ::std::piecewise_construct,
+                                 ::std::forward_as_tuple(key),
+                                 ::std::forward_as_tuple(::std::forward<Args>(args)...));
+    }
+
+)",
+        R"(    template <typename... Args>
+    ::std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+        return this->emplace_key(key,
+                                 ::std::piecewise_construct,
+                                 ::std::forward_as_tuple(::std::move(key)),
+                                 ::std::forward_as_tuple(::std::forward<Args>(args)...));
+    }
+
+    ::std::pair<iterator, bool> insert(const value_type &entry) {
+        return this->emplace_key(entry.first, entry);
+    }
+
+    ::std::pair<iterator, bool> insert(value_type &&entry) {
+        return this->emplace_key(entry.first, ::std::move(entry));
+    }
+
+    template <typename... Args>
+    ::std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type entry(::std::forward<Args>(args)...);
+        return insert(::std::move(entry));
+    }
+
+    template <typename M>
+    ::std::pair<iterator, bool> insert_or_assign(K key, M &&value) {
+        auto result = try_emplace(::std::move(key), ::std::forward<M>(value));
+
+        if (!result.second) {
+            result.first->second = ::std::forward<M>(value);
+        }
+
+        return result;
+    }
+
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+    V &operator[](K &&key) { return try_emplace(::std::move(key)).first->second; }
+
+    V &at(const K &key) {
+        const auto found = this->find(key);
+
+        if (found == this->end()) {
+            throw ::std::out_of_range("key not found in map");
+        }
+
+        return found->second;
+    }
+
+    const V &at(const K &key) const {
+        const auto found = this->find(key);
+
+        if (found == this->end()) {
+            throw ::std::out_of_range("key not found in map");
+        }
+
+        return found->second;
+    }
+};
+
+/// \include belongs to the helix standard library.
+/// \brief unordered set, the `set` of helix. see __internal_interfaces::swiss_table
+///
+/// iteration order is unspecified, `ordered_set` is the sorted tree
+///
+template <typename T, typename Hash = ::std::hash<T>, typename Eq = ::std::equal_to<T>>
+class hash_set
+    : public __internal_interfaces::swiss_table<T, T, __internal_interfaces::set_key, Hash, Eq> {
+    using base = __internal_interfaces::swiss_table<T, T, __internal_interfaces::set_key, Hash, Eq>;
+
+  public:
+    using iterator = typename base::const_iterator;  // elements are keys, never written through
+    using typename base::const_iterator;
+    using typename base::value_type;
+
+    hash_set() = default;
+
+    hash_set(::std::initializer_list<T> init) {
+        this->reserve(init.size());
+
+        for (const auto &value : init) {
+            insert(value);
+        }
+    }
+
+    /// a set literal with another element type, `let s: set::<i64> = {1, 2}`
+    template <typename U>
+        requires(!::std::is_same_v<U, T> && ::std::is_constructible_v<T, const U &>)
+    hash_set(hash_set<U> &&other) {  // NOLINT: converts implicitly like the literal would
+        this->reserve(other.size());
+
+        for (const auto &value : other) {
+            insert(T(value));
+        }
+    }
+
+    const_iterator begin() const { return base::begin(); }
+    const_iterator end() const { return base::end(); }
+
+    const_iterator find(const T &value) const { return base::find(value); }
+
+    ::std::pair<iterator, bool> insert(const T &value) {
+        const auto [at, inserted] = this->emplace_key(value, value);
+        return {at, inserted};
+    }
+
+    ::std::pair<iterator, bool> insert(T &&value) {
+        const auto [at, inserted] = this->emplace_key(value, ::std::move(value));
+        return {at, inserted};
+    }
+
+    template <typename... Args>
+    ::std::pair<iterator, bool> emplace(Args &&...args) {
+        return insert(T(::std::forward<Args>(args)...));
+    }
+};
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief `::std::hash<K>` is enabled, what the default Hash of the hash tables needs
+    ///
+    template <typename K>
+    concept std_hashable = requires(const K &key) {
+        { ::std::hash<K>{}(key) } -> ::std::convertible_to<size_t>;
+    };
+
+    template <typename K, typename V, typename... Rest>
+    struct map_for {
+        using type = hash_map<K, V, Rest...>;
+    };
+
+    template <typename K, typename V>
+        requires(!std_hashable<K>)
+    struct map_for<K, V> {
+        using type = ::std::map<K, V>;
+    };
+
+    template <typename T, typename... Rest>
+    struct set_for {
+        using type = hash_set<T, Rest...>;
+    };
+
+    template <typename T>
+        requires(!std_hashable<T>)
+    struct set_for<T> {
+        using type = ::std::set<T>;
+    };
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief the `map` of helix, hash_map when the key has a `::std::hash` and the tree otherwise,
+/// a tuple key only needs `<`
+///
+template <typename... Args>
+using map_type = typename __internal_interfaces::map_for<Args...>::type;
+
+/// \include belongs to the helix standard library.
+/// \brief the `set` of helix, hash_set or the tree, see map_type
+///
+template <typename... Args>
+using set_type = typename __internal_interfaces::set_for<Args...>::type;
+
+/// \include belongs to the helix standard library.
+/// \brief one `key: value` of a map literal
+///
+template <typename K, typename V>
+::std::pair<__internal_interfaces::literal_t<K>, __internal_interfaces::literal_t<V>>
+map_entry(K &&key, V &&value) {
+    return {::std::forward<K>(key), ::std::forward<V>(value)};
+}
+
+/// \include belongs to the helix standard library.
+/// \brief build a map literal, a hash table reserves the capacity for every entry before the
+/// first insert
+///
+/// {"a": 1, "b": 2} -> map_literal(map_entry("a", 1), map_entry("b", 2))
+///
+/// a key given twice keeps the last value
+///
+template <typename... K, typename... V>
+map_type<::std::common_type_t<K...>, ::std::common_type_t<V...>>
+map_literal(::std::pair<K, V> &&...entries) {
+    map_type<::std::common_type_t<K...>, ::std::common_type_t<V...>> out;
+
+    if constexpr (requires { out.reserve(sizeof...(entries)); }) {
+        out.reserve(sizeof...(entries));
+    }
+
+    (out.insert_or_assign(::std::move(entries.first), ::std::move(entries.second)), ...);
+    return out;
+}
+
+/// \include belongs to the helix standard library.
+/// \brief build a set literal, a hash table reserves the capacity for every element before
+/// the first insert
+///
+/// {1, 2, 3} -> set_literal(1, 2, 3)
+///
+template <typename... T>
+set_type<::std::common_type_t<__internal_interfaces::literal_t<T>...>>
+set_literal(T &&...values) {
+    set_type<::std::common_type_t<__internal_interfaces::literal_t<T>...>> out;
+
+    if constexpr (requires { out.reserve(sizeof...(values)); }) {
+        out.reserve(sizeof...(values));
+    }
+
+    (out.insert(__internal_interfaces::literal_t<T>(::std::forward<T>(values))), ...);
+    return out;
+}
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief elements a small_vector keeps inline by default, 8 but never more than 256 bytes
+    ///
+    template <typename T>
+    inline constexpr size_t small_inline_elements =
+        sizeof(T) * 8 <= 256 ? 8 : (sizeof(T) > 256 ? 1 : 256 / sizeof(T));
+
+    /// \include belongs to the helix standard library.
+    /// \brief elements a small_vector made from a literal of `Count` elements keeps inline, the
+    /// next power of two above Count (it is grown, at least one more fits) within the same 256
+    /// bytes as small_inline_elements. an empty literal gets the default
+    ///
+    template <typename T, size_t Count>
+    inline constexpr size_t small_literal_elements =
+        Count == 0 ? small_inline_elements<T>
+                   : ::std::min(::std::bit_ceil(Count + 1),
+                                sizeof(T) > 256 ? size_t{1} : 256 / sizeof(T));
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief a list that keeps up to N elements inside the object, the heap is only used past that
+///
+/// let xs: list::<i32> = [1, 2];  ->  helix::std::small_vector<int> xs = {1, 2};
+///
+/// the emitter picks it (see small_vector_of) for a short list literal bound to a local that
+/// is only indexed, iterated, asked for its size or grown in place (see escape.hh), it can
+/// also be asked for by name: `small_vector::<T, N>`. the interface is the part of std::vector those uses need,
+/// growing past N moves the elements to the heap and they stay there. iterators are pointers
+/// and are invalidated the same way as the ones of a std::vector
+///
+template <typename T, size_t N = __internal_interfaces::small_inline_elements<T>>
+class small_vector {
+    static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+  public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = ::std::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = T *;
+    using const_iterator         = const T *;
+    using reverse_iterator       = ::std::reverse_iterator<iterator>;
+    using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+
+    static constexpr size_t inline_capacity = N;
+
+    small_vector() noexcept = default;
+
+    small_vector(::std::initializer_list<T> values) {
+        construct([&] { insert(end(), values.begin(), values.end()); });
+    }
+
+    explicit small_vector(size_t count, const T &value = T()) {
+        construct([&] { resize(count, value); });
+    }
+
+    template <::std::input_iterator It>
+    small_vector(It first, It last) {
+        construct([&] { insert(end(), first, last); });
+    }
+
+    small_vector(const small_vector &other) {
+        construct([&] { insert(end(), other.begin(), other.end()); });
+    }
+
+    small_vector(small_vector &&other) noexcept(::std::is_nothrow_move_constructible_v<T>) {
+        take(::std::move(other));
+    }
+
+    small_vector &operator=(const small_vector &other) {
+        if (this != &other) {
+            clear();
+            insert(end(), other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    small_vector &operator=(small_vector &&other) noexcept(
+        ::std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            reset();
+            take(::std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~small_vector() { reset(); }
+
+    /// a std::vector with the same elements, for the functions that take a `list`
+    operator ::std::vector<T>() const { return ::std::vector<T>(begin(), end()); }
+
+    [[nodiscard]] size_t size() const noexcept { return count; }
+    [[nodiscard]] bool   empty() const noexcept { return count == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return cap; }
+
+    /// true while the elements are still inside the object
+    [[nodiscard]] bool is_inline() const noexcept { return items == inline_items(); }
+
+    T       *data() noexcept { return items; }
+    const T *data() const noexcept { return items; }
+
+    T       &operator[](size_t index) noexcept { return items[index]; }
+    const T &operator[](size_t index) const noexcept { return items[index]; }
+
+    T &at(size_t index) {
+        check(index);
+        return items[index];
+    }
+
+    const T &at(size_t index) const {
+        check(index);
+        return items[index];
+    }
+
+    T       &front() noexcept { return items[0]; }
+    const T &front() const noexcept { return items[0]; }
+    T       &back() noexcept { return items[count - 1]; }
+    const T &back() const noexcept { return items[count - 1]; }
+
+    iterator       begin() noexcept { return items; }
+    const_iterator begin() const noexcept { return items; }
+    const_iterator cbegin() const noexcept { return items; }
+    iterator       end() noexcept { return items + count; }
+    const_iterator end() const noexcept { return items + count; }
+    const_iterator cend() const noexcept { return items + count; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(::std::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (count == cap) {
+            // the new element is built before the old ones move, `xs.push_back(xs[0])` is fine
+            grow(cap * 2, [&](T *slot) { ::new (slot) T(::std::forward<Args>(args)...); });
+        } else {
+            ::new (items + count) T(::std::forward<Args>(args)...);
+        }
+
+        return items[count++];
+    }
+
+    void pop_back() noexcept { items[--count].~T(); }
+
+    iterator insert(const_iterator position, const T &value) {
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T &&value) {
+        return emplace(position, ::std::move(value));
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator position, Args &&...args) {
+        const size_t index = static_cast<size_t>(position - items);
+
+        emplace_back(::std::forward<Args>(args)...);
+        ::std::rotate(items + index, items + count - 1, items + count);
+
+        return items + index;
+    }
+
+)",
+        R"(    template <::std::input_iterator It>
+    iterator insert(const_iterator position, It first, It last) {
+        const size_t index = static_cast<size_t>(position - items);
+        const size_t old   = count;
+
+        if constexpr (::std::forward_iterator<It>) {
+            const auto added = static_cast<size_t>(::std::distance(first, last));
+
+            if (count + added > cap) {
+                reserve(::std::max(count + added, cap * 2));
+            }
+
+            // a memcpy for trivial types, a failed copy destroys what it made
+            ::std::uninitialized_copy(first, last, items + count);
+            count += added;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        ::std::rotate(items + index, items + old, items + count);
+        return items + index;
+    }
+
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T *const from = items + (first - items);
+        T *const to   = items + (last - items);
+
+        if (from != to) {
+            T *const tail = ::std::move(to, end(), from);
+            ::std::destroy(tail, end());
+            count = static_cast<size_t>(tail - items);
+        }
+
+        return from;
+    }
+
+    void clear() noexcept {
+        ::std::destroy(begin(), end());
+        count = 0;
+    }
+
+    void reserve(size_t wanted) {
+        if (wanted > cap) {
+            grow(wanted, [](T *) {});
+        }
+    }
+
+    void resize(size_t wanted) { resize_with(wanted, [](T *slot) { ::new (slot) T(); }); }
+
+    void resize(size_t wanted, const T &value) {
+        resize_with(wanted, [&](T *slot) { ::new (slot) T(value); });
+    }
+
+    friend bool operator==(const small_vector &lhs, const small_vector &rhs) {
+        return ::std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const small_vector &lhs, const small_vector &rhs)
+        requires ::std::three_way_comparable<T>
+    {
+        return ::std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+  private:
+    T     *items = inline_items();
+    size_t count = 0;
+    size_t cap   = N;
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+
+    T       *inline_items() noexcept { return reinterpret_cast<T *>(storage); }
+    const T *inline_items() const noexcept { return reinterpret_cast<const T *>(storage); }
+
+    /// a throwing constructor never reaches the destructor, undo what `fill` did by hand
+    template <typename Fill>
+    void construct(Fill &&fill) {
+        try {
+            fill();
+        } catch (...) {
+            reset();
+            throw;
+        }
+    }
+
+    void check(size_t index) const {
+        if (index >= count) {
+            throw ::std::out_of_range("small_vector index " + ::std::to_string(index) +
+                                      " is out of range for a size of " +
+                                      ::std::to_string(count));
+        }
+    }
+
+    /// move to a heap block of `wanted` elements, `build` constructs the element at index
+    /// `count` in the new block first (it does nothing for a plain reserve)
+    template <typename Build>
+    void grow(size_t wanted, Build &&build) {
+        T *const block = static_cast<T *>(
+            ::operator new(wanted * sizeof(T), ::std::align_val_t{alignof(T)}));
+
+        try {
+            build(block + count);
+        } catch (...) {
+            ::operator delete(block, ::std::align_val_t{alignof(T)});
+            throw;
+        }
+
+        if constexpr (::std::is_nothrow_move_constructible_v<T> ||
+                      !::std::is_copy_constructible_v<T>) {
+            ::std::uninitialized_move(begin(), end(), block);
+        } else {
+            try {
+                ::std::uninitialized_copy(begin(), end(), block);
+            } catch (...) {
+                ::std::destroy_at(block + count);
+                ::operator delete(block, ::std::align_val_t{alignof(T)});
+                throw;
+            }
+        }
+
+        ::std::destroy(begin(), end());
+        release();
+
+        items = block;
+        cap   = wanted;
+    }
+
+    template <typename Build>
+    void resize_with(size_t wanted, Build &&build) {
+        if (wanted < count) {
+            ::std::destroy(items + wanted, end());
+            count = wanted;
+            return;
+        }
+
+        reserve(wanted);
+
+        while (count < wanted) {
+            build(items + count);
+            ++count;
+        }
+    }
+
+    /// free the heap block, the elements must already be destroyed
+    void release() noexcept {
+        if (!is_inline()) {
+            ::operator delete(items, ::std::align_val_t{alignof(T)});
+        }
+    }
+
+    /// destroy everything and go back to the inline storage
+    void reset() noexcept {
+        clear();
+        release();
+
+        items = inline_items();
+        cap   = N;
+    }
+
+    /// steal the heap block of `other`, or move its inline elements one by one
+    void take(small_vector &&other) {
+        if (other.is_inline()) {
+            ::std::uninitialized_move(other.begin(), other.end(), items);
+            count = other.count;
+            other.clear();
+            return;
+        }
+
+        items = other.items;
+        count = other.count;
+        cap   = other.cap;
+
+        other.items = other.inline_items();
+        other.count = 0;
+        other.cap   = N;
+    }
+};
+
+/// \include belongs to the helix standard library.
+/// \brief the small_vector a list literal of `Count` elements lowers to, see escape.hh
+///
+/// let xs: list::<i32> = [1, 2];  ->  helix::std::small_vector_of<int, 2> xs = {1, 2};
+///
+template <typename T, size_t Count>
+using small_vector_of = small_vector<T, __internal_interfaces::small_literal_elements<T, Count>>;
+
+/// \include belongs to the helix standard library.
+/// \brief a string that keeps up to N characters inside the object
+///
+/// libstdc++ keeps 15 characters inline and libc++ 22, the 63 of the default hold most names,
+/// keys and lines without touching the heap. asked for by name (`small_string`), it converts to
+/// a string_view so it prints, compares and hashes like a `string`, `str()` makes a `string`
+///
+template <size_t N = 63>
+class small_string {
+  public:
+    using value_type     = char;
+    using size_type      = size_t;
+    using iterator       = char *;
+    using const_iterator = const char *;
+
+    small_string() { chars.push_back('\0'); }
+    small_string(const char *text)
+        : small_string(::std::string_view(text)) {}
+    small_string(const ::string &text)
+        : small_string(::std::string_view(text)) {}
+
+    small_string(::std::string_view text) {
+        chars.reserve(text.size() + 1);
+        chars.insert(chars.end(), text.begin(), text.end());
+        chars.push_back('\0');
+    }
+
+    operator ::std::string_view() const noexcept { return {chars.data(), size()}; }
+
+    [[nodiscard]] ::string str() const { return ::string(chars.data(), size()); }
+
+    [[nodiscard]] size_t size() const noexcept { return chars.size() - 1; }
+    [[nodiscard]] size_t length() const noexcept { return size(); }
+    [[nodiscard]] bool   empty() const noexcept { return size() == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return chars.capacity() - 1; }
+    [[nodiscard]] bool   is_inline() const noexcept { return chars.is_inline(); }
+
+    char       *data() noexcept { return chars.data(); }
+    const char *data() const noexcept { return chars.data(); }
+    const char *c_str() const noexcept { return chars.data(); }
+
+    char       &operator[](size_t index) noexcept { return chars[index]; }
+    const char &operator[](size_t index) const noexcept { return chars[index]; }
+
+    char       &front() noexcept { return chars[0]; }
+    const char &front() const noexcept { return chars[0]; }
+    char       &back() noexcept { return chars[size() - 1]; }
+    const char &back() const noexcept { return chars[size() - 1]; }
+
+    iterator       begin() noexcept { return chars.begin(); }
+    const_iterator begin() const noexcept { return chars.begin(); }
+    iterator       end() noexcept { return chars.begin() + size(); }
+    const_iterator end() const noexcept { return chars.begin() + size(); }
+
+    void reserve(size_t wanted) { chars.reserve(wanted + 1); }
+
+    void clear() noexcept {
+        chars.clear();
+        chars.push_back('\0');
+    }
+
+    void push_back(char c) {
+        chars.back() = c;
+        chars.push_back('\0');
+    }
+
+    void pop_back() noexcept {
+        chars.pop_back();
+        chars.back() = '\0';
+    }
+
+    small_string &append(::std::string_view text) {
+        const char *const first = chars.data();
+
+        // `s += s`: grow first and read the characters from where the growing moved them, the
+        // old block is freed by the time insert copies
+        if (::std::less_equal<>()(first, text.data()) &&
+            ::std::less<>()(text.data(), first + size()) && size() + text.size() >= capacity()) {
+            const auto offset = static_cast<size_t>(text.data() - first);
+
+            chars.reserve(::std::max(chars.size() + text.size(), chars.capacity() * 2));
+            text = {chars.data() + offset, text.size()};
+        }
+
+        chars.pop_back();
+        chars.insert(chars.end(), text.begin(), text.end());
+        chars.push_back('\0');
+
+        return *this;
+    }
+
+    small_string &operator+=(::std::string_view text) { return append(text); }
+
+    small_string &operator+=(char c) {
+        push_back(c);
+        return *this;
+    }
+
+    friend small_string operator+(small_string lhs, ::std::string_view rhs) {
+        lhs.append(rhs);
+        return lhs;
+    }
+
+    friend bool operator==(const small_string &lhs, ::std::string_view rhs) noexcept {
+        return ::std::string_view(lhs) == rhs;
+    }
+
+    friend auto operator<=>(const small_string &lhs, ::std::string_view rhs) noexcept {
+        return ::std::string_view(lhs) <=> rhs;
+    }
+
+    friend ::std::ostream &operator<<(::std::ostream &out, const small_string &text) {
+        return out << ::std::string_view(text);
+    }
+
+  private:
+    small_vector<char, N + 1> chars;  ///< the characters and a '\0'
+};
+}  // namespace std
+
+/// \include belongs to the helix standard library.
+/// \brief the lazy sequence a function with `yield` in its body returns
+///
+/// fn fib() { let a = 0; ... yield a; }  ->  helix::generator<int> fib() { ... co_yield a; }
+///
+/// nothing runs until the first element is asked for, each `yield` suspends the body until the
+/// next one is. the sequence ends when the body falls off its end or runs a bare `return`
+/// (`co_return`), returning a value is an error. the yielded value is not copied, the promise
+/// keeps a pointer to it (a temporary lives until the body is resumed). the handle never
+/// escapes the generator object, so when the generator lives and dies in one function clang
+/// can elide the frame allocation (halo) and inline the body into the loop. gcc does neither,
+/// every element is an indirect call into the frame and a sequence costs several times a hand
+/// written iterator, see benchmarks/generator.cc
+///
+/// an exception thrown by the body propagates out of whatever resumed it
+///
+template <typename T>
+class [[nodiscard]] generator {
+  public:
+    using value_type = T;
+
+    class promise_type {
+      public:
+        generator get_return_object() noexcept {
+            return generator(::std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        ::std::suspend_always initial_suspend() const noexcept { return {}; }
+        ::std::suspend_always final_suspend() const noexcept { return {}; }
+
+        ::std::suspend_always yield_value(const T &value) noexcept {
+            current = ::std::addressof(value);
+            return {};
+        }
+
+        /// `yield 0` in a generator of i64, the converted value lives in the awaiter which
+        /// stays in the coroutine frame while it is suspended
+        template <typename U>
+            requires(!::std::is_same_v<::std::remove_cvref_t<U>, T> &&
+                     ::std::is_convertible_v<U, T>)
+        auto yield_value(U &&value) noexcept(::std::is_nothrow_convertible_v<U, T>) {
+            struct converted {
+                T value;
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(::std::coroutine_handle<promise_type> coro) noexcept {
+                    coro.promise().current = ::std::addressof(value);
+                }
+                void await_resume() const noexcept {}
+            };
+
+            return converted{static_cast<T>(::std::forward<U>(value))};
+        }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() const { throw; }
+
+        /// a generator has no executor to wait on
+        template <typename U>
+        void await_transform(U &&) = delete;
+
+      private:
+        friend class generator;
+
+        const T *current = nullptr;
+    };
+
+    class iterator {
+      public:
+        using iterator_category = ::std::input_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ::std::ptrdiff_t;
+        using pointer           = const T *;
+        using reference         = const T &;
+
+        iterator() = default;
+        explicit iterator(::std::coroutine_handle<promise_type> coro) noexcept
+            : coro(coro) {}
+
+        reference operator*() const noexcept { return *coro.promise().current; }
+        pointer   operator->() const noexcept { return coro.promise().current; }
+
+        iterator &operator++() {
+            coro.resume();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator &it, ::std::default_sentinel_t) noexcept {
+            return it.coro.done();
+        }
+
+      private:
+        ::std::coroutine_handle<promise_type> coro;
+    };
+
+    generator(const generator &)            = delete;
+    generator &operator=(const generator &) = delete;
+
+    generator(generator &&other) noexcept
+        : coro(::std::exchange(other.coro, {})) {}
+
+    generator &operator=(generator &&other) noexcept {
+        if (this != &other) {
+            if (coro) {
+                coro.destroy();
+            }
+
+            coro = ::std::exchange(other.coro, {});
+        }
+
+        return *this;
+    }
+
+    ~generator() {
+        if (coro) {
+            coro.destroy();
+        }
+    }
+
+    /// runs the body up to the next `yield`, an element taken by `next` is not seen again
+    iterator begin() {
+        advance();
+        return iterator(coro);
+    }
+
+    ::std::default_sentinel_t end() const noexcept { return {}; }
+
+)",
+        R"(    /// the next element, throws std::out_of_range once the body has returned
+    T next() {
+        advance();
+
+        if (coro.done()) {
+            throw ::std::out_of_range("generator is exhausted");
+        }
+
+        return *coro.promise().current;
+    }
+
+  private:
+    ::std::coroutine_handle<promise_type> coro;
+
+    explicit generator(::std::coroutine_handle<promise_type> coro) noexcept
+        : coro(coro) {}
+
+    void advance() {
+        if (!coro.done()) {
+            coro.resume();
+        }
+    }
+};
+
+namespace std {
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief the work-stealing pool `thread` tasks and async functions run on
+    ///
+    /// one worker per hardware thread, each with a deque of its own. a worker takes from the back
+    /// of its own deque (the newest task, its data is still in cache) and steals from the front
+    /// of the others once it runs dry, threads outside the pool hand tasks out round robin. a
+    /// task is a suspended coroutine, queuing one copies a pointer. idle workers sleep until a
+    /// task is posted
+    ///
+    class task_pool {
+      public:
+        task_pool(const task_pool &)            = delete;
+        task_pool(task_pool &&)                 = delete;
+        task_pool &operator=(const task_pool &) = delete;
+        task_pool &operator=(task_pool &&)      = delete;
+
+        /// the pool of this program, started on first use
+        static task_pool &global() {
+            static task_pool pool;
+            return pool;
+        }
+
+        ~task_pool() {
+            {
+                ::std::lock_guard<::std::mutex> guard(sleep_lock);
+                stopping = true;
+            }
+
+            wake.notify_all();
+
+            for (auto &worker : workers) {
+                if (worker.get_id() == ::std::this_thread::get_id()) {
+                    worker.detach();  // exit() called from a task
+                } else {
+                    worker.join();
+                }
+            }
+        }
+
+        void post(::std::coroutine_handle<> task) {
+            const size_t self  = current_worker();
+            const size_t index = self != npos ? self : next.fetch_add(1) % queues.size();
+
+            {
+                ::std::lock_guard<::std::mutex> guard(queues[index]->lock);
+                queues[index]->tasks.push_back(task);
+            }
+
+            pending.fetch_add(1);
+
+            if (sleeping.load() > 0) {
+                { ::std::lock_guard<::std::mutex> guard(sleep_lock); }  // a worker is in wait()
+                wake.notify_one();
+            }
+        }
+
+        /// run one queued task on the calling thread, false if there was none
+        bool run_one() {
+            const size_t self = current_worker();
+            const auto   task = take(self == npos ? 0 : self, self != npos);
+
+            if (!task) {
+                return false;
+            }
+
+            task.resume();
+            return true;
+        }
+
+        /// true on the threads of the pool
+        static bool on_worker() { return current_worker() != npos; }
+
+        [[nodiscard]] size_t size() const { return workers.size(); }
+
+        /// set in a `spawn` worker process, it has no pool threads and runs every task in place
+        static bool &runs_inline() {
+            static bool value = false;
+            return value;
+        }
+
+      private:
+        struct alignas(64) queue {  // one cache line each, workers do not contend on the locks
+            ::std::mutex                            lock;
+            ::std::deque<::std::coroutine_handle<>> tasks;
+        };
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        ::std::vector<::std::unique_ptr<queue>> queues;
+        ::std::vector<::std::thread>            workers;
+        ::std::atomic<size_t>                   pending{0};   ///< tasks in all the queues
+        ::std::atomic<size_t>                   sleeping{0};  ///< workers waiting on `wake`
+        ::std::atomic<size_t>                   next{0};      ///< round robin for outside posts
+        ::std::mutex                            sleep_lock;
+        ::std::condition_variable               wake;
+        bool                                    stopping = false;
+
+        task_pool() {
+            const size_t count = ::std::max(1U, ::std::thread::hardware_concurrency());
+
+            for (size_t i = 0; i < count; ++i) {
+                queues.push_back(::std::make_unique<queue>());
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                workers.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        struct worker_slot {
+            static constexpr size_t initial = npos;
+        };
+
+        static size_t &current_worker() { return thread_slot<size_t, worker_slot>(); }
+
+        /// the back of `self`'s own deque if `own`, otherwise the front of the first non empty one
+        ::std::coroutine_handle<> take(size_t self, bool own) {
+            if (pending.load() == 0) {
+                return {};
+            }
+
+            for (size_t i = 0; i < queues.size(); ++i) {
+                queue                          &from = *queues[(self + i) % queues.size()];
+                ::std::lock_guard<::std::mutex> guard(from.lock);
+
+                if (from.tasks.empty()) {
+                    continue;
+                }
+
+                ::std::coroutine_handle<> task;
+
+                if (i == 0 && own) {
+                    task = from.tasks.back();
+                    from.tasks.pop_back();
+                } else {
+                    task = from.tasks.front();
+                    from.tasks.pop_front();
+                }
+
+                pending.fetch_sub(1);
+                return task;
+            }
+
+            return {};
+        }
+
+        void work(size_t index) {
+            current_worker() = index;
+
+            while (true) {
+                if (const auto task = take(index, true)) {
+                    task.resume();
+                    continue;
+                }
+
+                ::std::unique_lock<::std::mutex> lock(sleep_lock);
+
+                sleeping.fetch_add(1);
+                wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+                sleeping.fetch_sub(1);
+
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+    };
+
+    /// \include belongs to the helix standard library.
+    /// \brief suspend the coroutine and queue it on the pool, it continues on a worker
+    ///
+    struct pool_schedule {
+        bool await_ready() const noexcept { return task_pool::runs_inline(); }
+        void await_suspend(::std::coroutine_handle<> coro) const {
+            flush_output();  // what the caller printed comes before what the task prints
+            task_pool::global().post(coro);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /// \include belongs to the helix standard library.
+    /// \brief where a future keeps its value, `co_return value` for T, `co_return` for void
+    ///
+    template <typename T>
+    class future_result {
+      public:
+        template <typename U>
+        void return_value(U &&result) {
+            value.emplace(::std::forward<U>(result));
+        }
+
+        T take() { return ::std::move(*value); }
+
+      private:
+        ::std::optional<T> value;
+    };
+
+    template <>
+    class future_result<void> {
+      public:
+        void return_void() const noexcept {}
+        void take() const noexcept {}
+    };
+}  // namespace __internal_interfaces
+}  // namespace std
+
+/// \include belongs to the helix standard library.
+/// \brief the result of a `thread` task or an async function, `await` gives the value
+///
+/// async fn f(a: i8) -> i8 { ... }  ->  helix::future<i8> f(i8 a) { ... co_return a; }
+/// let b = thread g(5);             ->  auto b = helix::std::run_async([=]() mutable { ... });
+///
+/// the body starts on the pool right away. `await` in an async function suspends it until the
+/// value is there and it continues on the thread that produced the value, anywhere else it
+/// blocks (a pool worker runs other tasks while it waits). an exception thrown by the body is
+/// rethrown by `await`
+///
+/// the coroutine frame is shared by the future and the running body, whichever lets go last
+/// frees it, so a future can be dropped without waiting for it
+///
+template <typename T>
+class [[nodiscard]] future {
+  public:
+    using value_type = T;
+
+    class promise_type : public std::__internal_interfaces::future_result<T> {
+      public:
+        future get_return_object() noexcept {
+            return future(::std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::__internal_interfaces::pool_schedule initial_suspend() const noexcept { return {}; }
+
+        auto final_suspend() noexcept {
+            struct publish {
+                bool await_ready() const noexcept { return false; }
+
+                ::std::coroutine_handle<>
+                await_suspend(::std::coroutine_handle<promise_type> coro) const noexcept {
+                    promise_type             &promise = coro.promise();
+                    ::std::coroutine_handle<> next    = ::std::noop_coroutine();
+
+                    std::flush_output();  // seen before anything that waited for the value
+
+                    if (promise.state.exchange(done) == waiting) {
+                        next = promise.continuation;  // symmetric transfer, no stack growth
+                    } else {
+                        promise.state.notify_all();  // a thread blocked in get()
+                    }
+
+                    promise.release(coro);
+                    return next;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            return publish{};
+        }
+
+        void unhandled_exception() noexcept { error = ::std::current_exception(); }
+
+      private:
+        friend class future;
+
+        enum : u8 { running, waiting, done };
+
+        ::std::atomic<u8>         state{running};
+        ::std::atomic<u8>         refs{2};  ///< the future and the body
+        ::std::coroutine_handle<> continuation;
+        ::std::exception_ptr      error;
+
+        void release(::std::coroutine_handle<promise_type> coro) {
+            if (refs.fetch_sub(1) == 1) {
+                coro.destroy();
+            }
+        }
+    };
+
+    future(const future &)            = delete;
+    future &operator=(const future &) = delete;
+
+    future(future &&other) noexcept
+        : coro(::std::exchange(other.coro, {})) {}
+
+    future &operator=(future &&other) noexcept {
+        if (this != &other) {
+            drop();
+            coro = ::std::exchange(other.coro, {});
+        }
+
+        return *this;
+    }
+
+    ~future() { drop(); }
+
+    [[nodiscard]] bool ready() const { return coro.promise().state.load() == promise_type::done; }
+
+    bool await_ready() const noexcept { return ready(); }
+
+    bool await_suspend(::std::coroutine_handle<> awaiting) noexcept {
+        std::flush_output();  // the awaiting coroutine may continue on another thread
+
+        auto &promise        = coro.promise();
+        promise.continuation = awaiting;
+
+        u8 expected = promise_type::running;
+        return promise.state.compare_exchange_strong(expected, promise_type::waiting);
+    }
+
+    T await_resume() { return take(); }
+
+    /// block until the value is there, a pool worker runs other tasks in the meantime
+    T get() {
+        auto &promise = coro.promise();
+
+        if (std::__internal_interfaces::task_pool::on_worker()) {
+            while (!ready()) {
+                if (!std::__internal_interfaces::task_pool::global().run_one()) {
+                    ::std::this_thread::yield();
+                }
+            }
+        } else {
+            for (u8 state = promise.state.load(); state != promise_type::done;
+                 state    = promise.state.load()) {
+                promise.state.wait(state);
+            }
+        }
+
+        return take();
+    }
+
+  private:
+    ::std::coroutine_handle<promise_type> coro;
+
+    explicit future(::std::coroutine_handle<promise_type> coro) noexcept
+        : coro(coro) {}
+
+    T take() {
+        if (coro.promise().error) {
+            ::std::rethrow_exception(coro.promise().error);
+        }
+
+        return coro.promise().take();
+    }
+
+    void drop() {
+        if (coro) {
+            coro.promise().release(coro);
+            coro = {};
+        }
+    }
+};
+
+namespace std {
+namespace __internal_interfaces {
+    template <typename T>
+    struct future_value {
+        using type = T;
+    };
+
+    template <typename T>
+    struct future_value<future<T>> {
+        using type = T;
+    };
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief run `fn` as a task on the pool, what `thread f(x)` lowers to
+///
+/// `fn` is moved into the coroutine frame, the only allocation. an async function called by
+/// `fn` is awaited, `thread f(x)` gives a future of the value and not a future of a future
+///
+template <typename Fn>
+future<typename __internal_interfaces::future_value<::std::invoke_result_t<Fn &>>::type>
+run_async(Fn fn) {
+    if constexpr (::std::is_same_v<typename __internal_interfaces::future_value<
+                                       ::std::invoke_result_t<Fn &>>::type,
+                                   ::std::invoke_result_t<Fn &>>) {
+        co_return fn();
+    } else {
+        co_return co_await fn();
+    }
+}
+
+/// \include belongs to the helix standard library.
+/// \brief `await` outside of an async function, blocks until the value is there
+///
+template <typename T>
+T block_on(future<T> &&pending) {
+    return pending.get();
+}
+
+template <typename T>
+T block_on(future<T> &pending) {
+    return pending.get();
+}
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief the byte format `spawn` sends arguments and results in, both ends are this program
+    ///
+    /// numbers and enums are copied as they are, strings and vectors of them as a size and
+    /// their bytes, pairs, tuples, arrays, other containers and plain structs (aggregates)
+    /// element by element. a pointer or a view (string_view, span) means nothing in another
+    /// process and does not compile, neither does a class with private state
+    ///
+    template <typename T>
+    struct wire_element {
+        using type = T;
+    };
+
+    template <typename K, typename V>
+    struct wire_element<::std::pair<const K, V>> {  // the value_type of a map
+        using type = ::std::pair<K, V>;
+    };
+
+    /// only what is a value on its own is copied as bytes, a struct that is trivially copyable
+    /// can still hold a pointer
+    template <typename T>
+    concept wire_plain = ::std::is_arithmetic_v<T> || ::std::is_enum_v<T>;
+
+)",
+        R"(    /// string_view, span and the other views point into the memory of this process
+    template <typename T>
+    concept wire_view = ::std::ranges::view<T>;
+
+    /// converts to any field, counts the fields of an aggregate by how many of it fit in `T{}`
+    struct wire_any_field {
+        template <typename T>
+        operator T() const;
+    };
+
+    template <typename T, typename... Fields>
+    constexpr size_t wire_field_count() {
+        if constexpr (requires { T{Fields{}..., wire_any_field{}}; }) {
+            return wire_field_count<T, Fields..., wire_any_field>();
+        } else {
+            return sizeof...(Fields);
+        }
+    }
+
+    template <typename T>
+    concept wire_aggregate = ::std::is_aggregate_v<T> && !::std::is_array_v<T> &&
+                             wire_field_count<T>() <= 8;
+
+    /// the fields of an aggregate as a tuple of references, for wire_write and wire_read
+    template <typename T>
+    auto wire_fields(T &value) {
+        constexpr size_t count = wire_field_count<::std::remove_const_t<T>>();
+
+        if constexpr (count == 0) {
+            return ::std::tuple<>();
+        } else if constexpr (count == 1) {
+            auto &[a] = value;
+            return ::std::tie(a);
+        } else if constexpr (count == 2) {
+            auto &[a, b] = value;
+            return ::std::tie(a, b);
+        } else if constexpr (count == 3) {
+            auto &[a, b, c] = value;
+            return ::std::tie(a, b, c);
+        } else if constexpr (count == 4) {
+            auto &[a, b, c, d] = value;
+            return ::std::tie(a, b, c, d);
+        } else if constexpr (count == 5) {
+            auto &[a, b, c, d, e] = value;
+            return ::std::tie(a, b, c, d, e);
+        } else if constexpr (count == 6) {
+            auto &[a, b, c, d, e, f] = value;
+            return ::std::tie(a, b, c, d, e, f);
+        } else if constexpr (count == 7) {
+            auto &[a, b, c, d, e, f, g] = value;
+            return ::std::tie(a, b, c, d, e, f, g);
+        } else {
+            auto &[a, b, c, d, e, f, g, h] = value;
+            return ::std::tie(a, b, c, d, e, f, g, h);
+        }
+    }
+
+    template <typename T>
+    concept wire_contiguous = requires(T &value) {
+        value.data();
+        value.resize(size_t{});
+        requires wire_plain<typename T::value_type>;
+    };
+
+    template <typename T>
+    concept wire_range = requires(T &value) {
+        value.begin();
+        value.end();
+        value.size();
+        typename T::value_type;
+    };
+
+    template <typename T>
+    concept wire_tuple = requires { ::std::tuple_size<T>::value; };
+
+    template <typename T>
+    void wire_write(::string &out, const T &value) {
+        static_assert(!wire_view<T>, "spawn can not send a view, send the container it points at");
+
+        if constexpr (wire_plain<T>) {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        } else if constexpr (wire_contiguous<T>) {
+            wire_write(out, static_cast<u64>(value.size()));
+            out.append(reinterpret_cast<const char *>(value.data()),
+                       value.size() * sizeof(typename T::value_type));
+        } else if constexpr (wire_tuple<T>) {
+            ::std::apply([&](const auto &...elements) { (wire_write(out, elements), ...); },
+                         value);
+        } else if constexpr (wire_range<T>) {
+            wire_write(out, static_cast<u64>(value.size()));
+
+            for (const auto &element : value) {
+                wire_write(out, element);
+            }
+        } else if constexpr (wire_aggregate<T>) {
+            wire_write(out, wire_fields(value));
+        } else {
+            static_assert(::std::is_void_v<T>, "spawn can not send this type to another process");
+        }
+    }
+
+    template <typename T>
+    void wire_read(::std::string_view &in, T &value) {
+        static_assert(!wire_view<T>, "spawn can not send a view, send the container it points at");
+
+        if constexpr (wire_plain<T>) {
+            if (in.size() < sizeof(T)) {
+                throw ::std::runtime_error("spawn: truncated message");
+            }
+
+            ::std::memcpy(static_cast<void *>(&value), in.data(), sizeof(T));
+            in.remove_prefix(sizeof(T));
+        } else if constexpr (wire_contiguous<T>) {
+            u64 size = 0;
+            wire_read(in, size);
+
+            if (in.size() / sizeof(typename T::value_type) < size) {
+                throw ::std::runtime_error("spawn: truncated message");
+            }
+
+            value.resize(static_cast<size_t>(size));
+            ::std::memcpy(static_cast<void *>(value.data()),
+                          in.data(),
+                          value.size() * sizeof(typename T::value_type));
+            in.remove_prefix(value.size() * sizeof(typename T::value_type));
+        } else if constexpr (wire_tuple<T>) {
+            ::std::apply([&](auto &...elements) { (wire_read(in, elements), ...); }, value);
+        } else if constexpr (wire_range<T>) {
+            u64 size = 0;
+            wire_read(in, size);
+
+            for (u64 i = 0; i < size; ++i) {
+                typename wire_element<typename T::value_type>::type element{};
+                wire_read(in, element);
+
+                if constexpr (requires { value.push_back(::std::move(element)); }) {
+                    value.push_back(::std::move(element));
+                } else {
+                    value.insert(::std::move(element));
+                }
+            }
+        } else if constexpr (wire_aggregate<T>) {
+            auto fields = wire_fields(value);
+            wire_read(in, fields);
+        } else {
+            static_assert(::std::is_void_v<T>, "spawn can not send this type to another process");
+        }
+    }
+
+)",
+        R"(#if defined(_H1HJA9ZLO_PROCESS_POOL)
+    /// \include belongs to the helix standard library.
+    /// \brief the worker processes `spawn` runs on, forked once and reused
+    ///
+    /// every worker is a fork of the program taken as main starts (see start_process_pool), so
+    /// it has the same code at the same addresses: a job is the address of the function to call
+    /// and its arguments in the wire format. the worker calls it and sends the result back over
+    /// the same socket. a thread of the pool polls the busy workers and puts the coroutine that
+    /// waits for the result back on the task pool
+    ///
+    /// the whole pool is forked while the program still has one thread, a fork taken while
+    /// other threads run can leave a lock (malloc, stdio) held forever in the child. so a
+    /// worker that crashes fails its job and is not replaced, the program keeps running on the
+    /// rest and once none is left `spawn` runs in this process, as without fork. a worker has
+    /// no threads of its own, `thread` tasks started in a spawned function run in place.
+    /// globals are the values they had when main started
+    ///
+    class process_pool {
+      public:
+        /// runs a job in the worker, false with the error in `out` if it threw
+        using entry_fn = bool (*)(::std::string_view args, ::string &out);
+
+        struct job {
+            entry_fn                  entry = nullptr;
+            ::string                  payload;
+            ::string                  reply;
+            bool                      ok = false;
+            ::std::coroutine_handle<> waiting;
+        };
+
+        /// `co_await submit{pool, job}` sends the job and resumes on the task pool once the
+        /// reply is in `job`
+        struct submit {
+            process_pool &pool;
+            job          &work;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(::std::coroutine_handle<> coro) {
+                work.waiting = coro;
+                pool.start(work);  // may resume `coro` before it returns, nothing is used after
+            }
+            void await_resume() const noexcept {}
+        };
+
+        process_pool(const process_pool &)            = delete;
+        process_pool(process_pool &&)                 = delete;
+        process_pool &operator=(const process_pool &) = delete;
+        process_pool &operator=(process_pool &&)      = delete;
+
+        static process_pool &global() {
+            static process_pool pool;
+            return pool;
+        }
+
+        /// set before main by a program that has a `spawn` in it, see uses_process_pool
+        static bool &wanted() {
+            static bool used = false;
+            return used;
+        }
+
+        /// false once every worker has died
+        bool has_workers() {
+            ::std::lock_guard<::std::mutex> guard(lock);
+            return alive != 0;
+        }
+
+        ~process_pool() {
+            {
+                ::std::lock_guard<::std::mutex> guard(lock);
+                stopping = true;
+            }
+
+            wake_poller();
+            poller.join();
+
+            for (auto &each : workers) {
+                if (each.socket != -1) {
+                    ::close(each.socket);  // the worker reads the end of the stream and exits
+                    ::waitpid(each.pid, nullptr, 0);
+                }
+            }
+
+            ::close(wake[0]);
+            ::close(wake[1]);
+        }
+
+      private:
+        struct worker {
+            pid_t pid     = -1;
+            int   socket  = -1;  ///< -1 once the worker died
+            job  *current = nullptr;
+        };
+
+        ::std::vector<worker> workers;
+        ::std::deque<job *>   waiting;  ///< jobs sent once a worker is idle
+        ::std::mutex          lock;     ///< guards `workers` and `waiting`
+        ::std::thread         poller;
+        int                   wake[2] = {-1, -1};  ///< a byte here makes the poller look again
+        size_t                alive    = 0;
+        bool                  stopping = false;
+
+        process_pool() {
+            const size_t count = ::std::max(1U, ::std::thread::hardware_concurrency());
+
+            if (::pipe(wake) == -1) {
+                throw ::std::runtime_error("spawn: could not create a pipe");
+            }
+
+            workers.resize(count);
+
+            for (size_t i = 0; i < count; ++i) {
+                fork_worker(i);
+            }
+
+            alive  = count;
+            poller = ::std::thread([this] { poll_replies(); });  // after the forks, not before
+        }
+
+        static bool read_exact(int fd, void *into, size_t size) {
+            auto *at = static_cast<char *>(into);
+
+            while (size > 0) {
+                const auto got = ::read(fd, at, size);
+
+                if (got < 0 && errno == EINTR) {
+                    continue;
+                }
+
+                if (got <= 0) {
+                    return false;
+                }
+
+                at += got;
+                size -= static_cast<size_t>(got);
+            }
+
+            return true;
+        }
+
+        static bool write_all(int fd, ::std::string_view data) {
+            while (!data.empty()) {
+#if defined(MSG_NOSIGNAL)
+                const auto sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+#else
+                const auto sent = ::send(fd, data.data(), data.size(), 0);
+#endif
+
+                if (sent < 0 && errno == EINTR) {
+                    continue;
+                }
+
+                if (sent <= 0) {
+                    return false;  // the worker died, the poller sees it hang up
+                }
+
+                data.remove_prefix(static_cast<size_t>(sent));
+            }
+
+            return true;
+        }
+
+        /// a message is its size followed by its bytes, a reply starts with one byte for ok
+        static bool read_message(int fd, ::string &into) {
+            u64 size = 0;
+
+            if (!read_exact(fd, &size, sizeof(size))) {
+                return false;
+            }
+
+            into.resize(static_cast<size_t>(size));
+            return read_exact(fd, into.data(), into.size());
+        }
+
+        /// the loop of a worker process, returns when the program closes its socket
+        static void serve(int fd) {
+            ::string request;
+            ::string result;
+            ::string reply;
+
+            while (read_message(fd, request)) {
+                entry_fn entry = nullptr;
+
+                if (request.size() < sizeof(entry)) {
+                    return;
+                }
+
+                ::std::memcpy(static_cast<void *>(&entry), request.data(), sizeof(entry));
+
+                result.clear();
+                const bool ok  = entry(::std::string_view(request).substr(sizeof(entry)), result);
+                const u64 size = result.size() + 1;
+
+                reply.assign(reinterpret_cast<const char *>(&size), sizeof(size));
+                reply.push_back(static_cast<char>(ok ? 1 : 0));
+                reply.append(result);
+
+                flush_output();  // print in the job is seen before the result is used
+
+                if (!write_all(fd, reply)) {
+                    return;
+                }
+            }
+        }
+
+        void fork_worker(size_t index) {
+            int ends[2];
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, ends) == -1) {
+                throw ::std::runtime_error("spawn: could not create a socket pair");
+            }
+
+            ::std::fflush(nullptr);
+            flush_output();  // or the worker prints it again
+
+            const pid_t pid = ::fork();
+
+            if (pid == -1) {
+                ::close(ends[0]);
+                ::close(ends[1]);
+                throw ::std::runtime_error("spawn: could not fork a worker process");
+            }
+
+            if (pid == 0) {
+                ::close(ends[0]);
+
+                for (size_t i = 0; i < workers.size(); ++i) {
+                    if (i != index && workers[i].socket != -1) {
+                        ::close(workers[i].socket);  // else a worker never sees the end
+                    }
+                }
+
+                ::close(wake[0]);
+                ::close(wake[1]);
+
+                task_pool::runs_inline() = true;
+                serve(ends[1]);
+                ::_exit(0);  // the destructors belong to the program, not to a worker
+            }
+
+            ::close(ends[1]);
+
+            workers[index].pid    = pid;
+            workers[index].socket = ends[0];
+        }
+
+        void wake_poller() const {
+            const char byte = 0;
+
+            while (::write(wake[1], &byte, 1) == -1 && errno == EINTR) {}
+        }
+
+        void start(job &work) {
+            ::std::lock_guard<::std::mutex> guard(lock);
+
+            if (alive == 0) {
+                fail(work, "every worker process has died");
+                return;
+            }
+
+            for (auto &each : workers) {
+                if (each.socket != -1 && each.current == nullptr) {
+                    send(each, work);
+                    return;
+                }
+            }
+
+            waiting.push_back(&work);
+        }
+
+        static void fail(job &work, ::string reason) {
+            work.ok    = false;
+            work.reply = ::std::move(reason);
+
+            task_pool::global().post(work.waiting);
+        }
+
+        /// `lock` is held
+        void send(worker &to, job &work) {
+            ::string message(sizeof(u64), '\0');
+            const u64 size = sizeof(entry_fn) + work.payload.size();
+
+            ::std::memcpy(message.data(), &size, sizeof(size));
+            message.append(reinterpret_cast<const char *>(&work.entry), sizeof(entry_fn));
+            message.append(work.payload);
+
+            to.current = &work;
+            write_all(to.socket, message);
+            wake_poller();
+        }
+
+        /// the reply of `from` is ready, or it hung up, `lock` is held
+        void finish(size_t index) {
+            worker  &from = workers[index];
+            job     &work = *from.current;
+            ::string reply;
+
+            from.current = nullptr;
+
+            if (read_message(from.socket, reply) && !reply.empty()) {
+                work.ok = reply.front() != 0;
+                work.reply.assign(reply, 1);
+
+                if (!waiting.empty()) {
+                    send(from, *waiting.front());
+                    waiting.pop_front();
+                }
+
+                task_pool::global().post(work.waiting);
+                return;
+            }
+
+            int status = 0;
+
+            ::close(from.socket);
+            ::waitpid(from.pid, &status, 0);
+
+            from.socket = -1;  // not forked again, the program has threads by now
+            --alive;
+
+            fail(work,
+                 WIFSIGNALED(status) ? "the worker process was killed by signal " +
+                                           ::std::to_string(WTERMSIG(status))
+                                     : "the worker process exited with status " +
+                                           ::std::to_string(WEXITSTATUS(status)));
+
+            while (alive == 0 && !waiting.empty()) {
+                fail(*waiting.front(), "every worker process has died");
+                waiting.pop_front();
+            }
+        }
+
+        void poll_replies() {
+            ::std::vector<pollfd> fds;
+            ::std::vector<size_t> busy;
+
+            while (true) {
+                fds.assign(1, pollfd{wake[0], POLLIN, 0});
+                busy.clear();
+
+                {
+                    ::std::lock_guard<::std::mutex> guard(lock);
+
+                    if (stopping) {
+                        return;
+                    }
+
+                    for (size_t i = 0; i < workers.size(); ++i) {
+                        if (workers[i].current != nullptr) {
+                            fds.push_back(pollfd{workers[i].socket, POLLIN, 0});
+                            busy.push_back(i);
+                        }
+                    }
+                }
+
+                if (::poll(fds.data(), fds.size(), -1) == -1) {
+                    continue;  // EINTR
+                }
+
+                if ((fds[0].revents & POLLIN) != 0) {
+                    char drain[64];
+                    [[maybe_unused]] const auto ignored = ::read(wake[0], drain, sizeof(drain));
+                }
+
+                ::std::lock_guard<::std::mutex> guard(lock);
+
+                for (size_t i = 0; i < busy.size(); ++i) {
+                    if (fds[i + 1].revents != 0) {
+                        finish(busy[i]);
+                    }
+                }
+            }
+        }
+    };
+
+    /// spawn_call names this variable, so only a program with a `spawn` in it gets the
+    /// initializer, it runs with the other globals and start_process_pool forks once it is set
+    template <typename = void>
+    inline const bool uses_process_pool = (process_pool::wanted() = true);
+#endif
+
+    template <typename T>
+    struct is_future : ::std::false_type {};
+
+    template <typename T>
+    struct is_future<future<T>> : ::std::true_type {};
+
+    /// call `Fn` with the arguments in `in` and write what it returns to `out`, run in a worker
+    template <typename Fn, typename R, typename... Args>
+    bool spawn_entry(::std::string_view in, ::string &out) {
+        try {
+            ::std::tuple<Args...> args;
+            wire_read(in, args);
+
+            if constexpr (is_future<::std::invoke_result_t<Fn, Args...>>::value) {
+                auto result = ::std::apply(Fn{}, ::std::move(args));
+
+                if constexpr (::std::is_void_v<R>) {
+                    result.get();
+                } else {
+                    wire_write(out, result.get());
+                }
+            } else if constexpr (::std::is_void_v<R>) {
+                ::std::apply(Fn{}, ::std::move(args));
+            } else {
+                wire_write(out, ::std::apply(Fn{}, ::std::move(args)));
+            }
+
+            return true;
+        } catch (const ::std::exception &error) {
+            out = error.what();
+        } catch (...) {
+            out = "unknown exception";
+        }
+
+        return false;
+    }
+
+    template <typename Fn, typename... Args>
+    using spawn_value_t = typename future_value<::std::invoke_result_t<Fn, Args...>>::type;
+
+    template <typename Fn, typename... Args>
+    future<spawn_value_t<Fn, Args...>> spawn_call(Fn fn, Args... args) {
+        using R = spawn_value_t<Fn, Args...>;
+
+)",
+        R"(#if defined(_H1HJA9ZLO_PROCESS_POOL)
+        if (uses_process_pool<> && !task_pool::runs_inline() &&
+            process_pool::global().has_workers()) {
+            process_pool::job work;
+            work.entry = &spawn_entry<Fn, R, Args...>;
+            wire_write(work.payload, ::std::tuple<const Args &...>(args...));
+
+            co_await process_pool::submit{process_pool::global(), work};
+
+            if (!work.ok) {
+                throw ::std::runtime_error("spawn: " + work.reply);
+            }
+
+            if constexpr (!::std::is_void_v<R>) {
+                R                  result{};
+                ::std::string_view in = work.reply;
+
+                wire_read(in, result);
+                co_return result;
+            } else {
+                co_return;
+            }
+        }
+#endif
+
+        // no fork (windows), in a worker or no worker left: a task on the pool of this process
+        if constexpr (is_future<::std::invoke_result_t<Fn, Args...>>::value) {
+            co_return co_await fn(::std::move(args)...);
+        } else {
+            co_return fn(::std::move(args)...);
+        }
+    }
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief run `fn(args...)` in a worker process, what `spawn f(x)` lowers to
+///
+/// spawn f(a, "b")  ->  helix::std::run_spawned([](auto... args) { return f(args...); }, a, "b")
+///
+/// `fn` can not capture anything, only the arguments and the result go to the worker and back
+/// (see wire_write). a crash in the worker is an exception thrown by `await`
+///
+template <typename Fn, typename... Args>
+future<__internal_interfaces::spawn_value_t<Fn, __internal_interfaces::literal_t<Args>...>>
+run_spawned(Fn fn, Args &&...args) {
+    static_assert(::std::is_empty_v<Fn> && ::std::is_default_constructible_v<Fn>,
+                  "a spawned function can not capture anything");
+
+    return __internal_interfaces::spawn_call(
+        fn, __internal_interfaces::literal_t<Args>(::std::forward<Args>(args))...);
+}
+
+/// \include belongs to the helix standard library.
+/// \brief the first statement of `main`, forks the workers of `spawn` if the program uses it
+///
+/// forking is only safe while the program has one thread, main starting is the last point
+/// where that holds and every global is set. a `spawn` before main (in the initializer of a
+/// global) still works, the pool is then forked by that first `spawn`
+///
+inline void start_process_pool() {
+#if defined(_H1HJA9ZLO_PROCESS_POOL)
+    if (__internal_interfaces::process_pool::wanted()) {
+        static_cast<void>(__internal_interfaces::process_pool::global());
+    }
+#endif
+}
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief the chunk size of a parallel loop when none is given, about 64 chunks
+    ///
+    /// it depends on the count alone, not on the number of threads, so the chunks of a
+    /// par_reduce (and with them the order of its operations) are the same on every machine
+    ///
+    inline size_t default_grain(size_t count) { return ::std::max<size_t>(1, count / 64); }
+
+    /// \include belongs to the helix standard library.
+    /// \brief call `body(begin, end)` for every chunk of `grain` indices of [0, count)
+    ///
+    /// the chunks are claimed one at a time from a shared counter, by the calling thread and by
+    /// a task per other worker of the pool, so a thread that finishes early takes more of them.
+    /// returns once every chunk is done, the first exception thrown by `body` is rethrown and
+    /// the chunks nobody claimed yet are skipped
+    ///
+    template <typename Body>
+    void par_chunks(size_t count, size_t grain, const Body &body) {
+        if (grain == 0) {
+            grain = default_grain(count);
+        }
+
+        const size_t chunks = count / grain + (count % grain != 0 ? 1 : 0);
+
+        if (chunks <= 1 || task_pool::runs_inline()) {
+            for (size_t begin = 0; begin < count; begin += grain) {
+                body(begin, ::std::min(count, begin + grain));
+            }
+
+            return;
+        }
+
+        ::std::atomic<size_t> next{0};
+        ::std::atomic<bool>   failed{false};
+
+        const auto run = [&] {
+            for (size_t chunk = next.fetch_add(1); chunk < chunks && !failed.load();
+                 chunk        = next.fetch_add(1)) {
+                try {
+                    body(chunk * grain, ::std::min(count, chunk * grain + grain));
+                } catch (...) {
+                    failed.store(true);
+                    throw;
+                }
+            }
+        };
+
+        const size_t helpers = ::std::min(chunks, task_pool::global().size()) - 1;
+
+        ::std::vector<future<void>> running;
+        running.reserve(helpers);
+
+        for (size_t i = 0; i < helpers; ++i) {
+            running.push_back(run_async(run));
+        }
+
+        ::std::exception_ptr error;
+
+        try {
+            run();
+        } catch (...) {
+            error = ::std::current_exception();
+        }
+
+        for (auto &helper : running) {  // they use this frame, wait for all of them
+            try {
+                helper.get();
+            } catch (...) {
+                if (!error) {
+                    error = ::std::current_exception();
+                }
+            }
+        }
+
+        if (error) {
+            ::std::rethrow_exception(error);
+        }
+    }
+}  // namespace __internal_interfaces
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief `last - first` for `first <= last`, unsigned for an integer so a range wider than
+    /// the signed maximum (`i32::min..i32::max`) does not overflow
+    ///
+    template <typename T>
+    constexpr auto range_distance(const T &first, const T &last) noexcept {
+        if constexpr (::std::is_integral_v<T> && !::std::is_same_v<T, bool>) {
+            using U = ::std::make_unsigned_t<T>;
+            return static_cast<U>(static_cast<U>(last) - static_cast<U>(first));
+        } else {
+            return last - first;
+        }
+    }
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief the first test of a counted for over `a..=b` or `(a..b).step_by(s)`
+///
+/// for i in (0..n).step_by(2) { ... }
+///   -> for (int i = 0, end = n, step = 2, more = helix::std::range_first<false>(i, end, step);
+///           more; more = helix::std::range_next<false>(i, end, step)) { ... }
+///
+template <bool Inclusive, typename T>
+constexpr bool range_first(const T &value, const T &end) {
+    return Inclusive ? !(end < value) : value < end;
+}
+
+template <bool Inclusive, typename T>
+constexpr bool range_first(const T &value, const T &end, const T &step) {
+    if (!(T{} < step)) {
+        throw ::std::invalid_argument("step_by needs a step greater than 0");
+    }
+
+    return range_first<Inclusive>(value, end);
+}
+
+/// \include belongs to the helix standard library.
+/// \brief move `value` to the next element of the range and true, or false with `value` left
+/// as it is when that would leave the range
+///
+/// the next value is never computed past the end, `0..=255` over u8 and a step over the
+/// maximum end the loop instead of overflowing. the body may have moved `value` itself, a
+/// value already at or past the end ends the loop too
+///
+template <bool Inclusive, typename T>
+constexpr bool range_next(T &value, const T &end) {
+    static_assert(Inclusive, "`a..b` without a step is a plain `i < end; ++i` loop");
+
+    if (!(value < end)) {
+        return false;
+    }
+
+    ++value;
+    return true;
+}
+
+template <bool Inclusive, typename T>
+constexpr bool range_next(T &value, const T &end, const T &step) {
+    if (!(value < end)) {
+        return false;
+    }
+
+    const auto left = __internal_interfaces::range_distance(value, end);
+    const auto by   = static_cast<decltype(left)>(step);
+
+    if (Inclusive ? left < by : !(by < left)) {
+        return false;
+    }
+
+    if constexpr (::std::is_integral_v<T>) {  // in the unsigned type, the sum fits in T
+        value = static_cast<T>(static_cast<decltype(left)>(value) + by);
+    } else {
+        value += step;
+    }
+
+    return true;
+}
+
+namespace __internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief `fn(first + i)` for every i in [0, count) on the task pool, see par_for
+    ///
+    template <typename Index, typename Fn>
+    void par_offsets(Index first, size_t count, Fn &fn, size_t grain) {
+        par_chunks(count, grain, [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                if constexpr (::std::is_integral_v<Index>) {  // wraps back into range, no overflow
+                    using U = ::std::make_unsigned_t<Index>;
+                    fn(static_cast<Index>(static_cast<U>(first) + static_cast<U>(i)));
+                } else {
+                    fn(static_cast<Index>(first + static_cast<Index>(i)));
+                }
+            }
+        });
+    }
+}  // namespace __internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief `fn(i)` for every i in [first, last) on the task pool, in no particular order
+///
+/// parallel for i in 0..n { ... }  ->  helix::std::par_for(0, n, [&](auto i) { ... });
+///
+/// `grain` is the number of iterations run together, 0 picks one (see default_grain). raise it
+/// when an iteration is only a few instructions
+///
+template <typename First, typename Last, typename Fn>
+void par_for(First first, Last last, Fn &&fn, size_t grain = 0) {
+    using Index = ::std::common_type_t<First, Last>;
+
+    const Index begin = static_cast<Index>(first);
+    const Index end   = static_cast<Index>(last);
+
+    if (!(begin < end)) {
+        return;
+    }
+
+    __internal_interfaces::par_offsets(
+        begin, static_cast<size_t>(__internal_interfaces::range_distance(begin, end)), fn, grain);
+}
+
+/// \include belongs to the helix standard library.
+/// \brief `fn(i)` for every i in [first, last] on the task pool, in no particular order
+///
+/// parallel for i in 0..=n { ... }  ->  helix::std::par_for_to(0, n, [&](auto i) { ... });
+///
+/// `last + 1` would overflow at the maximum of the type, `last` itself runs on the calling
+/// thread once the rest is done
+///
+template <typename First, typename Last, typename Fn>
+void par_for_to(First first, Last last, Fn &&fn, size_t grain = 0) {
+    using Index = ::std::common_type_t<First, Last>;
+
+    const Index begin = static_cast<Index>(first);
+    const Index end   = static_cast<Index>(last);
+
+    if (end < begin) {
+        return;
+    }
+
+    __internal_interfaces::par_offsets(
+        begin, static_cast<size_t>(__internal_interfaces::range_distance(begin, end)), fn, grain);
+    fn(end);
+}
+
+/// \include belongs to the helix standard library.
+/// \brief `fn(element)` for every element of `range` on the task pool, in no particular order
+///
+/// parallel for x in values { ... }  ->  helix::std::par_each(values, [&](auto x) { ... });
+///
+/// a range without random access (a map, a generator) runs in order on the calling thread
+///
+template <typename Range, typename Fn>
+void par_each(Range &&range, Fn &&fn, size_t grain = 0) {
+    if constexpr (::std::ranges::random_access_range<Range> && ::std::ranges::sized_range<Range>) {
+        const auto first = ::std::ranges::begin(range);
+
+        __internal_interfaces::par_chunks(
+            static_cast<size_t>(::std::ranges::size(range)), grain, [&](size_t from, size_t to) {
+                for (size_t i = from; i < to; ++i) {
+                    fn(first[static_cast<::std::ranges::range_difference_t<Range>>(i)]);
+                }
+            });
+    } else {
+        for (auto &&element : range) {
+            fn(element);
+        }
+    }
+}
+
+/// \include belongs to the helix standard library.
+/// \brief a list of `fn(value)` for every value, in the order of `values`
+///
+template <typename T, typename Fn>
+auto par_map(const ::std::vector<T> &values, Fn &&fn, size_t grain = 0) {
+    using R = ::std::decay_t<::std::invoke_result_t<Fn &, const T &>>;
+
+    // vector<bool> packs its elements, neighbours can not be written by two threads
+    using Stored = ::std::conditional_t<::std::is_same_v<R, bool>, u8, R>;
+
+    ::std::vector<Stored> out(values.size());
+
+    __internal_interfaces::par_chunks(values.size(), grain, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            out[i] = fn(values[i]);
+        }
+    });
+
+    if constexpr (::std::is_same_v<R, bool>) {
+        return ::std::vector<bool>(out.begin(), out.end());
+    } else {
+        return out;
+    }
+}
+
+/// \include belongs to the helix standard library.
+/// \brief fold `values` into a U with `op`, the chunks are folded in parallel
+///
+/// every chunk of `grain` values is folded left to right by `op(acc, value)` starting from a
+/// copy of `identity`, then the chunk results are folded left to right by `combine(acc, acc)`
+/// starting from `identity`. for the sum of squares of a list of ints:
+///
+///     par_reduce(values, 0.0, [](f64 acc, i32 x) { return acc + x * x; },
+///                [](f64 a, f64 b) { return a + b; })
+///
+/// `identity` must change nothing (`combine(identity, acc) == acc`) and `combine` has to be
+/// associative for the result to match a sequential fold. the order of the calls only depends
+/// on the size of `values` and `grain`, a floating point sum gives the same result on every run
+/// and every machine
+///
+template <typename T, typename U, typename Op, typename Combine>
+    requires ::std::invocable<Op &, U, const T &> && ::std::invocable<Combine &, U, U>
+U par_reduce(const ::std::vector<T> &values,
+             const U                 &identity,
+             Op                     &&op,
+             Combine                &&combine,
+             size_t                   grain = 0) {
+    if (grain == 0) {
+        grain = __internal_interfaces::default_grain(values.size());
+    }
+
+    ::std::vector<::std::optional<U>> partial(values.size() / grain +
+                                              (values.size() % grain != 0 ? 1 : 0));
+
+    __internal_interfaces::par_chunks(values.size(), grain, [&](size_t from, size_t to) {
+        U result = identity;
+
+        for (size_t i = from; i < to; ++i) {
+            result = op(::std::move(result), values[i]);
+        }
+
+        partial[from / grain].emplace(::std::move(result));
+    });
+
+    U result = identity;
+
+    for (auto &chunk : partial) {
+        result = combine(::std::move(result), ::std::move(*chunk));
+    }
+
+    return result;
+}
+
+)",
+        R"(/// \include belongs to the helix standard library.
+/// \brief fold `values` with `op` starting from `init`, the chunks are folded in parallel
+///
+///     par_reduce(values, 0.0, [](f64 a, f64 b) { return a + b; })  // a list of f64
+///
+/// the elements and the result have the same type, chunk results are combined with `op` as
+/// well, so `op` has to be associative for the result to match a sequential fold. to fold into
+/// another type, pass an identity and a separate combine (see above)
+///
+template <typename T, typename U, typename Op>
+    requires ::std::same_as<T, U> && ::std::invocable<Op &, T, const T &>
+U par_reduce(const ::std::vector<T> &values, U init, Op &&op, size_t grain = 0) {
+    if (grain == 0) {
+        grain = __internal_interfaces::default_grain(values.size());
+    }
+
+    ::std::vector<::std::optional<U>> partial(values.size() / grain +
+                                              (values.size() % grain != 0 ? 1 : 0));
+
+    // no identity is known, a chunk starts from its first value (it is never empty)
+    __internal_interfaces::par_chunks(values.size(), grain, [&](size_t from, size_t to) {
+        U result = values[from];
+
+        for (size_t i = from + 1; i < to; ++i) {
+            result = op(::std::move(result), values[i]);
+        }
+
+        partial[from / grain].emplace(::std::move(result));
+    });
+
+    for (auto &result : partial) {
+        init = op(::std::move(init), ::std::move(*result));
+    }
+
+    return init;
+}
+
+/// \include belongs to the helix standard library.
+/// \brief sort `values` with `compare`, chunks are sorted in parallel and then merged pairwise
+///
+/// the merges are stable and the chunks only depend on the size and `grain`, so equal elements
+/// end up in the same order on every run
+///
+template <typename T, typename Compare = ::std::less<>>
+void par_sort(::std::vector<T> &values, Compare compare = {}, size_t grain = 0) {
+    const size_t count = values.size();
+
+    if (grain == 0) {
+        grain = ::std::max<size_t>(__internal_interfaces::default_grain(count), 4096);
+    }
+
+    if (count <= grain) {
+        ::std::sort(values.begin(), values.end(), compare);
+        return;
+    }
+
+    const auto at = [&](size_t index) {
+        return values.begin() + static_cast<::std::ptrdiff_t>(::std::min(index, count));
+    };
+
+    __internal_interfaces::par_chunks(count, grain, [&](size_t from, size_t to) {
+        ::std::sort(at(from), at(to), compare);
+    });
+
+    for (size_t width = grain; width < count; width *= 2) {
+        const size_t pairs = count / (2 * width) + (count % (2 * width) != 0 ? 1 : 0);
+
+        __internal_interfaces::par_chunks(pairs, 1, [&](size_t from, size_t to) {
+            for (size_t pair = from; pair < to; ++pair) {
+                const size_t begin = pair * 2 * width;
+
+                if (begin + width < count) {
+                    ::std::inplace_merge(
+                        at(begin), at(begin + width), at(begin + 2 * width), compare);
+                }
+            }
+        });
+    }
+}
+}  // namespace std
+
+/// \include belongs to the helix standard library.
+/// \brief a bump allocator whose memory is given back all at once, for request scoped work
+///
+/// with arena() as a {                        {
+///     let names = a.list::<string>();   ->       auto &&a = helix::arena();
+///     ...                                        helix::std::context _H1HJA9ZLO_with(a);
+/// }                                              { auto names = a.list<string>(); ... } }
+///
+/// allocating is a pointer bump in the current block, a block is twice the size of the one
+/// before it. nothing is freed one by one, leaving the `with` (or `release()`) runs the
+/// destructors of the objects from `make` and frees every block, the containers made with
+/// `list` and `string` must not outlive it. while a `with` is active the arena is the
+/// region_resource of its thread, any std::pmr container can be pointed at it
+///
+class arena {
+  public:
+    explicit arena(size_t first_block = 4096)
+        : pool(first_block) {}
+
+    arena(const arena &)            = delete;
+    arena(arena &&)                 = delete;
+    arena &operator=(const arena &) = delete;
+    arena &operator=(arena &&)      = delete;
+
+    ~arena() { release(); }
+
+    [[nodiscard]] ::std::pmr::memory_resource *resource() noexcept { return &pool; }
+
+    /// an empty list that allocates from the arena
+    template <typename T>
+    [[nodiscard]] ::std::pmr::vector<T> list() {
+        return ::std::pmr::vector<T>(&pool);
+    }
+
+    /// a copy of `text` in the arena
+    [[nodiscard]] ::std::pmr::string string(::std::string_view text = {}) {
+        return ::std::pmr::string(text, &pool);
+    }
+
+    /// construct a T in the arena, its destructor runs on release
+    template <typename T, typename... Args>
+    T *make(Args &&...args) {
+        if constexpr (::std::is_trivially_destructible_v<T>) {
+            return ::new (pool.allocate(sizeof(T), alignof(T))) T(::std::forward<Args>(args)...);
+        } else {
+            auto *made = ::new (pool.allocate(sizeof(holder<T>), alignof(holder<T>)))
+                holder<T>(::std::forward<Args>(args)...);
+
+            made->next  = destructors;
+            destructors = made;
+
+            return &made->value;
+        }
+    }
+
+    /// destroy everything made in the arena and free its blocks, it can be used again after
+    void release() noexcept {
+        for (cleanup *each = destructors; each != nullptr; each = each->next) {
+            each->destroy();
+        }
+
+        destructors = nullptr;
+        pool.release();
+    }
+
+    /// the arena of the innermost `with` on this thread, null outside of one
+    static arena *current() noexcept { return active(); }
+
+    /// `with` entry, the arena becomes the region of this thread
+    void enter() noexcept {
+        previous = active();
+        active() = this;
+    }
+
+    /// `with` exit, everything allocated in the region is released
+    void exit() noexcept {
+        active() = previous;
+        previous = nullptr;
+        release();
+    }
+
+  private:
+    struct cleanup {
+        cleanup *next = nullptr;
+
+        virtual void destroy() noexcept = 0;
+
+      protected:
+        ~cleanup() = default;
+    };
+
+    /// a value with a non-trivial destructor, the destructor runs on release
+    template <typename T>
+    struct holder final : cleanup {
+        T value;
+
+        template <typename... Args>
+        explicit holder(Args &&...args)
+            : value(::std::forward<Args>(args)...) {}
+
+        void destroy() noexcept override { value.~T(); }
+    };
+
+    ::std::pmr::monotonic_buffer_resource pool;
+    cleanup                              *destructors = nullptr;  ///< newest first
+    arena                                *previous    = nullptr;  ///< the region `enter` replaced
+
+    struct innermost_slot {
+        static constexpr arena *initial = nullptr;
+    };
+
+    static arena *&active() noexcept {
+        return helix::std::__internal_interfaces::thread_slot<arena *, innermost_slot>();
+    }
+};
+
+namespace std {
+/// \include belongs to the helix standard library.
+/// \brief the memory resource of the innermost `with arena` of this thread, the heap outside
+///
+inline ::std::pmr::memory_resource *region_resource() noexcept {
+    arena *innermost = arena::current();
+    return innermost != nullptr ? innermost->resource() : ::std::pmr::get_default_resource();
+}
+}  // namespace std
+
+namespace std::__internal_interfaces {
+    /// \include belongs to the helix standard library.
+    /// \brief the signed integer as wide as T, the lanes of a comparison between simd<T, N>
+    ///
+    template <typename T>
+    using mask_lane_t = ::std::conditional_t<
+        sizeof(T) == 1,
+        i8,
+        ::std::conditional_t<sizeof(T) == 2, i16, ::std::conditional_t<sizeof(T) == 4, i32, i64>>>;
+}  // namespace std::__internal_interfaces
+
+/// \include belongs to the helix standard library.
+/// \brief N values of T in one register, every operator works lane by lane
+///
+/// let v = f32x8::load(xs, i) * 2.0 + f32x8::load(ys, i);  ->  helix::simd<float, 8> v = ...
+/// v.store(out, i);
+///
+/// built on the vector extensions of gcc and clang, `a + b` is a single instruction when the
+/// target has registers of N * sizeof(T) bytes and a few otherwise (compile with -march to get
+/// the wide ones). other compilers get a plain array and loops. a scalar operand is broadcast
+/// to every lane, comparisons give a mask: simd<i32, N> (for f32 lanes) with -1 where true and
+/// 0 where false, for select/any/all. reductions and the lane wise math (min, max, sqrt, abs)
+/// are found by argument lookup, `reduce_add(v)` needs no prefix
+///
+template <typename T, size_t N>
+class simd {
+    static_assert(::std::is_arithmetic_v<T> && !::std::is_same_v<T, bool> && sizeof(T) <= 8,
+                  "simd lanes are integers or floating point values of at most 64 bits");
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the lane count of a simd is a power of two");
+
+  public:
+    using value_type = T;
+    using mask_type  = simd<std::__internal_interfaces::mask_lane_t<T>, N>;
+
+    /// every lane 0
+    simd() noexcept
+        : value{} {}
+
+    /// every lane `scalar`
+    simd(T scalar) noexcept {
+        for (size_t i = 0; i < N; ++i) {
+            value[i] = scalar;
+        }
+    }
+
+    /// one value per lane, `i32x4(1, 2, 3, 4)`
+    template <typename... Lanes>
+        requires(sizeof...(Lanes) == N && N > 1 && (::std::is_convertible_v<Lanes, T> && ...))
+    simd(Lanes... lanes) noexcept {
+        size_t i = 0;
+        ((value[i++] = static_cast<T>(lanes)), ...);
+    }
+
+    [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+    /// N values starting at `from`, it does not have to be aligned
+    [[nodiscard]] static simd load(const T *from) noexcept {
+        simd out;
+        ::std::memcpy(&out.value, from, sizeof(out.value));
+        return out;
+    }
+
+    /// the N values of a list (or any contiguous range) starting at `offset`, lanes past its
+    /// end are 0 so the last, short chunk of a loop needs no special case
+    template <::std::ranges::contiguous_range Range>
+        requires ::std::is_same_v<::std::ranges::range_value_t<Range>, T>
+    [[nodiscard]] static simd load(const Range &from, size_t offset = 0) {
+        const size_t lanes = chunk(::std::ranges::size(from), offset);
+
+        if (lanes == N) [[likely]] {
+            return load(::std::ranges::data(from) + offset);
+        }
+
+        simd out;
+        ::std::memcpy(&out.value, ::std::ranges::data(from) + offset, lanes * sizeof(T));
+        return out;
+    }
+
+    /// write the N lanes to `to`, it does not have to be aligned
+    void store(T *to) const noexcept { ::std::memcpy(to, &value, sizeof(value)); }
+
+    /// write the lanes to a list starting at `offset`, lanes past its end are dropped
+    template <::std::ranges::contiguous_range Range>
+        requires ::std::is_same_v<::std::ranges::range_value_t<Range>, T>
+    void store(Range &to, size_t offset = 0) const {
+        const size_t lanes = chunk(::std::ranges::size(to), offset);
+
+        if (lanes == N) [[likely]] {
+            store(::std::ranges::data(to) + offset);
+        } else {
+            ::std::memcpy(::std::ranges::data(to) + offset, &value, lanes * sizeof(T));
+        }
+    }
+
+    [[nodiscard]] T operator[](size_t lane) const noexcept { return value[lane]; }
+
+    void set(size_t lane, T scalar) noexcept { value[lane] = scalar; }
+
+    [[nodiscard]] ::string to_string() const {
+        ::string out = "[";
+
+        for (size_t i = 0; i < N; ++i) {
+            if (i != 0) {
+                out += ", ";
+            }
+
+            std::__internal_interfaces::append_to_string(out, static_cast<T>(value[i]));
+        }
+
+        return out + "]";
+    }
+
+#if defined(_H1HJA9ZLO_VECTOR_EXTENSIONS)
+#define _H1HJA9ZLO_SIMD_LANES(each, whole) whole
+#else
+#define _H1HJA9ZLO_SIMD_LANES(each, whole) \
+    for (size_t i = 0; i < N; ++i) {       \
+        each;                              \
+    }
+#endif
+
+#define _H1HJA9ZLO_SIMD_OPERATOR(op, ...)                                                     \
+    friend simd operator op(const simd &lhs, const simd &rhs) noexcept __VA_ARGS__ {          \
+        simd out;                                                                             \
+        _H1HJA9ZLO_SIMD_LANES(out.value[i] = T(lhs.value[i] op rhs.value[i]),                 \
+                              out.value = lhs.value op rhs.value);                            \
+        return out;                                                                           \
+    }                                                                                         \
+                                                                                              \
+    simd &operator op##=(const simd &rhs) noexcept __VA_ARGS__ { return *this = *this op rhs; }
+
+// with vector extensions a comparison gives the lanes of mask_type, the cast only changes the
+// spelling of the type (long against long long), never a value
+#define _H1HJA9ZLO_SIMD_COMPARISON(op)                                                        \
+    friend mask_type operator op(const simd &lhs, const simd &rhs) noexcept {                 \
+        mask_type out;                                                                        \
+        _H1HJA9ZLO_SIMD_LANES(out.value[i] = lhs.value[i] op rhs.value[i] ? -1 : 0,           \
+                              out.value = (typename mask_type::native)(lhs.value op rhs.value)); \
+        return out;                                                                           \
+    }
+
+    simd operator-() const noexcept {
+        simd out;
+        _H1HJA9ZLO_SIMD_LANES(out.value[i] = T(-value[i]), out.value = -value);
+        return out;
+    }
+
+    simd operator~() const noexcept
+        requires ::std::is_integral_v<T>
+    {
+        simd out;
+        _H1HJA9ZLO_SIMD_LANES(out.value[i] = T(~value[i]), out.value = ~value);
+        return out;
+    }
+
+    _H1HJA9ZLO_SIMD_OPERATOR(+)
+    _H1HJA9ZLO_SIMD_OPERATOR(-)
+    _H1HJA9ZLO_SIMD_OPERATOR(*)
+    _H1HJA9ZLO_SIMD_OPERATOR(/)
+    _H1HJA9ZLO_SIMD_OPERATOR(%, requires ::std::is_integral_v<T>)
+    _H1HJA9ZLO_SIMD_OPERATOR(&, requires ::std::is_integral_v<T>)
+    _H1HJA9ZLO_SIMD_OPERATOR(|, requires ::std::is_integral_v<T>)
+    _H1HJA9ZLO_SIMD_OPERATOR(^, requires ::std::is_integral_v<T>)
+    _H1HJA9ZLO_SIMD_OPERATOR(<<, requires ::std::is_integral_v<T>)
+    _H1HJA9ZLO_SIMD_OPERATOR(>>, requires ::std::is_integral_v<T>)
+
+    _H1HJA9ZLO_SIMD_COMPARISON(==)
+    _H1HJA9ZLO_SIMD_COMPARISON(!=)
+    _H1HJA9ZLO_SIMD_COMPARISON(<)
+    _H1HJA9ZLO_SIMD_COMPARISON(<=)
+    _H1HJA9ZLO_SIMD_COMPARISON(>)
+    _H1HJA9ZLO_SIMD_COMPARISON(>=)
+
+)",
+        R"(#undef _H1HJA9ZLO_SIMD_COMPARISON
+#undef _H1HJA9ZLO_SIMD_OPERATOR
+#undef _H1HJA9ZLO_SIMD_LANES
+
+    /// lane i of `when_true` where lane i of `mask` is set, of `when_false` where it is not
+    friend simd select(const mask_type &mask, const simd &when_true, const simd &when_false) {
+        simd out;
+
+        for (size_t i = 0; i < N; ++i) {
+            out.value[i] = mask[i] != 0 ? when_true.value[i] : when_false.value[i];
+        }
+
+        return out;
+    }
+
+    /// true if any lane of a mask is set
+    friend bool any(const simd &mask) noexcept
+        requires ::std::is_integral_v<T>
+    {
+        return reduce(mask, [](T a, T b) { return T(a | b); }) != 0;
+    }
+
+    /// true if every lane of a mask is set
+    friend bool all(const simd &mask) noexcept
+        requires ::std::is_integral_v<T>
+    {
+        for (size_t i = 0; i < N; ++i) {
+            if (mask.value[i] == 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// the lanes folded with `fn` pairwise, halving each step: (0 + 4) + (2 + 6) + ... for N 8.
+    /// for floating point lanes the order is fixed, the result is the same on every target
+    template <typename Fn>
+    friend T reduce(const simd &values, Fn &&fn) {
+        T lanes[N];
+
+        for (size_t i = 0; i < N; ++i) {
+            lanes[i] = values.value[i];
+        }
+
+        for (size_t width = N / 2; width != 0; width /= 2) {
+            for (size_t i = 0; i < width; ++i) {
+                lanes[i] = fn(lanes[i], lanes[i + width]);
+            }
+        }
+
+        return lanes[0];
+    }
+
+    friend T reduce_add(const simd &values) noexcept {
+        return reduce(values, [](T a, T b) { return T(a + b); });
+    }
+
+    friend T reduce_min(const simd &values) noexcept {
+        return reduce(values, [](T a, T b) { return b < a ? b : a; });
+    }
+
+    friend T reduce_max(const simd &values) noexcept {
+        return reduce(values, [](T a, T b) { return a < b ? b : a; });
+    }
+
+    friend simd min(const simd &lhs, const simd &rhs) noexcept {
+        return select(rhs < lhs, rhs, lhs);
+    }
+
+    friend simd max(const simd &lhs, const simd &rhs) noexcept {
+        return select(lhs < rhs, rhs, lhs);
+    }
+
+    friend simd abs(const simd &values) noexcept {
+        return select(values < simd(), -values, values);
+    }
+
+    friend simd sqrt(const simd &values) noexcept
+        requires ::std::is_floating_point_v<T>
+    {
+        simd out;
+
+        for (size_t i = 0; i < N; ++i) {
+            out.value[i] = ::std::sqrt(values.value[i]);
+        }
+
+        return out;
+    }
+
+  private:
+    template <typename, size_t>
+    friend class simd;
+
+#if defined(_H1HJA9ZLO_VECTOR_EXTENSIONS)
+    // gcc drops the attribute from an alias of a dependent type, a typedef keeps it
+    typedef T native __attribute__((vector_size(N * sizeof(T))));
+#else
+    using native = T[N];
+#endif
+
+    native value;
+
+    /// lanes of an access of `offset` into `size` elements, throws if it starts past the end
+    static size_t chunk(size_t size, size_t offset) {
+        if (offset > size) [[unlikely]] {
+            out_of_range(size, offset);
+        }
+
+        return ::std::min(N, size - offset);
+    }
+
+    /// kept out of `chunk` so a load in a loop inlines down to the bounds check
+    [[noreturn]] static void out_of_range(size_t size, size_t offset) {
+        throw ::std::out_of_range("simd offset " + ::std::to_string(offset) +
+                                  " is out of range for a size of " + ::std::to_string(size));
+    }
+};
+
+class endl {
+  public:
+    endl &operator=(const endl &) = delete;
+    endl &operator=(endl &&)      = delete;
+    endl(const endl &end)         = delete;
+    endl(endl &&)                 = delete;
+    endl()                        = default;
+    ~endl()                       = default;
+
+    explicit endl(::string end)
+        : end_l(::std::move(end)) {}
+    
+    explicit endl(const char *end)
+        : end_l(end) {}
+    
+    explicit endl(const char end)
+        : end_l(::string(1, end)) {}
+    
+    friend ::std::ostream &operator<<(::std::ostream &oss, const endl &end) {
+        oss << end.end_l;
+        return oss;
+    }
+
+    [[nodiscard]] const ::string &get() const { return end_l; }
+
+  private:
+    ::string end_l = "\n";
+};
+}  // namespace helix
+
+template <typename ...Args>
+using map = helix::std::map_type<Args...>;
+template <typename ...Args>
+using set = helix::std::set_type<Args...>;
+template <typename ...Args>
+using ordered_map = std::map<Args...>;
+template <typename ...Args>
+using ordered_set = std::set<Args...>;
+using arena = helix::arena;
+template <typename T, size_t N = helix::std::__internal_interfaces::small_inline_elements<T>>
+using small_vector = helix::std::small_vector<T, N>;
+template <size_t N = 63>
+using small_string = helix::std::small_string<N>;
+
+template <typename T, size_t N>
+using simd = helix::simd<T, N>;
+
+using i8x16  = helix::simd<i8, 16>;
+using u8x16  = helix::simd<u8, 16>;
+using i16x8  = helix::simd<i16, 8>;
+using u16x8  = helix::simd<u16, 8>;
+using i32x4  = helix::simd<i32, 4>;
+using u32x4  = helix::simd<u32, 4>;
+using i32x8  = helix::simd<i32, 8>;
+using u32x8  = helix::simd<u32, 8>;
+using i64x2  = helix::simd<i64, 2>;
+using u64x2  = helix::simd<u64, 2>;
+using i64x4  = helix::simd<i64, 4>;
+using u64x4  = helix::simd<u64, 4>;
+using f32x4  = helix::simd<f32, 4>;
+using f32x8  = helix::simd<f32, 8>;
+using f32x16 = helix::simd<f32, 16>;
+using f64x2  = helix::simd<f64, 2>;
+using f64x4  = helix::simd<f64, 4>;
+using f64x8  = helix::simd<f64, 8>;
+
+template <size_t N>
+struct std::hash<helix::std::small_string<N>> {
+    size_t operator()(const helix::std::small_string<N> &text) const noexcept {
+        return std::hash<std::string_view>()(text);
+    }
+};
+
+/// the arguments are formatted into the thread's output buffer (see output_buffer) and written
+/// with a single write(2) once the buffer policy says so, a trailing helix::endl replaces the
+/// newline. `helix --run` defines _H1HJA9ZLO_NO_THREAD_LOCALS (and with it
+/// _H1HJA9ZLO_UNBUFFERED_OUTPUT), each call is then written as soon as it is formatted
+///
+/// printf and std::cout write through stdio, which is flushed ahead of the buffer, so when
+/// stdout is not a terminal `print("A"); printf("B")` comes out as `BA`. call flush_output
+/// before switching from print to stdio on the same thread
+template <typename... Args>
+inline constexpr void print(Args &&...args) {
+#if defined(_H1HJA9ZLO_UNBUFFERED_OUTPUT)
+    ::string out;
+#else
+    auto    &buffer = helix::std::__internal_interfaces::stdout_buffer();
+    ::string &out   = buffer.get();
+#endif
+
+    [[maybe_unused]] const auto append = [&out](auto &&arg) {
+        if constexpr (::std::is_same_v<::std::remove_cvref_t<decltype(arg)>, helix::endl>) {
+            out += arg.get();
+        } else {
+            helix::std::__internal_interfaces::append_to_string(
+                out, ::std::forward<decltype(arg)>(arg));
+        }
+    };
+
+    (append(::std::forward<Args>(args)), ...);
+
+    if constexpr (sizeof...(Args) == 0) {
+        out += '\n';
+    } else {
+        using Last = ::std::tuple_element_t<sizeof...(Args) - 1, ::std::tuple<Args...>>;
+
+        if constexpr (!::std::is_same_v<::std::remove_cvref_t<Last>, helix::endl>) {
+            out += '\n';
+        }
+    }
+
+#if defined(_H1HJA9ZLO_UNBUFFERED_OUTPUT)
+    helix::std::__internal_interfaces::write_stdout(out);
+#else
+    buffer.commit();
+#endif
+}
+
+#endif  // _H1HJA9ZLO_PRELUDE
+)",
+    };
+
+    static_assert([] {
+        for (std::string_view part : prelude_parts) {
+            if (part.size() >= 16380) {
+                return false;
+            }
+        }
+
+        return true;
+    }(), "a prelude piece is over the msvc string literal limit, split it");
+
+    /// the full prelude text
+    inline const std::string prelude = [] {
+        std::string text;
+
+        for (std::string_view part : prelude_parts) {
+            text += part;
+        }
+
+        return text;
+    }();
+}  // namespace __CXIR_CODEGEN_BEGIN
+
+#endif  // __CXIR_PRELUDE_HH__
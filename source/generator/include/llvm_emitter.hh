@@ -9,10 +9,195 @@
 //  Copyright (c) 2024 (CC BY 4.0)                                                                //
 //                                                                                                //
 //====----------------------------------------------------------------------------------------====//
+///                                                                                              ///
+///  @file llvm_emitter.hh                                                                       ///
+///  @brief Lowers the helix ast straight to llvm ir, without going through cx-ir and c++.       ///
+///                                                                                              ///
+///  Only a subset of the language is lowered: free functions, structs with data members,       ///
+///     primitive integers, floats and bool, calls, let, if/unless, while, c style for and       ///
+///     `for i in a..b`. The first node outside that subset stops the lowering, `lower` returns  ///
+///     false and the caller compiles the program through cx-ir instead, so a program is never   ///
+///     rejected just because this backend does not know it.                                    ///
+///                                                                                              ///
+///  Values follow the c++ the cx-ir emitter would produce: the usual arithmetic conversions,   ///
+///     integer literals are i32 unless they do not fit, float literals are f64.                 ///
+///                                                                                              ///
+///===---------------------------------------------------------------------------------------====///
 
 #ifndef __LLVM_EMITTER_HH__
 #define __LLVM_EMITTER_HH__
 
-namespace codegen::llvm {}
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Target/TargetMachine.h>
 
-#endif  // __LLVM_EMITTER_HH__
\ No newline at end of file
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/types/AST_visitor.hh"
+
+__LLVM_CODEGEN_BEGIN {
+    struct StructLayout;
+
+    /// an llvm type and the helix type it came from, llvm integers carry no signedness
+    struct HelixType {
+        ::llvm::Type       *type      = nullptr;
+        bool                is_signed = false;
+        const StructLayout *layout    = nullptr;  ///< set for structs
+
+        [[nodiscard]] bool is_integer() const { return type != nullptr && type->isIntegerTy(); }
+        [[nodiscard]] bool is_float() const { return type != nullptr && type->isFloatingPointTy(); }
+        [[nodiscard]] bool is_bool() const { return type != nullptr && type->isIntegerTy(1); }
+    };
+
+    struct StructLayout {
+        ::llvm::StructType      *type = nullptr;
+        std::vector<std::string> fields;
+        std::vector<HelixType>   field_types;
+
+        /// index of `name` in the struct, nullopt if there is no such field
+        [[nodiscard]] std::optional<unsigned> field(const std::string &name) const {
+            for (unsigned i = 0; i < fields.size(); ++i) {
+                if (fields[i] == name) {
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+    };
+
+    class LLVMEmitter : public __AST_VISITOR::Visitor {
+      public:
+        explicit LLVMEmitter(const std::string &module_name);
+        LLVMEmitter(const LLVMEmitter &)            = delete;
+        LLVMEmitter(LLVMEmitter &&)                 = delete;
+        LLVMEmitter &operator=(const LLVMEmitter &) = delete;
+        LLVMEmitter &operator=(LLVMEmitter &&)      = delete;
+        ~LLVMEmitter() override                     = default;
+
+        /// lower the whole program for the host target, false if any part of it is outside the
+        /// supported subset (see get_unsupported_reason), the module is unusable in that case
+        bool lower(const __AST_NODE::Program &program);
+
+        /// what stopped the lowering, empty if it succeeded
+        [[nodiscard]] const std::string &get_unsupported_reason() const { return reason; }
+
+        /// run the standard per-module pipeline for `level`, O0 only runs the always-inliner
+        void optimize(::llvm::OptimizationLevel level);
+
+        /// write a native object file for the host, false with `error` set if it fails
+        bool emit_object(const std::string &path, std::string &error);
+
+        /// the module as textual ir, used by --emit-llvm
+        [[nodiscard]] std::string to_string() const;
+
+        /// hand the module and its context to the jit, nothing else may be called afterwards
+        ::llvm::orc::ThreadSafeModule take_module();
+
+        GENERATE_VISIT_EXTENDS;
+
+      private:
+        struct TypedValue {
+            ::llvm::Value *value = nullptr;
+            HelixType      type;
+        };
+
+        struct Local {
+            ::llvm::Value *slot = nullptr;  ///< an alloca, or a field of one
+            HelixType      type;
+        };
+
+        struct FunctionInfo {
+            ::llvm::Function                                *function = nullptr;
+            HelixType                                        returns;
+            std::vector<HelixType>                           params;
+            std::vector<__AST_N::NodeT<__AST_NODE::VarDecl>> decls;  ///< for default arguments
+            bool returns_void = true;
+        };
+
+        struct Loop {
+            ::llvm::BasicBlock *continue_to = nullptr;
+            ::llvm::BasicBlock *break_to    = nullptr;
+        };
+
+        // declared in this order so the builder and the module outlive nothing they point into
+        std::unique_ptr<::llvm::LLVMContext>   context;
+        std::unique_ptr<::llvm::Module>        module;
+        std::unique_ptr<::llvm::TargetMachine> target;
+        ::llvm::IRBuilder<>                    builder;
+
+        std::unordered_map<std::string, StructLayout>         structs;
+        std::unordered_map<std::string, FunctionInfo>         functions;
+        std::vector<std::unordered_map<std::string, Local>>   scopes;
+        std::vector<Loop>                                     loops;
+        FunctionInfo                                         *current = nullptr;
+        TypedValue                                            result;  ///< of the last expression
+        std::string                                           reason;
+
+        [[nodiscard]] bool ok() const { return reason.empty(); }
+
+        /// stop lowering, only the first reason is kept
+        void unsupported(const std::string &what);
+
+        /// create the target machine and give the module its triple and data layout
+        bool prepare_target();
+
+        void declare_struct(const __AST_NODE::StructDecl &node);
+        void declare_function(const __AST_NODE::FuncDecl &node);
+
+        std::optional<HelixType> lower_type(const __AST_N::NodeT<__AST_NODE::Type> &type);
+        std::optional<HelixType> primitive(const std::string &name);
+
+        /// the value of `node`, `value` is null if lowering stopped
+        TypedValue lower_expr(const __AST_N::NodeT<> &node);
+
+        /// the address of an assignable expression (a local or a field of one)
+        std::optional<Local> lower_address(const __AST_N::NodeT<> &node);
+
+        /// true if lower_address would find an address for `node`
+        bool addressable(const __AST_N::NodeT<> &node);
+
+        void lower_condition_branch(const __AST_N::NodeT<> &condition,
+                                    bool                    negate,
+                                    ::llvm::BasicBlock     *if_true,
+                                    ::llvm::BasicBlock     *if_false);
+        void lower_var(const __AST_NODE::VarDecl &node);
+        void lower_assignment(const __AST_NODE::BinaryExpr &node);
+        void lower_logical(const __AST_NODE::BinaryExpr &node);
+        void lower_c_for(const __AST_NODE::ForCStatementCore &node);
+        void lower_counted_for(const __AST_NODE::ForPyStatementCore &node);
+
+        /// `value` converted the way c++ converts on assignment, nullopt for unrelated types
+        std::optional<TypedValue> convert(TypedValue value, const HelixType &to);
+
+        /// the common type of a binary arithmetic operation (usual arithmetic conversions)
+        std::optional<HelixType> common_type(const HelixType &lhs, const HelixType &rhs);
+
+        ::llvm::Value *to_bool(const TypedValue &value);
+        TypedValue     arithmetic(const __TOKEN_N::Token &op, TypedValue lhs, TypedValue rhs);
+
+        /// allocas go in the entry block so mem2reg can promote them
+        ::llvm::AllocaInst *entry_alloca(const HelixType &type, const std::string &name);
+
+        ::llvm::BasicBlock *new_block(const char *name);
+
+        /// branch unless the block already ended in a return, break or continue
+        void branch_to(::llvm::BasicBlock *block);
+
+        /// continue in a fresh block after a return, break or continue, it is never reached
+        void start_dead_block();
+
+        Local *find_local(const std::string &name);
+    };
+}  // namespace __LLVM_CODEGEN_BEGIN
+
+#endif  // __LLVM_EMITTER_HH__
@@ -10,10 +10,14 @@
 //                                                                                                //
 //====----------------------------------------------------------------------------------------====//
 
+#include <cctype>
 #include <cstdio>
 #include <ctime>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "generator/include/CX-IR/CXIR.hh"
 #include "neo-panic/include/error.hh"
@@ -28,11 +32,9 @@
 #include "token/include/private/Token_generate.hh"
 
 #define CXIR_NOT_IMPLEMENTED throw std::runtime_error(GET_DEBUG_INFO + "Not implemented yet")
-#define ADD_TOKEN(token) tokens.push_back(std::make_unique<CX_Token>(cxir_tokens::token))
-#define ADD_TOKEN_AS_VALUE(token, value) \
-    tokens.push_back(std::make_unique<CX_Token>(cxir_tokens::token, value))
-#define ADD_TOKEN_AS_TOKEN(token, token_value) \
-    tokens.push_back(std::make_unique<CX_Token>(token_value, cxir_tokens::token))
+#define ADD_TOKEN(token) tokens.push(cxir_tokens::token)
+#define ADD_TOKEN_AS_VALUE(token, value) tokens.push_value(cxir_tokens::token, value)
+#define ADD_TOKEN_AS_TOKEN(token, token_value) tokens.push_token(cxir_tokens::token, token_value)
 
 #define ADD_NODE_PARAM(param) ADD_PARAM(node.param)
 #define ADD_PARAM(param) param->accept(*this)
@@ -77,16 +79,63 @@
 #define BRACKET_DELIMIT(...) DELIMIT(CXX_LBRACKET, CXX_RBRACKET, __VA_ARGS__)
 #define ANGLE_DELIMIT(...) DELIMIT(CXX_LESS, CXX_GREATER, __VA_ARGS__)
 
+// `helix::std::name`, something the prelude defines for the generated code
+#define ADD_HELIX_STD(name)                           \
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "helix"); \
+    ADD_TOKEN(CXX_SCOPE_RESOLUTION);                  \
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "std");   \
+    ADD_TOKEN(CXX_SCOPE_RESOLUTION);                  \
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, name)
+
+namespace {
+/// split the string literal of an f-string at its `\\{\\}` placeholders (written by the parser
+/// in place of each `{expr}`), every piece is a string literal of its own
+std::vector<std::string> format_segments(std::string_view literal) {
+    constexpr std::string_view placeholder = R"(\\{\\})";
+
+    std::vector<std::string> segments;
+    std::string              current;
+
+    for (size_t i = 0; i < literal.size(); ++i) {
+        if (literal.substr(i, placeholder.size()) == placeholder) {
+            segments.push_back(current + '"');
+            current = '"';
+            i += placeholder.size() - 1;
+            continue;
+        }
+
+        // an escape is copied as a whole, so `\\\\{` is not mistaken for the start of a
+        // placeholder
+        if (literal[i] == '\\' && i + 1 < literal.size()) {
+            current += literal[i++];
+        }
+
+        current += literal[i];
+    }
+
+    segments.push_back(std::move(current));
+    return segments;
+}
+}  // namespace
+
 CX_VISIT_IMPL(LiteralExpr) {
     if (node.contains_format_args) {
-        // helix::std::format_string(node.value, (format_arg)...)
-        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "helix");
-        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
-        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "std");
-        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
-        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "format_string");
+        // helix::std::format_string({"segment", ...}, (format_arg)...), the literal is split
+        // here so the runtime only appends and never searches the string
+        ADD_HELIX_STD("format_string");
         ADD_TOKEN(CXX_LPAREN);
-        ADD_TOKEN_AS_TOKEN(CXX_CORE_LITERAL, node.value);
+        ADD_TOKEN(CXX_LBRACE);
+
+        for (const auto &text : format_segments(node.value.value())) {
+            __TOKEN_N::Token segment = node.value;  // keeps the location for `#line`
+            segment.set_value(text);
+
+            ADD_TOKEN_AS_TOKEN(CXX_CORE_LITERAL, segment);
+            ADD_TOKEN(CXX_COMMA);
+        }
+
+        tokens.pop_back();  // remove trailing comma, there is always at least one segment
+        ADD_TOKEN(CXX_RBRACE);
         ADD_TOKEN(CXX_COMMA);
 
         for (auto &format_spec : node.format_args) {
@@ -94,9 +143,7 @@ CX_VISIT_IMPL(LiteralExpr) {
             ADD_TOKEN(CXX_COMMA);
         }
 
-        if (node.format_args.size() > 0) {
-            tokens.pop_back();  // remove trailing comma
-        }
+        tokens.pop_back();  // remove trailing comma
 
         ADD_TOKEN(CXX_RPAREN);
 
@@ -217,6 +264,15 @@ CX_VISIT_IMPL(IdentExpr) {
         return;
     }
 
+    // while emitting an explicit instantiation template params are replaced by their arguments
+    if (!generic_substitutions.empty()) {
+        if (auto sub = generic_substitutions.find(std::string(node.name.value()));
+            sub != generic_substitutions.end()) {
+            ADD_PARAM(sub->second);
+            return;
+        }
+    }
+
     ADD_TOKEN_AS_TOKEN(CXX_CORE_IDENTIFIER, node.name);
 }
 
@@ -305,12 +361,27 @@ CX_VISIT_IMPL(TupleLiteralExpr) {
 
     BRACE_DELIMIT(COMMA_SEP(values););
 }
-/// TODO: is this even imlpementad in the current stage?
-CX_VISIT_IMPL(SetLiteralExpr) { BRACE_DELIMIT(COMMA_SEP(values);); }
+CX_VISIT_IMPL(SetLiteralExpr) {
+    // helix::std::set_literal(value, ...), a hash set reserved for every element up front
+    ADD_HELIX_STD("set_literal");
+    PAREN_DELIMIT(COMMA_SEP(values););
+}
 
-CX_VISIT_IMPL(MapPairExpr) { CXIR_NOT_IMPLEMENTED; }
+CX_VISIT_IMPL(MapPairExpr) {
+    // helix::std::map_entry(key, value)
+    ADD_HELIX_STD("map_entry");
+    PAREN_DELIMIT(                                   //
+        ADD_NODE_PARAM(key);                         //
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, ",");  //
+        ADD_NODE_PARAM(value);                       //
+    );
+}
 
-CX_VISIT_IMPL(MapLiteralExpr) { CXIR_NOT_IMPLEMENTED; }
+CX_VISIT_IMPL(MapLiteralExpr) {
+    // helix::std::map_literal(map_entry(key, value), ...), a hash map reserved for every entry
+    ADD_HELIX_STD("map_literal");
+    PAREN_DELIMIT(COMMA_SEP(values););
+}
 
 CX_VISIT_IMPL(ObjInitExpr) {
 
@@ -391,14 +462,69 @@ CX_VISIT_IMPL(InstOfExpr) {
 }
 
 CX_VISIT_IMPL(AsyncThreading) {
-
+    // the runtime is helix::future and the work-stealing pool in the prelude
     switch (node.type) {
         case parser::ast::node::AsyncThreading::AsyncThreadingType::Await:
-            ADD_TOKEN(CXX_CO_AWAIT);
-            ADD_NODE_PARAM(value);
+            if (in_async) {  // -> 'co_await' value, the function suspends instead of blocking
+                ADD_TOKEN(CXX_CO_AWAIT);
+                ADD_NODE_PARAM(value);
+            } else {  // -> 'helix::std::block_on' '(' value ')'
+                ADD_HELIX_STD("block_on");
+                PAREN_DELIMIT(ADD_NODE_PARAM(value););
+            }
+
             break;
-        case parser::ast::node::AsyncThreading::AsyncThreadingType::Spawn:
         case parser::ast::node::AsyncThreading::AsyncThreadingType::Thread:
+            // -> 'helix::std::run_async' '(' '[' '=' ']' '(' ')' 'mutable' '{' 'return' value ';'
+            // '}' ')', the arguments are evaluated on the task, captured by value
+            ADD_HELIX_STD("run_async");
+            PAREN_DELIMIT(                                  //
+                BRACKET_DELIMIT(ADD_TOKEN(CXX_ASSIGN););    //
+                PAREN_DELIMIT();                            //
+                ADD_TOKEN(CXX_MUTABLE);                     //
+                BRACE_DELIMIT(                              //
+                    ADD_TOKEN(CXX_RETURN);                  //
+                    ADD_NODE_PARAM(value);                  //
+                    ADD_TOKEN(CXX_SEMICOLON);               //
+                );                                          //
+            );
+            break;
+        case parser::ast::node::AsyncThreading::AsyncThreadingType::Spawn: {
+            // -> 'helix::std::run_spawned' '(' '[' ']' '(' 'auto' '...' args ')' '{' 'return'
+            // path generic? '(' args '...' ')' ';' '}' (',' arg)* ')'
+            // the call runs in a worker process, only the arguments are sent to it
+            if (node.value->getNodeType() != parser::ast::node::nodes::FunctionCallExpr) {
+                throw std::runtime_error(GET_DEBUG_INFO + "spawn needs a function call");
+            }
+
+            const auto call = __AST_NODE::Node::as<__AST_NODE::FunctionCallExpr>(node.value);
+
+            ADD_HELIX_STD("run_spawned");
+            PAREN_DELIMIT(                                                           //
+                BRACKET_DELIMIT();                                                   //
+                PAREN_DELIMIT(                                                       //
+                    ADD_TOKEN(CXX_AUTO);                                             //
+                    ADD_TOKEN(CXX_ELLIPSIS);                                         //
+                    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_args");      //
+                );                                                                   //
+                BRACE_DELIMIT(                                                       //
+                    ADD_TOKEN(CXX_RETURN);                                           //
+                    ADD_PARAM(call->path);                                           //
+                    if (call->generic) { ADD_PARAM(call->generic); }                 //
+                    PAREN_DELIMIT(                                                   //
+                        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_args");  //
+                        ADD_TOKEN(CXX_ELLIPSIS);                                     //
+                    );                                                               //
+                    ADD_TOKEN(CXX_SEMICOLON);                                        //
+                );                                                                   //
+                                                                                     //
+                for (const auto &arg : call->args->args) {                           //
+                    ADD_TOKEN(CXX_COMMA);                                            //
+                    ADD_PARAM(arg);                                                  //
+                }                                                                    //
+            );
+            break;
+        }
         case parser::ast::node::AsyncThreading::AsyncThreadingType::Other:
             CXIR_NOT_IMPLEMENTED;
     }
@@ -426,9 +552,222 @@ CX_VISIT_IMPL(NamedVarSpecifier) {
 
 CX_VISIT_IMPL(NamedVarSpecifierList) { COMMA_SEP(vars); }
 
+namespace {
+/// the parts of `a..b`, `a..=b` or `(a..b).step_by(s)` in a for loop, see emit_counted_for
+struct CountedRange {
+    parser::ast::NodeT<> start;
+    parser::ast::NodeT<> end;
+    parser::ast::NodeT<> step;
+    bool                 inclusive = false;
+};
+
+std::optional<CountedRange> as_counted_range(parser::ast::NodeT<> range) {
+    using namespace parser::ast;
+
+    CountedRange counted;
+
+    // (a..b).step_by(s) is parsed as DotPathExpr(ParenthesizedExpr(a..b), FunctionCallExpr)
+    if (range->getNodeType() == node::nodes::DotPathExpr) {
+        const auto dot = node::Node::as<node::DotPathExpr>(range);
+
+        if (dot->rhs == nullptr || dot->rhs->getNodeType() != node::nodes::FunctionCallExpr) {
+            return std::nullopt;
+        }
+
+        const auto call = node::Node::as<node::FunctionCallExpr>(dot->rhs);
+
+        if (call->path->type != node::PathExpr::PathType::Identifier ||
+            call->path->get_back_name().value() != "step_by" || call->generic != nullptr ||
+            call->args->args.size() != 1 ||
+            call->args->args[0]->getNodeType() != node::nodes::ArgumentExpr) {
+            return std::nullopt;
+        }
+
+        counted.step = node::Node::as<node::ArgumentExpr>(call->args->args[0])->value;
+        range        = dot->lhs;
+    }
+
+    while (range->getNodeType() == node::nodes::ParenthesizedExpr) {
+        range = node::Node::as<node::ParenthesizedExpr>(range)->value;
+    }
+
+    if (range->getNodeType() != node::nodes::BinaryExpr) {
+        return std::nullopt;
+    }
+
+    const auto bounds = node::Node::as<node::BinaryExpr>(range);
+
+    switch (bounds->op.token_kind()) {
+        case __TOKEN_N::OPERATOR_RANGE:
+            break;
+        case __TOKEN_N::OPERATOR_RANGE_INCLUSIVE:
+            counted.inclusive = true;
+            break;
+        default:
+            return std::nullopt;
+    }
+
+    counted.start = bounds->lhs;
+    counted.end   = bounds->rhs;
+
+    return counted;
+}
+
+/// a step_by that is a literal (or a negated one) no bigger than 0, such a loop never ends
+bool non_positive_step(parser::ast::NodeT<> step) {
+    using namespace parser::ast;
+
+    bool negated = false;
+
+    while (step->getNodeType() == node::nodes::ParenthesizedExpr) {
+        step = node::Node::as<node::ParenthesizedExpr>(step)->value;
+    }
+
+    if (step->getNodeType() == node::nodes::UnaryExpr &&
+        node::Node::as<node::UnaryExpr>(step)->op.token_kind() == __TOKEN_N::OPERATOR_SUB) {
+        negated = true;
+        step    = node::Node::as<node::UnaryExpr>(step)->opd;
+    }
+
+    if (step->getNodeType() != node::nodes::LiteralExpr) {
+        return false;
+    }
+
+    const auto literal = node::Node::as<node::LiteralExpr>(step);
+
+    if (literal->type != node::LiteralExpr::LiteralType::Integer &&
+        literal->type != node::LiteralExpr::LiteralType::Float) {
+        return false;
+    }
+
+    std::string digits = literal->value.value();
+    std::erase(digits, '_');
+
+    if (digits.size() > 2 && digits[0] == '0' && std::isalpha(digits[1]) != 0) {
+        digits.erase(0, 2);  // 0x, 0b, 0o
+    }
+
+    return negated || digits.find_first_not_of("0.") == std::string::npos;
+}
+}  // namespace
+
+bool __CXIR_CODEGEN_N::CXIR::emit_counted_for(const __AST_NODE::ForPyStatementCore &node) {
+    // -> '(' T i '=' a ',' end '=' b ';' i '<' end ';' '++' i ')' body
+    // -> '(' T i '=' a ',' end '=' b (',' step '=' s)? ',' more '=' 'helix::std::range_first'
+    //        '<' inclusive '>' '(' i ',' end (',' step)? ')' ';' more ';'
+    //        more '=' 'helix::std::range_next' '<' inclusive '>' '(' i ',' end (',' step)? ')'
+    //    ')' body
+    // where T is the declared type or std::common_type_t<decltype(a), decltype(b)>, so the c++
+    // optimizer sees a canonical induction variable instead of an iterator object. `a..=b` and
+    // a step only move `i` on while the next value is still in the range, `i <= end` or
+    // `i += step` would overflow at the maximum of T
+    if (node.vars == nullptr || node.vars->vars.size() != 1) {
+        return false;
+    }
+
+    const auto range = as_counted_range(node.range);
+
+    if (!range.has_value()) {
+        return false;
+    }
+
+    if (range->step != nullptr && non_positive_step(range->step)) {
+        throw std::runtime_error(GET_DEBUG_INFO + "step_by needs a step greater than 0");
+    }
+
+    const auto &var    = node.vars->vars[0];
+    const bool  simple = !range->inclusive && range->step == nullptr;
+
+    // `range_first` / `range_next` '<' inclusive '>' '(' i ',' end (',' step)? ')'
+    const auto add_range_call = [&](const char *name) {
+        ADD_HELIX_STD(name);
+        ANGLE_DELIMIT(  //
+            ADD_TOKEN_AS_VALUE(CXX_CORE_LITERAL, range->inclusive ? "true" : "false"););
+        PAREN_DELIMIT(                                                           //
+            ADD_PARAM(var->path);                                                //
+            ADD_TOKEN(CXX_COMMA);                                                //
+            ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_end");     //
+                                                                                 //
+            if (range->step != nullptr) {                                        //
+                ADD_TOKEN(CXX_COMMA);                                            //
+                ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_step");  //
+            }                                                                    //
+        );
+    };
+
+    ADD_TOKEN(CXX_LPAREN);
+
+    if (var->type != nullptr) {
+        ADD_PARAM(var->type);
+    } else {
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "std");
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "common_type_t");
+        ANGLE_DELIMIT(                                          //
+            ADD_TOKEN(CXX_DECLTYPE);                            //
+            PAREN_DELIMIT(ADD_PARAM(range->start););            //
+            ADD_TOKEN(CXX_COMMA);                               //
+            ADD_TOKEN(CXX_DECLTYPE);                            //
+            PAREN_DELIMIT(ADD_PARAM(range->end););              //
+        );
+    }
+
+    ADD_PARAM(var->path);
+    ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+    ADD_PARAM(range->start);
+
+    // the bounds are evaluated once, like the range object they replace
+    ADD_TOKEN(CXX_COMMA);
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_end");
+    ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+    ADD_PARAM(range->end);
+
+    if (range->step != nullptr) {
+        ADD_TOKEN(CXX_COMMA);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_step");
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+        ADD_PARAM(range->step);
+    }
+
+    if (!simple) {
+        ADD_TOKEN(CXX_COMMA);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_more");
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+        add_range_call("range_first");
+    }
+
+    ADD_TOKEN(CXX_SEMICOLON);
+
+    if (simple) {
+        ADD_PARAM(var->path);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "<");
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_end");
+        ADD_TOKEN(CXX_SEMICOLON);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "++");
+        ADD_PARAM(var->path);
+    } else {
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_more");
+        ADD_TOKEN(CXX_SEMICOLON);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_range_more");
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+        add_range_call("range_next");
+    }
+
+    ADD_TOKEN(CXX_RPAREN);
+
+    ADD_NODE_PARAM(body);
+
+    return true;
+}
+
 CX_VISIT_IMPL(ForPyStatementCore) {
     // := NamedVarSpecifier 'in 'expr' Suite
 
+    if (emit_counted_for(node)) {
+        return;
+    }
+
     ADD_TOKEN(CXX_LPAREN);
 
     ADD_NODE_PARAM(vars);
@@ -453,23 +792,107 @@ CX_VISIT_IMPL(ForCStatementCore) {
     ADD_NODE_PARAM(body);
 }
 
+void __CXIR_CODEGEN_N::CXIR::emit_parallel_for(const __AST_NODE::ForState &node) {
+    // -> ('helix::std::par_for' | 'helix::std::par_for_to') '(' a ',' b ',' '[' '&' ']' '(' var
+    //        ')' body ')'
+    // -> 'helix::std::par_each' '(' range ',' '[' '&' ']' '(' var ')' body ')'
+    // the body is a lambda run by the task pool, `continue` returns from it. the lambda is not
+    // a coroutine, `await` in it blocks and `yield` has nothing to suspend
+    if (node.type != __AST_NODE::ForState::ForType::Python) {
+        throw std::runtime_error(GET_DEBUG_INFO + "a parallel for needs a `for x in ...` loop");
+    }
+
+    const auto core = __AST_NODE::Node::as<__AST_NODE::ForPyStatementCore>(node.core);
+
+    if (core->vars == nullptr || core->vars->vars.size() != 1) {
+        throw std::runtime_error(GET_DEBUG_INFO + "a parallel for has exactly one loop variable");
+    }
+
+    const auto range = as_counted_range(core->range);
+
+    if (range.has_value() && range->step != nullptr) {
+        throw std::runtime_error(GET_DEBUG_INFO + "a parallel for can not step over its range");
+    }
+
+    const bool was_parallel_for  = in_parallel_for;
+    const bool was_loop_parallel = loop_is_parallel;
+    const bool was_switch_break  = break_leaves_switch;
+    const bool was_leaving       = loop_leaves_finally;
+    const bool was_async         = in_async;
+    in_parallel_for              = true;
+    loop_is_parallel             = true;
+    break_leaves_switch          = false;
+    loop_leaves_finally          = false;  // continue returns from the lambda, still inside
+    in_async                     = false;  // await is helix::std::block_on
+
+    // `a..=b` is par_for_to, `b + 1` would overflow when b is the maximum of its type
+    ADD_HELIX_STD(!range.has_value() ? "par_each" : range->inclusive ? "par_for_to" : "par_for");
+    PAREN_DELIMIT(                                                   //
+        if (range.has_value()) {                                     //
+            ADD_PARAM(range->start);                                 //
+            ADD_TOKEN(CXX_COMMA);                                    //
+            ADD_PARAM(range->end);                                   //
+        } else {                                                     //
+            ADD_PARAM(core->range);                                  //
+        }                                                            //
+                                                                     //
+        ADD_TOKEN(CXX_COMMA);                                        //
+        BRACKET_DELIMIT(ADD_TOKEN(CXX_AMPERSAND););                  //
+        PAREN_DELIMIT(ADD_PARAM(core->vars->vars[0]););              //
+        ADD_PARAM(core->body);                                       //
+    );
+
+    in_parallel_for     = was_parallel_for;
+    loop_is_parallel    = was_loop_parallel;
+    break_leaves_switch = was_switch_break;
+    loop_leaves_finally = was_leaving;
+    in_async            = was_async;
+}
+
 CX_VISIT_IMPL(ForState) {
     // := 'for' (ForPyStatementCore | ForCStatementCore)
 
+    if (node.parallel) {
+        emit_parallel_for(node);
+        return;
+    }
+
+    const bool was_loop_parallel = loop_is_parallel;
+    const bool was_switch_break  = break_leaves_switch;
+    const bool was_leaving       = loop_leaves_finally;
+    loop_is_parallel             = false;  // break and continue in here are for this loop
+    break_leaves_switch          = false;
+    loop_leaves_finally          = false;
+
     ADD_TOKEN(CXX_FOR);
 
     ADD_NODE_PARAM(core);
+
+    loop_is_parallel    = was_loop_parallel;
+    break_leaves_switch = was_switch_break;
+    loop_leaves_finally = was_leaving;
 }
 
 CX_VISIT_IMPL(WhileState) {
     // := 'while' expr Suite
 
+    const bool was_loop_parallel = loop_is_parallel;
+    const bool was_switch_break  = break_leaves_switch;
+    const bool was_leaving       = loop_leaves_finally;
+    loop_is_parallel             = false;
+    break_leaves_switch          = false;
+    loop_leaves_finally          = false;
+
     ADD_TOKEN(CXX_WHILE);
 
     PAREN_DELIMIT(                  //
         ADD_NODE_PARAM(condition);  //
     );
     ADD_NODE_PARAM(body);
+
+    loop_is_parallel    = was_loop_parallel;
+    break_leaves_switch = was_switch_break;
+    loop_leaves_finally = was_leaving;
 }
 
 CX_VISIT_IMPL(ElseState) {
@@ -544,6 +967,9 @@ CX_VISIT_IMPL(SwitchCaseState) {
 }
 
 CX_VISIT_IMPL(SwitchState) {
+    const bool was_switch_break = break_leaves_switch;
+    break_leaves_switch         = true;
+
     ADD_TOKEN(CXX_SWITCH);
 
     PAREN_DELIMIT(                  //
@@ -553,9 +979,19 @@ CX_VISIT_IMPL(SwitchState) {
     BRACE_DELIMIT(                   //
         ADD_ALL_NODE_PARAMS(cases);  //
     );
+
+    break_leaves_switch = was_switch_break;
 }
 
 CX_VISIT_IMPL(YieldState) {
+    if (in_parallel_for) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not yield from inside a parallel for");
+    }
+
+    if (in_finally) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not yield from inside a finally");
+    }
+
     ADD_TOKEN(CXX_CO_YIELD);
     ADD_NODE_PARAM(value);
     ADD_TOKEN(CXX_SEMICOLON);
@@ -576,12 +1012,43 @@ CX_VISIT_IMPL(MultiImportState) { CXIR_NOT_IMPLEMENTED; }
 CX_VISIT_IMPL(ImportState) { CXIR_NOT_IMPLEMENTED; }
 
 CX_VISIT_IMPL(ReturnState) {
-    ADD_TOKEN(CXX_RETURN);  // TODO co_return for generator contexts?
-    ADD_NODE_PARAM(value);
+    if (in_parallel_for) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not return from inside a parallel for");
+    }
+
+    if (in_finally) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not return from inside a finally");
+    }
+
+    if (in_generator && node.value != nullptr) {  // a generator only produces values with yield
+        throw std::runtime_error(GET_DEBUG_INFO +
+                                 "a generator can not return a value, yield it instead");
+    }
+
+    // -> ('co_return' | 'return') value? ';', a bare return ends a generator or a void function.
+    // the value of an async function goes to the future
+    if (in_async || in_generator) {
+        ADD_TOKEN(CXX_CO_RETURN);
+    } else {
+        ADD_TOKEN(CXX_RETURN);
+    }
+
+    if (node.value != nullptr) {
+        ADD_NODE_PARAM(value);
+    }
+
     ADD_TOKEN(CXX_SEMICOLON);
 }
 
 CX_VISIT_IMPL(BreakState) {
+    if (loop_is_parallel && !break_leaves_switch) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not break out of a parallel for");
+    }
+
+    if (loop_leaves_finally && !break_leaves_switch) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not break out of a finally");
+    }
+
     ADD_TOKEN(CXX_BREAK);
     ADD_TOKEN(CXX_SEMICOLON);
 }
@@ -598,39 +1065,118 @@ CX_VISIT_IMPL(SuiteState) {
         if (node.body) { ADD_NODE_PARAM(body); }  //
     );
 }
-CX_VISIT_IMPL(ContinueState) { ADD_TOKEN(CXX_CONTINUE); }
+CX_VISIT_IMPL(ContinueState) {
+    if (loop_leaves_finally) {
+        throw std::runtime_error(GET_DEBUG_INFO + "can not continue out of a finally");
+    }
+
+    if (loop_is_parallel) {  // the body of a parallel for is a lambda, its iteration ends here
+        ADD_TOKEN(CXX_RETURN);
+        return;
+    }
+
+    ADD_TOKEN(CXX_CONTINUE);
+}
 
 CX_VISIT_IMPL(CatchState) {
+    // -> 'catch' '(' (type name | '...') ')' body
     ADD_TOKEN(CXX_CATCH);
-    PAREN_DELIMIT(                    //
-        ADD_NODE_PARAM(catch_state);  //
-    );                                //
+    PAREN_DELIMIT(                                                           //
+        if (node.catch_state) { ADD_NODE_PARAM(catch_state); } else {        //
+            ADD_TOKEN(CXX_ELLIPSIS);                                         //
+        }                                                                    //
+    );
     ADD_NODE_PARAM(body);
 }
 
 CX_VISIT_IMPL(FinallyState) {
-    // TODO: this needs to be placed before return, so, the code gen needs to be statefull here...
-    // for now it will just put the
-    // https://stackoverflow.com/questions/33050620/golang-style-defer-in-c
-    // for try catch this would have to be placed before the try block
-    // shared_ptr<void>_(nullptr, [] { cout << ", World!"; });
-    // ADD_TOKEN_AS_TOKEN(CXX_CORE_IDENTIFIER, "shared_ptr");
-    // ANGLE_DELIMIT(ADD_TOKEN(CXX_VOID););
-    CXIR_NOT_IMPLEMENTED;
+    // -> 'helix::std::finally' guard '(' '[&]' '(' ')' body ')' ';'
+    // the guard is a stack object whose destructor runs the body, so it runs on every way out of
+    // the enclosing block: falling off the end, return, break, continue and exceptions. see
+    // helix::std::finally in the prelude, there is no allocation or type erasure involved.
+    //
+    // the body itself runs in that destructor, it can not leave early: a return, break or
+    // continue out of it has nowhere to go and a panic would terminate the program. it is not
+    // a coroutine either, `await` blocks there and `yield` is an error
+    const bool was_finally      = in_finally;
+    const bool was_leaving      = loop_leaves_finally;
+    const bool was_switch_break = break_leaves_switch;
+    const bool was_async        = in_async;
+    in_finally                  = true;
+    loop_leaves_finally         = true;
+    break_leaves_switch         = false;
+    in_async                    = false;
+
+    ADD_HELIX_STD("finally");
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_finally");
+
+    PAREN_DELIMIT(                                             //
+        BRACKET_DELIMIT(ADD_TOKEN(CXX_AMPERSAND););            //
+        PAREN_DELIMIT();                                       //
+        ADD_NODE_PARAM(body);                                  //
+    );
+
+    ADD_TOKEN(CXX_SEMICOLON);
+
+    in_finally          = was_finally;
+    loop_leaves_finally = was_leaving;
+    break_leaves_switch = was_switch_break;
+    in_async            = was_async;
 }
 
 CX_VISIT_IMPL(TryState) {
+    // -> '{' finally? ('try' body catch+ | body) '}'
+    // the extra block scopes the finally guard to the try statement, it is declared before the
+    // try so it is destroyed after the try and every catch clause have finished
+    BRACE_DELIMIT(                                    //
+        if (node.finally_state) {                     //
+            ADD_NODE_PARAM(finally_state);            //
+        }                                             //
+                                                      //
+        if (node.catch_states.empty()) {              //
+            ADD_NODE_PARAM(body);                     // try without catch only needs the guard
+        } else {                                      //
+            ADD_TOKEN(CXX_TRY);                       //
+            ADD_NODE_PARAM(body);                     //
+            ADD_ALL_PARAMS(node.catch_states);        //
+        }                                             //
+    );
+}
 
-    // Is this nullable?
-    if (node.finally_state) {           //
-        ADD_NODE_PARAM(finally_state);  //
-    }
+CX_VISIT_IMPL(WithState) {
+    // -> '{' 'auto' '&&' name '=' value ';' 'helix::std::context' guard '(' name ')' ';' body '}'
+    // the guard calls enter() on the value now and exit() when the block is left by any path, a
+    // helix::arena used this way is the region of the body. without 'as' the name is internal
+    const auto emit_name = [&]() {
+        if (node.name) {
+            ADD_NODE_PARAM(name);
+        } else {
+            ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_with_value");
+        }
+    };
 
-    ADD_TOKEN(CXX_TRY);
-    ADD_NODE_PARAM(body);
+    BRACE_DELIMIT(                                                          //
+        ADD_TOKEN(CXX_AUTO);                                                //
+        ADD_TOKEN(CXX_LOGICAL_AND);                                         //
+        emit_name();                                                        //
+        ADD_TOKEN(CXX_ASSIGN);                                              //
+        ADD_NODE_PARAM(value);                                              //
+        ADD_TOKEN(CXX_SEMICOLON);                                           //
+                                                                            //
+        ADD_HELIX_STD("context");                                           //
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "_H1HJA9ZLO_with");         //
+        PAREN_DELIMIT(emit_name(););                                        //
+        ADD_TOKEN(CXX_SEMICOLON);                                           //
+                                                                            //
+        ADD_NODE_PARAM(body);                                               //
+    );
 }
 
 CX_VISIT_IMPL(PanicState) {
+    if (in_finally) {  // the body runs in a destructor, a throw there is std::terminate
+        throw std::runtime_error(GET_DEBUG_INFO + "can not panic inside a finally");
+    }
+
     ADD_TOKEN(CXX_THROW);
     ADD_NODE_PARAM(expr);
     ADD_TOKEN(CXX_SEMICOLON);
@@ -1076,12 +1622,33 @@ CX_VISIT_IMPL_VA(FuncDecl, bool no_return_t) {
         ADD_NODE_PARAM(generics);
     };
 
+    switch (inlining.decision_for(node)) {  // see inline.hh
+        case InlineDecision::Kind::AlwaysInline:
+            ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "[[gnu::always_inline]]");
+            ADD_TOKEN(CXX_INLINE);
+            break;
+        case InlineDecision::Kind::Inline:
+            ADD_TOKEN(CXX_INLINE);
+            break;
+        case InlineDecision::Kind::None:
+            break;
+    }
+
+    auto modifiers = node.modifiers;  // Modifiers::contains is not const
+
+    const YieldType *yields   = generators.yield_type_of(node);
+    const bool       is_async = modifiers.contains(token::tokens::KEYWORD_ASYNC);
+
+    if (yields != nullptr && is_async) {
+        const auto name = node.name->get_back_name();
+        CODEGEN_ERROR(name, "an async function can not yield");
+    }
+
     if (!no_return_t) {
-        if (node.returns != nullptr) {  //
-            ADD_NODE_PARAM(returns);
-        } else {
-            ADD_TOKEN(CXX_VOID);
-        }
+        emit_return_type(node);
+    } else if (yields != nullptr || is_async) {
+        const auto name = node.name->get_back_name();
+        CODEGEN_ERROR(name, "a constructor can not yield or be async");
     }
 
     // if (node.name == nullptr) {
@@ -1093,14 +1660,180 @@ CX_VISIT_IMPL_VA(FuncDecl, bool no_return_t) {
     PAREN_DELIMIT(          //
         COMMA_SEP(params);  //
     );
-    if (node.body) {
-        ADD_NODE_PARAM(body);  // TODO: should only error in interfaces
+    if (node.body && !declarations_only) {
+        const bool was_generator     = in_generator;
+        const bool was_async         = in_async;
+        const bool was_parallel_for  = in_parallel_for;
+        const bool was_loop_parallel = loop_is_parallel;
+        const bool was_finally       = in_finally;
+        const bool was_leaving       = loop_leaves_finally;
+        in_generator                 = yields != nullptr;
+        in_async                     = is_async;
+        in_parallel_for              = false;
+        loop_is_parallel             = false;
+        in_finally                   = false;
+        loop_leaves_finally          = false;
+
+        if (is_async && node.returns == nullptr) {
+            // a body without await or return would not be a coroutine, end it with a co_return
+            BRACE_DELIMIT(                   //
+                ADD_NODE_PARAM(body);        //
+                ADD_TOKEN(CXX_CO_RETURN);    //
+                ADD_TOKEN(CXX_SEMICOLON);    //
+            );
+        } else if (node.name->get_back_name().value() == "main") {
+            // -> '{' 'helix::std::start_process_pool' '(' ')' ';' body '}'
+            // the workers of `spawn` are forked here, before the program starts any thread
+            BRACE_DELIMIT(                                //
+                ADD_HELIX_STD("start_process_pool");     //
+                PAREN_DELIMIT();                          //
+                ADD_TOKEN(CXX_SEMICOLON);                 //
+                ADD_NODE_PARAM(body);                     //
+            );
+        } else {
+            ADD_NODE_PARAM(body);  // TODO: should only error in interfaces
+        }
+
+        in_generator        = was_generator;
+        in_async            = was_async;
+        in_parallel_for     = was_parallel_for;
+        loop_is_parallel    = was_loop_parallel;
+        in_finally          = was_finally;
+        loop_leaves_finally = was_leaving;
     };
 }
 
+void __CXIR_CODEGEN_N::CXIR::emit_return_type(const __AST_NODE::FuncDecl &node) {
+    auto modifiers = node.modifiers;  // Modifiers::contains is not const
+
+    if (const YieldType *yields = generators.yield_type_of(node); yields != nullptr) {
+        emit_generator_type(node, *yields);
+    } else if (modifiers.contains(token::tokens::KEYWORD_ASYNC)) {
+        // -> 'helix::future' '<' (returns | 'void') '>'
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "helix");
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "future");
+        ANGLE_DELIMIT(                       //
+            if (node.returns != nullptr) {   //
+                ADD_NODE_PARAM(returns);     //
+            } else {                         //
+                ADD_TOKEN(CXX_VOID);         //
+            }                                //
+        );
+    } else if (node.returns != nullptr) {  //
+        ADD_NODE_PARAM(returns);
+    } else {
+        ADD_TOKEN(CXX_VOID);
+    }
+}
+
+void __CXIR_CODEGEN_N::CXIR::emit_generator_type(const __AST_NODE::FuncDecl &node,
+                                                 const YieldType            &yields) {
+    if (!yields.known()) {
+        const auto name = node.name->get_back_name();
+        CODEGEN_ERROR(name,
+                      "can not tell what this generator yields, declare it as the return type");
+    }
+
+    // helix::generator<T>, or for a literal helix::generator<literal_t<decltype(literal)>> so
+    // `yield "text"` gives a generator of strings
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "helix");
+    ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "generator");
+    ADD_TOKEN(CXX_LESS);
+
+    if (yields.type != nullptr) {
+        ADD_PARAM(yields.type);
+    } else {
+        ADD_HELIX_STD("__internal_interfaces");
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "literal_t");
+        ANGLE_DELIMIT(                          //
+            ADD_TOKEN(CXX_DECLTYPE);            //
+            PAREN_DELIMIT(                      //
+                ADD_PARAM(yields.literal);      //
+            );                                  //
+        );
+    }
+
+    ADD_TOKEN(CXX_GREATER);
+}
+
 CX_VISIT_IMPL(VarDecl) {
     // if (node.var->type, ADD_PARAM(node.var->type);) else { ADD_TOKEN(CXX_AUTO); }
 
+    if (escapes.is_stack_literal(node)) {
+        // -> '::std::array' ('<' T ',' N '>')? name '=' '{'? '{' values '}' '}'?
+        // the literal never leaves the function and can not grow, see escape.hh
+        const std::string size = std::to_string(
+            __AST_NODE::Node::as<__AST_NODE::ArrayLiteralExpr>(node.value)->values.size());
+
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "std");
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "array");
+
+        if (node.var->type != nullptr) {
+            ANGLE_DELIMIT(                                     //
+                ADD_NODE_PARAM(var->type->generics->args[0]);  //
+                ADD_TOKEN(CXX_COMMA);                          //
+                ADD_TOKEN_AS_VALUE(CXX_CORE_LITERAL, size);    //
+            );
+        }
+
+        ADD_NODE_PARAM(var->path);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+
+        if (node.var->type != nullptr) {
+            // the outer braces initialize the inner c array, so nested literals are not elided
+            BRACE_DELIMIT(ADD_NODE_PARAM(value););
+        } else {
+            ADD_NODE_PARAM(value);  // deduced, nested literals are never candidates
+        }
+
+        return;
+    }
+
+    if (escapes.is_small_literal(node)) {
+        // -> '::helix::std::small_vector_of' '<' (T | '::std::common_type_t' '<' ('decltype' '('
+        //        value ')')+ '>') ',' N '>' name '=' '{' values '}'
+        // short, grown in place and never leaves the function, see escape.hh. the inline
+        // capacity follows the element count N of the literal instead of a fixed default
+        const auto &values = __AST_NODE::Node::as<__AST_NODE::ArrayLiteralExpr>(node.value)->values;
+
+        ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        ADD_HELIX_STD("small_vector_of");
+        ANGLE_DELIMIT(                                                                   //
+            if (node.var->type != nullptr) {                                             //
+                ADD_NODE_PARAM(var->type->generics->args[0]);                            //
+            } else {                                                                     //
+                ADD_TOKEN(CXX_SCOPE_RESOLUTION);                                         //
+                ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "std");                          //
+                ADD_TOKEN(CXX_SCOPE_RESOLUTION);                                         //
+                ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "common_type_t");                //
+                ANGLE_DELIMIT(                                                           //
+                    for (size_t i = 0; i < values.size(); ++i) {                         //
+                        if (i != 0) {                                                    //
+                            ADD_TOKEN(CXX_COMMA);                                        //
+                        }                                                                //
+                                                                                         //
+                        ADD_TOKEN(CXX_DECLTYPE);                                         //
+                        PAREN_DELIMIT(ADD_PARAM(values[i]););                            //
+                    }                                                                    //
+                );                                                                       //
+            }                                                                            //
+                                                                                         //
+            ADD_TOKEN(CXX_COMMA);                                                        //
+            ADD_TOKEN_AS_VALUE(CXX_CORE_LITERAL, std::to_string(values.size()));         //
+        );
+
+        ADD_NODE_PARAM(var->path);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_OPERATOR, "=");
+        ADD_NODE_PARAM(value);
+
+        return;
+    }
+
     ADD_NODE_PARAM(var);
 
     if (node.value) {
@@ -1179,7 +1912,7 @@ CX_VISIT_IMPL(OpDecl) {
     };
 }
 
-CX_VISIT_IMPL(Program) {
+void __CXIR_CODEGEN_N::CXIR::emit_preamble() {
     ADD_TOKEN_AS_VALUE(
         CXX_ANNOTATION,
         R"(///*--- Helix ---*
@@ -1193,236 +1926,165 @@ CX_VISIT_IMPL(Program) {
 ///  Copyright (c) 2024 (CC BY 4.0)
 ///
 ///  This file was generated by the Helix compiler, do not modify it directly.
-///  Generated on: )" +
-            std::to_string(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())) +
-            R"( [unix-timestamp]
 ///
 ///*--- Helix ---*
 
-// auto c++ includes for the core of the language
-#include <set>
-#include <map>
-#include <tuple>
-#include <array>
-#include <limits>
-#include <string>
-#include <vector>
-#include <memory>
-#include <cstdint>
-#include <variant>
-#include <sstream>
-#include <utility>
-#include <concepts>
-#include <optional>
-#include <iostream>
-#include <stdexcept>
-#include <type_traits>
-
-#ifdef __GNUG__
-    #include <cxxabi.h>
-    #include <memory>
-#endif
-
-/// language primitive types
-
-/// ensure cross-platform compatibility for 128-bit and 256-bit types.
-/// gcc/clang support these types, but MSVC may not. We can conditionally include them.
-
-using u8   = unsigned char;
-using i8   = signed char;
-using u16  = unsigned short;
-using i16  = signed short;
-using u32  = unsigned int;
-using i32  = signed int;
-using u64  = unsigned long long;
-using i64  = signed long long;
-
-#if !defined(_MSC_VER)
-    using u128 = __uint128_t;
-    using i128 = __int128_t;
-#endif
-
-using f32 = float;
-using f64 = double;
-using f80 = long double;
-
-using usize = std::size_t;
-using isize = std::ptrdiff_t;
-
-using byte = std::byte;
-using string = std::string;
-
-template <typename ...Args>
-using tuple = std::tuple<Args...>;
-template <typename ...Args>
-using list = std::vector<Args...>;
-template <typename ...Args>
-using set = std::set<Args...>;
-template <typename ...Args>
-using map = std::map<Args...>;
-
-#if __cplusplus < 202002L
-static_assert(false, "helix requires c++20 or higher");
-#endif
-
-/// \include belongs to the helix standard library.
-/// \brief namespace for helix standard library in c++
-namespace helix {
-/// \include belongs to the helix standard library.
-/// \brief namespace for helix standard library
-namespace std {
-/// \include belongs to the helix standard library.
-/// \brief namespace for internal interfaces
-namespace __internal_interfaces {
-    /// \include belongs to the helix standard library.
-    /// \brief concept for converting a type to a string
-    ///
-    /// This concept checks if a type has a to_string method that returns a string
-    ///
-    template <typename T>
-    concept ToString = requires(T a) {
-        { a.to_string() } -> ::std::convertible_to<::string>;
-    };
+)" + (prelude_by_reference ? "#include \"" + std::string(prelude_header_name) + "\"\n"
+                                 : std::string(prelude)));
+}
 
-    /// \include belongs to the helix standard library.
-    /// \brief concept for converting a type to a ostream
-    ///
-    /// This concept checks if a type has an ostream operator
-    ///
-    template <typename T>
-    concept OStream = requires(::std::ostream &os, T a) {
-        { os << a } -> ::std::convertible_to<::std::ostream &>;
-    };
+CX_VISIT_IMPL(Program) {
+    emit_preamble();
 
-    /// \include belongs to the helix standard library.
-    /// \brief concept for converting a type to a string
-    ///
-    /// This concept checks if a type can be converted to a string
-    ///
-    template <typename T>
-    concept CanConvertToStringForm = ToString<T> || OStream<T>;
-}  // namespace __internal_interfaces
-
-/// \include belongs to the helix standard library.
-/// \brief convert any type to a string
-///
-/// This function will try to convert the argument to a string using the following methods:
-/// - if the argument has a to_string method, it will use that
-/// - if the argument has a ostream operator, it will use that
-/// - if the argument is an arithmetic type, it will use std::to_string
-/// - if all else fails, it will convert the address of the argument to a string
-///
-template <typename Expr>
-constexpr ::string any_to_string(Expr &&arg) {
-    if constexpr (__internal_interfaces::ToString<Expr>) {
-        return arg.to_string();
-    } else if constexpr (__internal_interfaces::OStream<Expr>) {
-        ::std::stringstream ss;
-        ss << arg;
-        return ss.str();
-    } else if constexpr (::std::is_arithmetic_v<Expr>) {
-        return ::std::to_string(arg);
-    } else {
-        ::std::stringstream ss;
-    
-#       ifdef __GNUG__
-            int status;
-            char *realname = abi::__cxa_demangle(typeid(arg).name(), 0, 0, &status);
-            ss << "[" << realname << " at 0x" << ::std::hex << &arg << "]";
-            free(realname);
-#       else
-            ss << "[" << typeid(arg).name() << " at 0x" << ::std::hex << &arg << "]";
-#       endif
+    instantiations.collect(node);
+    escapes.analyze(node);
+    generators.analyze(node);
+    inlining.analyze(node);
+
+    for (const auto &child : node.children) {
+        child->accept(*this);
+    }
 
-        return ss.str();
+    if (max_units > 1) {
+        emit_units(node);
     }
 }
 
-/// \include belongs to the helix standard library.
-/// \brief format a string with arguments
-///
-/// TODO: = is not yet suppoted
-///
-/// the following calls can happen in helix and becomes the following c++:
-///
-/// f"hi: {var}"   -> format_string("hi: \{\}", var)
-/// f"hi: {var1=}" -> format_string("hi: var1=\{\}", var1)
-///
-/// f"hi: {(some_expr() + 12)=}" -> format_string("hi: (some_expr() + 12)=\{\}", some_expr())
-/// f"hi: {some_expr() + 12}"    -> format_string("hi: \{\}", some_expr() + 12)
-///
-template <typename... Expr>
-constexpr  ::string format_string( ::string base, Expr &&...args) {
-    const ::std::array< ::string, sizeof...(args)> exprs_as_string = {
-        any_to_string(::std::forward<Expr>(args))...};
-    size_t pos = 0;
-
-#pragma unroll
-    for (auto &&arg : exprs_as_string) {
-        pos = base.find("\\{\\}", pos);
-
-        if (pos == ::string::npos) [[unlikely]] {
-            throw ::std::runtime_error(
-                "Internal [f-stirng engine] error: format argument count mismatch");
+void __CXIR_CODEGEN_N::CXIR::emit_units(const __AST_NODE::Program &node) {
+    units = {};
+    partition.partition(node, inlining, max_units);
+
+    if (partition.unit_count() == 0) {
+        return;
+    }
+
+    CX_TokenBuffer single = std::move(tokens);
+
+    // -> preamble '#pragma once' decls ('extern' 'template' ...)*
+    tokens = CX_TokenBuffer();
+    emit_preamble();
+    ADD_TOKEN(CXX_PP_PRAGMA);
+    ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, "once");
+    emit_unit_decls(node.children, std::nullopt);
+    emit_instantiations(instantiations, true);
+    units.header = std::move(tokens);
+
+    // -> '#include' header definitions ('template' ...)*
+    for (size_t unit = 0; unit < partition.unit_count(); ++unit) {
+        tokens = CX_TokenBuffer();
+        ADD_TOKEN(CXX_PP_INCLUDE);
+        ADD_TOKEN_AS_VALUE(CXX_CORE_LITERAL, "\"" + units_header + "\"");
+        emit_unit_decls(node.children, unit);
+
+        if (unit == 0) {  // the first unit owns every explicit instantiation
+            emit_instantiations(instantiations, false);
         }
 
-        base.replace(pos, 4, arg);
-        pos += arg.size();
+        units.sources.push_back(std::move(tokens));
     }
 
-    return base;
+    tokens = std::move(single);
 }
-}  // namespace std
 
-class endl {
-  public:
-    endl &operator=(const endl &) = delete;
-    endl &operator=(endl &&)      = delete;
-    endl(const endl &end)         = delete;
-    endl(endl &&)                 = delete;
-    endl()                        = default;
-    ~endl()                       = default;
+void __CXIR_CODEGEN_N::CXIR::emit_unit_decls(const __AST_N::NodeV<> &decls,
+                                             std::optional<size_t>   unit) {
+    for (const auto &decl : decls) {
+        if (decl == nullptr) {
+            continue;
+        }
 
-    explicit endl(::string end)
-        : end_l(::std::move(end)) {}
-    
-    explicit endl(const char *end)
-        : end_l(end) {}
-    
-    explicit endl(const char end)
-        : end_l(::string(1, end)) {}
-    
-    friend ::std::ostream &operator<<(::std::ostream &oss, const endl &end) {
-        oss << end.end_l;
-        return oss;
-    }
+        if (decl->getNodeType() == __AST_NODE::nodes::ModuleDecl) {
+            // -> 'inline'? 'namespace' name '{' decls '}'
+            const auto module = __AST_NODE::Node::as<__AST_NODE::ModuleDecl>(decl);
 
-  private:
-    ::string end_l = "\n";
-};
-}  // namespace helix
+            if (module->inline_module) {
+                ADD_TOKEN(CXX_INLINE);
+            }
 
-template <typename... Args>
-inline constexpr void print(Args &&...args) {
-    if constexpr (sizeof...(args) == 0) {
-        ::std::cout << helix::endl('\n');
-        return;
-    };
-    
-    (::std::cout << ... << args);
-    
-    if constexpr (sizeof...(args) > 0) {
-        if constexpr (!::std::is_same_v<::std::remove_cv_t<::std::remove_reference_t<
-                                          decltype(::std::get<sizeof...(args) - 1>(
-                                              ::std::tuple<Args...>(args...)))>>,
-                                      helix::endl>) {
-            ::std::cout << helix::endl('\n');
+            ADD_TOKEN(CXX_NAMESPACE);
+            ADD_PARAM(module->name);
+            ADD_TOKEN(CXX_LBRACE);
+
+            if (module->body != nullptr && module->body->body != nullptr) {
+                emit_unit_decls(module->body->body->body, unit);
+            }
+
+            ADD_TOKEN(CXX_RBRACE);
+            continue;
+        }
+
+        std::optional<size_t> owner;
+
+        if (decl->getNodeType() == __AST_NODE::nodes::FuncDecl) {
+            owner = partition.unit_of(*__AST_NODE::Node::as<__AST_NODE::FuncDecl>(decl));
+        }
+
+        if (!unit.has_value()) {
+            // the header declares the functions the units define, everything else as is
+            declarations_only = owner.has_value();
+            decl->accept(*this);
+
+            if (declarations_only) {
+                ADD_TOKEN(CXX_SEMICOLON);
+                declarations_only = false;
+            }
+        } else if (owner == unit) {
+            decl->accept(*this);
         }
     }
 }
-)");
 
-    for (const auto &child : node.children) {
-        child->accept(*this);
+void __CXIR_CODEGEN_N::CXIR::emit_instantiations(const InstantiationCollector &collected,
+                                                 bool                          as_extern) {
+    // -> 'extern'? 'template' ret scope::name '<' args '>' '(' param_types ')' ';'
+    // only functions. `template class X<A>;` instantiates every member of X<A>, also the ones
+    // A can not support and that the program never calls, so a generic class or struct is left
+    // to the implicit instantiation of the members that are used
+    for (const auto &inst : collected.get_instantiations()) {
+        if (inst.kind != Instantiation::Kind::Function) {
+            continue;
+        }
+
+        // the declaration already reported that its yield type is unknown
+        if (const YieldType *yields = generators.yield_type_of(*inst.func);
+            yields != nullptr && !yields->known()) {
+            continue;
+        }
+
+        if (as_extern) {
+            ADD_TOKEN(CXX_EXTERN);
+        }
+
+        ADD_TOKEN(CXX_TEMPLATE);
+
+        for (size_t i = 0; i < inst.params.size(); ++i) {
+            generic_substitutions[inst.params[i]] = inst.args->args[i];
+        }
+
+        emit_return_type(*inst.func);  // the same helix::future or helix::generator wrapping
+
+        // no leading '::', it would qualify a class return type (`helix::future<T> ::f`), the
+        // instantiations are at namespace scope so the scope resolves the same without it
+        for (const auto &segment : inst.scope) {
+            ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, segment);
+            ADD_TOKEN(CXX_SCOPE_RESOLUTION);
+        }
+
+        ADD_TOKEN_AS_VALUE(CXX_CORE_IDENTIFIER, inst.name);
+        ADD_PARAM(inst.args);
+        ADD_TOKEN(CXX_LPAREN);
+
+        for (size_t i = 0; i < inst.func->params.size(); ++i) {
+            if (i != 0) {
+                ADD_TOKEN(CXX_COMMA);
+            }
+
+            ADD_PARAM(inst.func->params[i]->var->type);
+        }
+
+        ADD_TOKEN(CXX_RPAREN);
+        ADD_TOKEN(CXX_SEMICOLON);
+
+        generic_substitutions.clear();
     }
-}
\ No newline at end of file
+}
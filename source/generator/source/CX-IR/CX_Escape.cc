@@ -0,0 +1,201 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <string>
+#include <unordered_set>
+
+#include "generator/include/CX-IR/escape.hh"
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+
+namespace {
+using namespace parser::ast;
+
+/// members of std::vector that std::array also has with the same meaning, none of them can
+/// change the size of the container or hand out ownership of it
+const std::unordered_set<std::string> fixed_size_members = {
+    "size", "empty", "front", "back", "begin", "end", "cbegin", "cend", "data", "at"};
+
+/// members of std::vector that change its size in place, helix::std::small_vector has them too
+const std::unordered_set<std::string> growing_members = {
+    "push_back", "emplace_back", "pop_back", "insert", "emplace", "erase", "clear", "resize",
+    "reserve"};
+
+/// elements in the list literal `decl` binds
+size_t literal_size(const node::VarDecl &decl) {
+    return node::Node::as<node::ArrayLiteralExpr>(decl.value)->values.size();
+}
+
+/// true if a list literal of this shape can be spelled as a std::array or a small_vector
+bool is_local_literal(const node::VarDecl &decl) {
+    if (decl.value == nullptr || decl.value->getNodeType() != node::nodes::ArrayLiteralExpr) {
+        return false;
+    }
+
+    const auto literal = node::Node::as<node::ArrayLiteralExpr>(decl.value);
+
+    if (decl.var->type == nullptr) {
+        if (literal->values.empty()) {
+            return false;  // nothing to deduce the element type from
+        }
+
+        // `std::array x = {...}` has to deduce the element type, nested braces can not be deduced
+        for (const auto &value : literal->values) {
+            switch (value->getNodeType()) {
+                case node::nodes::ArrayLiteralExpr:
+                case node::nodes::SetLiteralExpr:
+                case node::nodes::TupleLiteralExpr:
+                case node::nodes::MapLiteralExpr:
+                case node::nodes::ObjInitExpr:
+                    return false;
+                default:
+                    break;
+            }
+        }
+
+        return true;
+    }
+
+    // only `list::<T>`, any other declared type is left alone
+    const auto &type = decl.var->type;
+
+    return type->value != nullptr && type->value->getNodeType() == node::nodes::IdentExpr &&
+           node::Node::as<node::IdentExpr>(type->value)->name.value() == "list" &&
+           type->generics != nullptr && type->generics->args.size() == 1 && !type->nullable;
+}
+}  // namespace
+
+void __CXIR_CODEGEN_N::EscapeAnalysis::analyze(const __AST_NODE::Program &program) {
+    frames.clear();
+    stack_literals.clear();
+    small_literals.clear();
+
+    Walker::visit(program);
+}
+
+bool __CXIR_CODEGEN_N::EscapeAnalysis::is_candidate(const __AST_N::NodeT<> &node) const {
+    if (frames.empty() || node == nullptr || node->getNodeType() != __AST_NODE::nodes::IdentExpr) {
+        return false;
+    }
+
+    return frames.back().candidates.contains(
+        std::string(__AST_NODE::Node::as<__AST_NODE::IdentExpr>(node)->name.value()));
+}
+
+void __CXIR_CODEGEN_N::EscapeAnalysis::escape(const std::string &name) {
+    if (!frames.empty() && frames.back().candidates.contains(name)) {
+        frames.back().escaped.insert(name);
+    }
+}
+
+CX_ESCAPE_IMPL(IdentExpr) {
+    // any use not matched by one of the visits below may let the value out of the function
+    escape(std::string(node.name.value()));
+}
+
+CX_ESCAPE_IMPL(ArrayAccessExpr) {
+    // x[i] reads or writes an element, the container itself stays put
+    if (is_candidate(node.lhs)) {
+        walk(node.rhs);
+        return;
+    }
+
+    Walker::visit(node);
+}
+
+CX_ESCAPE_IMPL(DotPathExpr) {
+    // x.size() is parsed as DotPathExpr(x, FunctionCallExpr(size))
+    if (is_candidate(node.lhs) && node.rhs != nullptr &&
+        node.rhs->getNodeType() == __AST_NODE::nodes::FunctionCallExpr) {
+        const auto call = __AST_NODE::Node::as<__AST_NODE::FunctionCallExpr>(node.rhs);
+
+        if (call->path->type == __AST_NODE::PathExpr::PathType::Identifier) {
+            const std::string member(call->path->get_back_name().value());
+
+            if (growing_members.contains(member)) {
+                frames.back().grown.insert(std::string(
+                    __AST_NODE::Node::as<__AST_NODE::IdentExpr>(node.lhs)->name.value()));
+            }
+
+            if (fixed_size_members.contains(member) || growing_members.contains(member)) {
+                walk(call->args);
+                return;
+            }
+        }
+    }
+
+    Walker::visit(node);
+}
+
+CX_ESCAPE_IMPL(ForPyStatementCore) {
+    // for e in x: iterating by value or reference is fine for a std::array as well
+    if (is_candidate(node.range)) {
+        walk(node.vars);
+        walk(node.body);
+        return;
+    }
+
+    Walker::visit(node);
+}
+
+CX_ESCAPE_IMPL(VarDecl) {
+    // the declared name is not a use, only the type and initializer are walked
+    walk(node.var->type);
+    walk(node.value);
+}
+
+CX_ESCAPE_IMPL(LetDecl) {
+    if (frames.empty()) {  // globals are visible everywhere, nothing to prove
+        Walker::visit(node);
+        return;
+    }
+
+    for (const auto &var : node.vars) {
+        const std::string name(var->var->path->name.value());
+        Frame            &frame = frames.back();
+
+        // shadowing within one function is resolved by name only, so give up on both
+        if (frame.candidates.contains(name)) {
+            frame.escaped.insert(name);
+        } else if (is_local_literal(*var)) {
+            frame.candidates.emplace(name, var.get());
+        }
+
+        walk(var);
+    }
+}
+
+CX_ESCAPE_IMPL(FuncDecl) {
+    frames.emplace_back();
+
+    Walker::visit(node);
+
+    for (const auto &[name, decl] : frames.back().candidates) {
+        if (frames.back().escaped.contains(name)) {
+            continue;
+        }
+
+        const size_t size = literal_size(*decl);
+
+        // an empty literal is only there to be grown, std::array<T, 0> would be useless
+        if (frames.back().grown.contains(name) || size == 0) {
+            if (size <= max_small_elements) {
+                small_literals.insert(decl);
+            }
+        } else if (size <= max_stack_elements) {
+            stack_literals.insert(decl);
+        }
+    }
+
+    frames.pop_back();
+}
@@ -0,0 +1,114 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <string>
+
+#include "generator/include/CX-IR/generators.hh"
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+
+namespace {
+using namespace parser::ast;
+
+/// a literal whose decltype can be spelled in the signature, f-strings refer to locals
+bool is_plain_literal(const NodeT<> &node) {
+    if (node == nullptr || node->getNodeType() != node::nodes::LiteralExpr) {
+        return false;
+    }
+
+    const auto literal = node::Node::as<node::LiteralExpr>(node);
+
+    return !literal->contains_format_args && literal->type != node::LiteralExpr::LiteralType::Null;
+}
+}  // namespace
+
+void __CXIR_CODEGEN_N::GeneratorAnalysis::analyze(const __AST_NODE::Program &program) {
+    frames.clear();
+    generators.clear();
+
+    Walker::visit(program);
+}
+
+__CXIR_CODEGEN_N::YieldType
+__CXIR_CODEGEN_N::GeneratorAnalysis::type_of(const __AST_NODE::VarDecl &decl) {
+    YieldType type;
+
+    if (decl.var->type != nullptr) {
+        type.type = decl.var->type;
+    } else if (is_plain_literal(decl.value)) {
+        type.literal = decl.value;
+    }
+
+    return type;
+}
+
+CX_GENERATOR_IMPL(YieldState) {
+    Walker::visit(node);
+
+    if (frames.empty() || frames.back().yields.first != nullptr) {
+        return;  // only the first yield decides, the c++ compiler checks the rest
+    }
+
+    Frame &frame       = frames.back();
+    frame.yields.first = &node;
+
+    if (is_plain_literal(node.value)) {
+        frame.yields.literal = node.value;
+    } else if (node.value != nullptr && node.value->getNodeType() == __AST_NODE::nodes::IdentExpr) {
+        const auto found = frame.names.find(
+            std::string(__AST_NODE::Node::as<__AST_NODE::IdentExpr>(node.value)->name.value()));
+
+        if (found != frame.names.end()) {
+            frame.yields.type    = found->second.type;
+            frame.yields.literal = found->second.literal;
+        }
+    }
+}
+
+CX_GENERATOR_IMPL(LetDecl) {
+    if (frames.empty()) {
+        Walker::visit(node);
+        return;
+    }
+
+    for (const auto &var : node.vars) {
+        walk(var);  // the initializer is in scope before the name is
+        frames.back().names[std::string(var->var->path->name.value())] = type_of(*var);
+    }
+}
+
+CX_GENERATOR_IMPL(FuncDecl) {
+    frames.emplace_back();
+
+    for (const auto &param : node.params) {
+        if (param != nullptr) {
+            frames.back().names[std::string(param->var->path->name.value())] = type_of(*param);
+        }
+    }
+
+    Walker::visit(node);
+
+    YieldType yields = frames.back().yields;
+    frames.pop_back();
+
+    if (yields.first == nullptr) {
+        return;
+    }
+
+    if (node.returns != nullptr) {  // the declared type wins over anything inferred
+        yields.type    = node.returns;
+        yields.literal = nullptr;
+    }
+
+    generators.emplace(&node, std::move(yields));
+}
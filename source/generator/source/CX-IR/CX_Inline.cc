@@ -0,0 +1,201 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <string>
+
+#include "generator/include/CX-IR/inline.hh"
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+#include "token/include/private/Token_generate.hh"
+
+void __CXIR_CODEGEN_N::InlineCostModel::analyze(const __AST_NODE::Program &program) {
+    frames.clear();
+    decisions.clear();
+    order.clear();
+    skip_depth = 0;
+
+    Walker::visit(program);
+}
+
+std::string __CXIR_CODEGEN_N::InlineCostModel::report() const {
+    std::string out;
+
+    for (const auto &decision : order) {
+        out += decision.file + ":" + std::to_string(decision.line) + ": " + decision.name +
+               " (cost " + std::to_string(decision.cost) + (decision.leaf ? ", leaf" : "") +
+               ") -> ";
+
+        switch (decision.kind) {
+            case InlineDecision::Kind::None:
+                out += "not inlined";
+                break;
+            case InlineDecision::Kind::Inline:
+                out += "inline";
+                break;
+            case InlineDecision::Kind::AlwaysInline:
+                out += "always_inline";
+                break;
+        }
+
+        out += ", " + decision.reason + "\n";
+    }
+
+    return out;
+}
+
+CX_INLINE_IMPL(BinaryExpr) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(UnaryExpr) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(FunctionCallExpr) {
+    charge(call_cost);
+
+    if (!frames.empty()) {
+        ++frames.back().calls;
+
+        if (node.path->type != __AST_NODE::PathExpr::PathType::Dot &&
+            node.path->get_back_name().value() == frames.back().name) {
+            frames.back().recursive = true;
+        }
+    }
+
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(ForState) {
+    charge(loop_cost);
+
+    if (!frames.empty()) {
+        ++frames.back().loops;
+    }
+
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(WhileState) {
+    charge(loop_cost);
+
+    if (!frames.empty()) {
+        ++frames.back().loops;
+    }
+
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(IfState) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(SwitchCaseState) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(TryState) {
+    charge(loop_cost);  // landing pads are as heavy as a loop for the purpose of inlining
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(ReturnState) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(ExprState) {
+    charge(1);
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(LetDecl) {
+    charge(node.vars.size());
+    Walker::visit(node);
+}
+
+CX_INLINE_IMPL(ClassDecl) {
+    ++skip_depth;
+    Walker::visit(node);
+    --skip_depth;
+}
+
+CX_INLINE_IMPL(StructDecl) {
+    ++skip_depth;
+    Walker::visit(node);
+    --skip_depth;
+}
+
+CX_INLINE_IMPL(InterDecl) {
+    ++skip_depth;
+    Walker::visit(node);
+    --skip_depth;
+}
+
+CX_INLINE_IMPL(OpDecl) {
+    // the operator wrapper is always emitted inline, see CXIR::visit(OpDecl)
+    ++skip_depth;
+    Walker::visit(node);
+    --skip_depth;
+}
+
+CX_INLINE_IMPL(FuncDecl) {
+    if (skip_depth != 0 || !frames.empty() || node.body == nullptr ||
+        node.name->type == __AST_NODE::PathExpr::PathType::Dot) {
+        // methods, nested functions and declarations are never candidates
+        charge(call_cost);
+        Walker::visit(node);
+        return;
+    }
+
+    const __TOKEN_N::Token name = node.name->get_back_name();
+    frames.push_back({.name = std::string(name.value())});
+
+    Walker::visit(node);
+
+    const Frame    frame = frames.back();
+    InlineDecision decision{.name = frame.name,
+                            .file = std::string(name.file_name()),
+                            .line = name.line_number(),
+                            .cost = frame.cost,
+                            .leaf = frame.calls == 0 && frame.loops == 0};
+
+    frames.pop_back();
+
+    // Modifiers::contains is not const
+    auto modifiers = node.modifiers;
+
+    if (frame.name == "main") {
+        decision.reason = "entry point";
+    } else if (modifiers.contains(__TOKEN_N::KEYWORD_INLINE)) {
+        decision.kind   = InlineDecision::Kind::AlwaysInline;
+        decision.reason = "requested with 'inline'";
+    } else if (frame.recursive) {
+        decision.reason = "recursive";
+    } else if (frame.cost <= inline_budget) {
+        decision.kind   = InlineDecision::Kind::Inline;
+        decision.reason = "small";
+    } else if (decision.leaf && frame.cost <= leaf_budget) {
+        decision.kind   = InlineDecision::Kind::Inline;
+        decision.reason = "small leaf";
+    } else {
+        decision.reason = "over budget";
+    }
+
+    decisions.emplace(&node, order.size());
+    order.push_back(std::move(decision));
+}
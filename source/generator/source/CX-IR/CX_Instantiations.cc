@@ -0,0 +1,414 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "generator/include/CX-IR/instantiations.hh"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+namespace {
+using namespace parser::ast;
+
+/// names the prelude defines at namespace scope that are not lexed as reserved primitives
+const std::unordered_set<std::string> prelude_types = {
+    "u8",  "i8",  "u16", "i16",  "u32",   "i32",  "u64",   "i64",  "u128", "i128", "f32",
+    "f64", "f80", "usize", "isize", "byte", "string", "list", "set", "map",  "tuple",
+    "ordered_set", "ordered_map", "simd", "i8x16", "u8x16", "i16x8", "u16x8", "i32x4", "u32x4",
+    "i32x8", "u32x8", "i64x2", "u64x2", "i64x4", "u64x4", "f32x4", "f32x8", "f32x16", "f64x2",
+    "f64x4", "f64x8"};
+
+/// spells a node into a compact canonical form, whitespace and source locations are dropped so
+/// `Box::< i32 >` and `Box::<i32>` on different lines produce the same key
+class Speller : public visitor::Walker {
+  public:
+    std::string out;
+
+    using Walker::visit;
+
+    void visit(const node::IdentExpr &node) override { out += node.name.value(); }
+    void visit(const node::LiteralExpr &node) override { out += node.value.value(); }
+
+    void visit(const node::UnaryExpr &node) override {
+        out += node.op.value();
+        walk(node.opd);
+    }
+
+    void visit(const node::ScopePathExpr &node) override {
+        if (node.global_scope) {
+            out += "::";
+        }
+
+        for (const auto &ident : node.path) {
+            walk(ident);
+            out += "::";
+        }
+
+        walk(node.access);
+    }
+
+    void visit(const node::GenericInvokeExpr &node) override {
+        out += '<';
+
+        for (size_t i = 0; i < node.args.size(); ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+
+            walk(node.args[i]);
+        }
+
+        out += '>';
+    }
+
+    void visit(const node::TupleLiteralExpr &node) override {
+        out += "tuple<";
+
+        for (size_t i = 0; i < node.values.size(); ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+
+            walk(node.values[i]);
+        }
+
+        out += '>';
+    }
+};
+
+/// the simple name of whatever a path or type refers to, empty if it is not a plain name
+std::string back_name(const NodeT<> &path) {
+    if (path == nullptr) {
+        return "";
+    }
+
+    switch (path->getNodeType()) {
+        case node::nodes::IdentExpr:
+            return std::string(node::Node::as<node::IdentExpr>(path)->name.value());
+
+        case node::nodes::ScopePathExpr:
+            return back_name(node::Node::as<node::ScopePathExpr>(path)->access);
+
+        case node::nodes::PathExpr: {
+            const auto expr = node::Node::as<node::PathExpr>(path);
+            return expr->type == node::PathExpr::PathType::Dot ? "" : back_name(expr->path);
+        }
+
+        default:
+            return "";
+    }
+}
+
+std::vector<std::string> param_names(const NodeT<node::RequiresDecl> &generics) {
+    std::vector<std::string> names;
+
+    if (generics == nullptr || generics->params == nullptr) {
+        return names;
+    }
+
+    names.reserve(generics->params->params.size());
+
+    for (const auto &param : generics->params->params) {
+        names.emplace_back(param->var->path->name.value());
+    }
+
+    return names;
+}
+}  // namespace
+
+std::string __CXIR_CODEGEN_N::spell_node(const parser::ast::NodeT<> &node) {
+    Speller speller;
+
+    if (node != nullptr) {
+        node->accept(speller);
+    }
+
+    return speller.out;
+}
+
+void __CXIR_CODEGEN_N::InstantiationCollector::collect(const __AST_NODE::Program &program) {
+    generic_decls.clear();
+    namespace_types.clear();
+    seen.clear();
+    template_params.clear();
+    instantiations.clear();
+
+    std::vector<std::string> scope;
+    register_decls(program.children, scope);
+
+    Walker::visit(program);
+}
+
+void __CXIR_CODEGEN_N::InstantiationCollector::register_decls(const __AST_N::NodeV<> &decls,
+                                                             std::vector<std::string> &scope) {
+    for (const auto &decl : decls) {
+        if (decl == nullptr) {
+            continue;
+        }
+
+        switch (decl->getNodeType()) {
+            case __AST_NODE::nodes::ModuleDecl: {
+                const auto module = __AST_NODE::Node::as<__AST_NODE::ModuleDecl>(decl);
+
+                if (module->body == nullptr || module->body->body == nullptr) {
+                    break;
+                }
+
+                // a module name may be a path (module a::b), every segment is its own namespace
+                std::string name  = spell_node(module->name);
+                size_t      depth = scope.size();
+
+                for (size_t pos = 0; (pos = name.find("::")) != std::string::npos;) {
+                    scope.emplace_back(name.substr(0, pos));
+                    name.erase(0, pos + 2);
+                }
+
+                scope.emplace_back(name);
+                register_decls(module->body->body->body, scope);
+                scope.resize(depth);
+
+                break;
+            }
+
+            case __AST_NODE::nodes::FuncDecl: {
+                const auto func = __AST_NODE::Node::as<__AST_NODE::FuncDecl>(decl);
+                const auto name = back_name(func->name);
+
+                if (func->generics == nullptr) {
+                    // still counts toward overloads so a generic of the same name is ambiguous
+                    generic_decls[name].push_back({Instantiation::Kind::Function, scope, {}, nullptr});
+                    break;
+                }
+
+                generic_decls[name].push_back(
+                    {Instantiation::Kind::Function, scope, param_names(func->generics), func});
+                break;
+            }
+
+            case __AST_NODE::nodes::ClassDecl: {
+                const auto cls = __AST_NODE::Node::as<__AST_NODE::ClassDecl>(decl);
+                namespace_types.emplace(cls->name->name.value());
+
+                if (cls->generics != nullptr) {
+                    generic_decls[std::string(cls->name->name.value())].push_back(
+                        {Instantiation::Kind::Class, scope, param_names(cls->generics), nullptr});
+                }
+
+                break;
+            }
+
+            case __AST_NODE::nodes::StructDecl: {
+                const auto st = __AST_NODE::Node::as<__AST_NODE::StructDecl>(decl);
+                namespace_types.emplace(st->name->name.value());
+
+                if (st->generics != nullptr) {
+                    generic_decls[std::string(st->name->name.value())].push_back(
+                        {Instantiation::Kind::Struct, scope, param_names(st->generics), nullptr});
+                }
+
+                break;
+            }
+
+            case __AST_NODE::nodes::EnumDecl:
+                namespace_types.emplace(
+                    __AST_NODE::Node::as<__AST_NODE::EnumDecl>(decl)->name->name.value());
+                break;
+
+            case __AST_NODE::nodes::TypeDecl:
+                namespace_types.emplace(
+                    __AST_NODE::Node::as<__AST_NODE::TypeDecl>(decl)->name->name.value());
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+bool __CXIR_CODEGEN_N::InstantiationCollector::is_concrete(
+    const __AST_N::NodeT<__AST_NODE::GenericInvokeExpr> &args) {
+    // every identifier in the arguments has to resolve at namespace scope, anything else is
+    // either a template parameter (dependent) or a local type we can not name from another tu
+    class ConcreteCheck : public __AST_VISITOR::Walker {
+      public:
+        explicit ConcreteCheck(const InstantiationCollector &self)
+            : self(self) {}
+
+        bool concrete = true;
+
+        using Walker::visit;
+
+        void visit(const __AST_NODE::IdentExpr &node) override {
+            const std::string name(node.name.value());
+
+            for (const auto &params : self.template_params) {
+                for (const auto &param : params) {
+                    if (param == name) {
+                        concrete = false;
+                        return;
+                    }
+                }
+            }
+
+            if (!node.is_reserved_primitive && !prelude_types.contains(name) &&
+                !self.namespace_types.contains(name)) {
+                concrete = false;
+            }
+        }
+
+        void visit(const __AST_NODE::ScopePathExpr &node) override {
+            // qualified names are assumed to be namespace scope, only the head can be dependent
+            if (!node.path.empty()) {
+                for (const auto &params : self.template_params) {
+                    for (const auto &param : params) {
+                        if (param == node.path.front()->name.value()) {
+                            concrete = false;
+                            return;
+                        }
+                    }
+                }
+
+                return;
+            }
+
+            walk(node.access);
+        }
+
+        void visit(const __AST_NODE::LiteralExpr &node) override {
+            switch (node.type) {
+                case __AST_NODE::LiteralExpr::LiteralType::Integer:
+                case __AST_NODE::LiteralExpr::LiteralType::Boolean:
+                case __AST_NODE::LiteralExpr::LiteralType::Char:
+                    return;
+                default:
+                    concrete = false;
+            }
+        }
+
+        void visit(const __AST_NODE::LambdaExpr & /* node */) override { concrete = false; }
+        void visit(const __AST_NODE::FunctionCallExpr & /* node */) override { concrete = false; }
+        void visit(const __AST_NODE::DotPathExpr & /* node */) override { concrete = false; }
+
+      private:
+        const InstantiationCollector &self;
+    };
+
+    ConcreteCheck check(*this);
+    args->accept(check);
+
+    return check.concrete;
+}
+
+void __CXIR_CODEGEN_N::InstantiationCollector::record(
+    const std::string &name, const __AST_N::NodeT<__AST_NODE::GenericInvokeExpr> &args) {
+    const auto decl = generic_decls.find(name);
+
+    // overloaded or unknown names can not be instantiated without overload resolution
+    if (decl == generic_decls.end() || decl->second.size() != 1) {
+        return;
+    }
+
+    const GenericDecl &generic = decl->second.front();
+
+    if (generic.params.empty() || generic.params.size() != args->args.size() ||
+        !is_concrete(args)) {
+        return;
+    }
+
+    if (generic.kind == Instantiation::Kind::Function) {
+        // without a type on every parameter there is no signature to declare
+        for (const auto &param : generic.func->params) {
+            if (param->var == nullptr || param->var->type == nullptr) {
+                return;
+            }
+        }
+    }
+
+    std::string key;
+
+    for (const auto &segment : generic.scope) {
+        key += segment + "::";
+    }
+
+    key += name + spell_node(args);
+
+    if (!seen.emplace(key).second) {
+        return;
+    }
+
+    instantiations.push_back(
+        {generic.kind, std::move(key), generic.scope, name, generic.params, args, generic.func});
+}
+
+void __CXIR_CODEGEN_N::InstantiationCollector::push_params(
+    const __AST_N::NodeT<__AST_NODE::RequiresDecl> &generics) {
+    if (generics != nullptr) {
+        template_params.push_back(param_names(generics));
+    }
+}
+
+void __CXIR_CODEGEN_N::InstantiationCollector::pop_params(
+    const __AST_N::NodeT<__AST_NODE::RequiresDecl> &generics) {
+    if (generics != nullptr) {
+        template_params.pop_back();
+    }
+}
+
+CX_COLLECT_IMPL(FunctionCallExpr) {
+    if (node.generic != nullptr) {
+        record(back_name(node.path), node.generic);
+    }
+
+    Walker::visit(node);
+}
+
+CX_COLLECT_IMPL(Type) {
+    if (node.generics != nullptr) {
+        record(back_name(node.value), node.generics);
+    }
+
+    Walker::visit(node);
+}
+
+CX_COLLECT_IMPL(FuncDecl) {
+    push_params(node.generics);
+    Walker::visit(node);
+    pop_params(node.generics);
+}
+
+CX_COLLECT_IMPL(ClassDecl) {
+    push_params(node.generics);
+    Walker::visit(node);
+    pop_params(node.generics);
+}
+
+CX_COLLECT_IMPL(StructDecl) {
+    push_params(node.generics);
+    Walker::visit(node);
+    pop_params(node.generics);
+}
+
+CX_COLLECT_IMPL(InterDecl) {
+    push_params(node.generics);
+    Walker::visit(node);
+    pop_params(node.generics);
+}
+
+CX_COLLECT_IMPL(TypeDecl) {
+    push_params(node.generics);
+    Walker::visit(node);
+    pop_params(node.generics);
+}
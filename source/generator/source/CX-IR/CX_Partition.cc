@@ -0,0 +1,141 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "generator/include/CX-IR/partition.hh"
+#include "generator/include/config/Gen_config.def"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+
+void __CXIR_CODEGEN_N::UnitPartition::partition(const __AST_NODE::Program &program,
+                                                const InlineCostModel     &costs,
+                                                size_t                     max_units) {
+    assignment.clear();
+    movable.clear();
+    units  = 0;
+    reason = "";
+
+    if (max_units < 2) {
+        reason = "a single unit was requested";
+        return;
+    }
+
+    if (!collect(program.children, costs)) {
+        return;
+    }
+
+    if (movable.size() < 2) {
+        reason = "fewer than two out-of-line functions";
+        return;
+    }
+
+    u64 total = 0;
+
+    for (const auto *func : movable) {
+        total += costs.cost_of(*func) + 1;
+    }
+
+    // every unit pays for a process and for parsing the shared header, small programs are
+    // faster as a single unit
+    units = std::min({max_units, movable.size(), static_cast<size_t>(total / min_unit_cost)});
+
+    if (units < 2) {
+        units  = 0;
+        reason = "the program is too small to be worth splitting";
+        return;
+    }
+
+    // longest processing time first, ties keep source order so the output is deterministic
+    std::vector<const __AST_NODE::FuncDecl *> by_cost = movable;
+    std::stable_sort(by_cost.begin(), by_cost.end(), [&](const auto *lhs, const auto *rhs) {
+        return costs.cost_of(*lhs) > costs.cost_of(*rhs);
+    });
+
+    std::vector<u64> load(units, 0);
+
+    for (const auto *func : by_cost) {
+        const size_t unit = static_cast<size_t>(
+            std::distance(load.begin(), std::min_element(load.begin(), load.end())));
+
+        load[unit] += costs.cost_of(*func) + 1;  // + 1 so empty functions still spread out
+        assignment.emplace(func, unit);
+    }
+}
+
+bool __CXIR_CODEGEN_N::UnitPartition::collect(const __AST_N::NodeV<> &decls,
+                                              const InlineCostModel  &costs) {
+    for (const auto &decl : decls) {
+        if (decl == nullptr) {
+            continue;
+        }
+
+        switch (decl->getNodeType()) {
+            case __AST_NODE::nodes::ClassDecl:
+            case __AST_NODE::nodes::StructDecl:
+            case __AST_NODE::nodes::InterDecl:
+            case __AST_NODE::nodes::EnumDecl:
+            case __AST_NODE::nodes::TypeDecl:
+            case __AST_NODE::nodes::FFIDecl:
+                break;  // declarations only, they can be repeated in every unit
+
+            case __AST_NODE::nodes::ModuleDecl: {
+                const auto module = __AST_NODE::Node::as<__AST_NODE::ModuleDecl>(decl);
+
+                if (module->body != nullptr && module->body->body != nullptr &&
+                    !collect(module->body->body->body, costs)) {
+                    return false;
+                }
+
+                break;
+            }
+
+            case __AST_NODE::nodes::FuncDecl: {
+                const auto func = __AST_NODE::Node::as<__AST_NODE::FuncDecl>(decl);
+
+                // declarations, generics and inline functions can be repeated in every unit
+                if (func->body == nullptr || func->generics != nullptr ||
+                    costs.decision_for(*func) != InlineDecision::Kind::None) {
+                    break;
+                }
+
+                // anything else left in the header would be defined once per unit
+                if (func->name->type != __AST_NODE::PathExpr::PathType::Identifier) {
+                    reason = "an out-of-line function has a qualified name";
+                    return false;
+                }
+
+                // default arguments may only be spelled once, on the declaration
+                const bool has_defaults =
+                    std::ranges::any_of(func->params, [](const auto &param) {
+                        return param->value != nullptr;
+                    });
+
+                if (has_defaults) {
+                    reason = "an out-of-line function has default arguments";
+                    return false;
+                }
+
+                movable.push_back(func.get());
+                break;
+            }
+
+            default:
+                reason = "namespace scope state would be defined in every unit";
+                return false;
+        }
+    }
+
+    return true;
+}
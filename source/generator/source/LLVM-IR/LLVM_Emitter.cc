@@ -0,0 +1,1901 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <llvm/ADT/APInt.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/TargetParser/Host.h>
+
+#include <charconv>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "generator/include/config/Gen_config.def"
+#include "generator/include/llvm_emitter.hh"
+#include "neo-panic/include/error.hh"
+#include "parser/ast/include/AST.hh"
+#include "parser/ast/include/config/AST_config.def"
+#include "token/include/private/Token_generate.hh"
+
+namespace {
+using namespace parser::ast;
+
+/// the name a type or an identifier path spells, nullopt for anything more complex
+std::optional<std::string> simple_name(const NodeT<> &node) {
+    if (node == nullptr) {
+        return std::nullopt;
+    }
+
+    if (node->getNodeType() == node::nodes::IdentExpr) {
+        return node::Node::as<node::IdentExpr>(node)->name.value();
+    }
+
+    if (node->getNodeType() == node::nodes::PathExpr) {
+        const auto path = node::Node::as<node::PathExpr>(node);
+
+        if (path->type == node::PathExpr::PathType::Identifier) {
+            return path->get_back_name().value();
+        }
+    }
+
+    return std::nullopt;
+}
+
+struct CountedRange {
+    NodeT<> start;
+    NodeT<> end;
+    NodeT<> step;  ///< null for a step of one
+    bool    inclusive = false;
+};
+
+/// `a..b`, `a..=b` and `(a..b).step_by(s)`, the same ranges cx-ir lowers to a counted loop
+std::optional<CountedRange> as_counted_range(NodeT<> range) {
+    CountedRange counted;
+
+    if (range->getNodeType() == node::nodes::DotPathExpr) {
+        const auto dot = node::Node::as<node::DotPathExpr>(range);
+
+        if (dot->rhs == nullptr || dot->rhs->getNodeType() != node::nodes::FunctionCallExpr) {
+            return std::nullopt;
+        }
+
+        const auto call = node::Node::as<node::FunctionCallExpr>(dot->rhs);
+
+        if (call->path->type != node::PathExpr::PathType::Identifier ||
+            call->path->get_back_name().value() != "step_by" || call->generic != nullptr ||
+            call->args->args.size() != 1 ||
+            call->args->args[0]->getNodeType() != node::nodes::ArgumentExpr) {
+            return std::nullopt;
+        }
+
+        counted.step = node::Node::as<node::ArgumentExpr>(call->args->args[0])->value;
+        range        = dot->lhs;
+    }
+
+    while (range->getNodeType() == node::nodes::ParenthesizedExpr) {
+        range = node::Node::as<node::ParenthesizedExpr>(range)->value;
+    }
+
+    if (range->getNodeType() != node::nodes::BinaryExpr) {
+        return std::nullopt;
+    }
+
+    const auto bounds = node::Node::as<node::BinaryExpr>(range);
+
+    switch (bounds->op.token_kind()) {
+        case __TOKEN_N::OPERATOR_RANGE:
+            break;
+        case __TOKEN_N::OPERATOR_RANGE_INCLUSIVE:
+            counted.inclusive = true;
+            break;
+        default:
+            return std::nullopt;
+    }
+
+    counted.start = bounds->lhs;
+    counted.end   = bounds->rhs;
+
+    return counted;
+}
+
+/// the binary operator a compound assignment applies, nullopt if `op` is not one
+std::optional<__TOKEN_N::tokens> compound_operator(__TOKEN_N::tokens op) {
+    switch (op) {
+        case __TOKEN_N::OPERATOR_ADD_ASSIGN:
+            return __TOKEN_N::OPERATOR_ADD;
+        case __TOKEN_N::OPERATOR_SUB_ASSIGN:
+            return __TOKEN_N::OPERATOR_SUB;
+        case __TOKEN_N::OPERATOR_MUL_ASSIGN:
+            return __TOKEN_N::OPERATOR_MUL;
+        case __TOKEN_N::OPERATOR_DIV_ASSIGN:
+            return __TOKEN_N::OPERATOR_DIV;
+        case __TOKEN_N::OPERATOR_MOD_ASSIGN:
+            return __TOKEN_N::OPERATOR_MOD;
+        case __TOKEN_N::OPERATOR_BITWISE_AND_ASSIGN:
+            return __TOKEN_N::OPERATOR_BITWISE_AND;
+        case __TOKEN_N::OPERATOR_BITWISE_OR_ASSIGN:
+            return __TOKEN_N::OPERATOR_BITWISE_OR;
+        case __TOKEN_N::OPERATOR_BITWISE_XOR_ASSIGN:
+            return __TOKEN_N::OPERATOR_BITWISE_XOR;
+        case __TOKEN_N::OPERATOR_BITWISE_L_SHIFT_ASSIGN:
+            return __TOKEN_N::OPERATOR_BITWISE_L_SHIFT;
+        case __TOKEN_N::OPERATOR_BITWISE_R_SHIFT_ASSIGN:
+            return __TOKEN_N::OPERATOR_BITWISE_R_SHIFT;
+        default:
+            return std::nullopt;
+    }
+}
+
+void initialize_llvm() {
+    static std::once_flag once;
+
+    std::call_once(once, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+}  // namespace
+
+__LLVM_CODEGEN_N::LLVMEmitter::LLVMEmitter(const std::string &module_name)
+    : context(std::make_unique<::llvm::LLVMContext>())
+    , module(std::make_unique<::llvm::Module>(module_name, *context))
+    , builder(*context) {}
+
+bool __LLVM_CODEGEN_N::LLVMEmitter::lower(const __AST_NODE::Program &program) {
+    if (!prepare_target()) {
+        return false;
+    }
+
+    // structs first and in source order, a field can only name a struct declared before it
+    for (const auto &child : program.children) {
+        switch (child->getNodeType()) {
+            case __AST_NODE::nodes::StructDecl:
+                declare_struct(*__AST_NODE::Node::as<__AST_NODE::StructDecl>(child));
+                break;
+            case __AST_NODE::nodes::FuncDecl:
+                break;
+            default:
+                unsupported("top level " + child->getNodeName());
+                break;
+        }
+
+        if (!ok()) {
+            return false;
+        }
+    }
+
+    // every signature before any body, so calls do not depend on the order of declarations
+    for (const auto &child : program.children) {
+        if (child->getNodeType() == __AST_NODE::nodes::FuncDecl) {
+            declare_function(*__AST_NODE::Node::as<__AST_NODE::FuncDecl>(child));
+        }
+
+        if (!ok()) {
+            return false;
+        }
+    }
+
+    for (const auto &child : program.children) {
+        if (child->getNodeType() == __AST_NODE::nodes::FuncDecl) {
+            child->accept(*this);
+        }
+
+        if (!ok()) {
+            return false;
+        }
+    }
+
+    std::string              problems;
+    ::llvm::raw_string_ostream stream(problems);
+
+    // a verifier failure is a bug in this emitter, cx-ir can still compile the program
+    if (::llvm::verifyModule(*module, &stream)) {
+        stream.flush();
+        unsupported("invalid ir: " + problems);
+    }
+
+    return ok();
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::optimize(::llvm::OptimizationLevel level) {
+    // declared in this order so they are destroyed in the right one
+    ::llvm::LoopAnalysisManager     loops;
+    ::llvm::FunctionAnalysisManager functions;
+    ::llvm::CGSCCAnalysisManager    cgscc;
+    ::llvm::ModuleAnalysisManager   modules;
+
+    ::llvm::PassBuilder passes(target.get());
+
+    passes.registerModuleAnalyses(modules);
+    passes.registerCGSCCAnalyses(cgscc);
+    passes.registerFunctionAnalyses(functions);
+    passes.registerLoopAnalyses(loops);
+    passes.crossRegisterProxies(loops, functions, cgscc, modules);
+
+    ::llvm::ModulePassManager pipeline = level == ::llvm::OptimizationLevel::O0
+                                             ? passes.buildO0DefaultPipeline(level)
+                                             : passes.buildPerModuleDefaultPipeline(level);
+
+    pipeline.run(*module, modules);
+}
+
+bool __LLVM_CODEGEN_N::LLVMEmitter::emit_object(const std::string &path, std::string &error) {
+    std::error_code          err;
+    ::llvm::raw_fd_ostream   out(path, err, ::llvm::sys::fs::OF_None);
+    ::llvm::legacy::PassManager codegen;
+
+    if (err) {
+        error = err.message();
+        return false;
+    }
+
+    if (target->addPassesToEmitFile(codegen, out, nullptr, ::llvm::CodeGenFileType::ObjectFile)) {
+        error = "the target can not emit object files";
+        return false;
+    }
+
+    codegen.run(*module);
+    out.flush();
+
+    return true;
+}
+
+std::string __LLVM_CODEGEN_N::LLVMEmitter::to_string() const {
+    std::string                text;
+    ::llvm::raw_string_ostream stream(text);
+
+    module->print(stream, nullptr);
+    stream.flush();
+
+    return text;
+}
+
+::llvm::orc::ThreadSafeModule __LLVM_CODEGEN_N::LLVMEmitter::take_module() {
+    return {std::move(module), std::move(context)};
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::unsupported(const std::string &what) {
+    if (reason.empty()) {
+        reason = what;
+    }
+}
+
+bool __LLVM_CODEGEN_N::LLVMEmitter::prepare_target() {
+    initialize_llvm();
+
+    const std::string triple = ::llvm::sys::getDefaultTargetTriple();
+    std::string       error;
+
+    const ::llvm::Target *found = ::llvm::TargetRegistry::lookupTarget(triple, error);
+
+    if (found == nullptr) {
+        unsupported("no llvm target for " + triple + ": " + error);
+        return false;
+    }
+
+    target.reset(found->createTargetMachine(
+        triple, ::llvm::sys::getHostCPUName(), "", ::llvm::TargetOptions(), ::llvm::Reloc::PIC_));
+
+    module->setTargetTriple(triple);
+    module->setDataLayout(target->createDataLayout());
+
+    return true;
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::declare_struct(const __AST_NODE::StructDecl &node) {
+    if (node.generics != nullptr || node.derives != nullptr || !node.modifiers.empty()) {
+        unsupported("generic, derived or qualified struct");
+        return;
+    }
+
+    const std::string name = node.name->name.value();
+
+    if (structs.contains(name)) {
+        unsupported("struct " + name + " declared twice");
+        return;
+    }
+
+    StructLayout                layout;
+    std::vector<::llvm::Type *> elements;
+
+    layout.type = ::llvm::StructType::create(*context, name);
+
+    if (node.body != nullptr && node.body->body != nullptr) {
+        for (const auto &member : node.body->body->body) {
+            if (member->getNodeType() != __AST_NODE::nodes::LetDecl) {
+                unsupported("struct member " + member->getNodeName());
+                return;
+            }
+
+            for (const auto &var : __AST_NODE::Node::as<__AST_NODE::LetDecl>(member)->vars) {
+                if (var->value != nullptr || var->var->type == nullptr) {
+                    unsupported("struct member without a type or with a default value");
+                    return;
+                }
+
+                const auto type = lower_type(var->var->type);
+
+                if (!type.has_value()) {
+                    return;
+                }
+
+                layout.fields.push_back(var->var->path->name.value());
+                layout.field_types.push_back(*type);
+                elements.push_back(type->type);
+            }
+        }
+    }
+
+    layout.type->setBody(elements);
+    structs.emplace(name, std::move(layout));
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::declare_function(const __AST_NODE::FuncDecl &node) {
+    if (node.generics != nullptr || node.name->type != __AST_NODE::PathExpr::PathType::Identifier) {
+        unsupported("generic or qualified function");
+        return;
+    }
+
+    const std::string name = node.name->get_back_name().value();
+
+    // an access specifier or inline changes nothing for a free function, everything else (async,
+    // eval, static, const, panic, = default, = delete) changes what it is, only cx-ir knows how
+    auto modifiers = node.modifiers;
+
+    if (!node.qualifiers.empty() || modifiers.contains(__TOKEN_N::KEYWORD_ASYNC) ||
+        modifiers.contains(__TOKEN_N::KEYWORD_EVAL) ||
+        modifiers.contains(__TOKEN_N::KEYWORD_STATIC) ||
+        modifiers.contains(__TOKEN_N::KEYWORD_CONST)) {
+        unsupported("function with modifiers or qualifiers " + name);
+        return;
+    }
+
+    if (functions.contains(name)) {
+        unsupported("overloaded function " + name);
+        return;
+    }
+
+    FunctionInfo info;
+    info.decls   = node.params;
+    info.returns = {.type = ::llvm::Type::getVoidTy(*context)};
+
+    if (node.returns != nullptr) {
+        const auto returns = lower_type(node.returns);
+
+        if (!returns.has_value()) {
+            return;
+        }
+
+        info.returns = *returns;
+    }
+
+    info.returns_void = info.returns.type->isVoidTy();
+
+    std::vector<::llvm::Type *> params;
+
+    for (const auto &param : node.params) {
+        if (param->var->type == nullptr) {
+            unsupported("parameter without a type in " + name);
+            return;
+        }
+
+        const auto type = lower_type(param->var->type);
+
+        if (!type.has_value()) {
+            return;
+        }
+
+        info.params.push_back(*type);
+        params.push_back(type->type);
+    }
+
+    // `fn main()` is `int main()` in c++, the exit code is 0 unless main returns one
+    ::llvm::Type *returns = info.returns.type;
+
+    if (name == "main" && info.returns_void) {
+        returns = ::llvm::Type::getInt32Ty(*context);
+    }
+
+    // everything but main and the functions defined elsewhere is only visible to this module,
+    // which lets the optimizer drop what it inlined everywhere
+    const auto linkage = node.body == nullptr || name == "main"
+                             ? ::llvm::Function::ExternalLinkage
+                             : ::llvm::Function::InternalLinkage;
+
+    info.function = ::llvm::Function::Create(
+        ::llvm::FunctionType::get(returns, params, false), linkage, name, *module);
+
+    for (size_t i = 0; i < node.params.size(); ++i) {
+        info.function->getArg(static_cast<unsigned>(i))
+            ->setName(node.params[i]->var->path->name.value());
+    }
+
+    functions.emplace(name, std::move(info));
+}
+
+std::optional<__LLVM_CODEGEN_N::HelixType>
+__LLVM_CODEGEN_N::LLVMEmitter::lower_type(const __AST_N::NodeT<__AST_NODE::Type> &type) {
+    if (type == nullptr || type->generics != nullptr || type->nullable || type->is_fn_ptr ||
+        !type->specifiers.empty()) {
+        unsupported("a generic, nullable or qualified type");
+        return std::nullopt;
+    }
+
+    const auto name = simple_name(type->value);
+
+    if (!name.has_value()) {
+        unsupported("type " + type->value->getNodeName());
+        return std::nullopt;
+    }
+
+    if (const auto found = structs.find(*name); found != structs.end()) {
+        return HelixType{.type = found->second.type, .layout = &found->second};
+    }
+
+    return primitive(*name);
+}
+
+std::optional<__LLVM_CODEGEN_N::HelixType>
+__LLVM_CODEGEN_N::LLVMEmitter::primitive(const std::string &name) {
+    // `int`, `float`, `char` and friends are prelude types with their own semantics in cx-ir,
+    // only the fixed size ones map one to one
+    if (name == "bool") {
+        return HelixType{.type = ::llvm::Type::getInt1Ty(*context)};
+    }
+
+    if (name == "void") {
+        return HelixType{.type = ::llvm::Type::getVoidTy(*context)};
+    }
+
+    if (name == "f32") {
+        return HelixType{.type = ::llvm::Type::getFloatTy(*context), .is_signed = true};
+    }
+
+    if (name == "f64") {
+        return HelixType{.type = ::llvm::Type::getDoubleTy(*context), .is_signed = true};
+    }
+
+    if (name.size() >= 2 && (name[0] == 'i' || name[0] == 'u')) {
+        unsigned bits = 0;
+
+        const auto parsed = std::from_chars(name.data() + 1, name.data() + name.size(), bits);
+
+        if (parsed.ec == std::errc{} && parsed.ptr == name.data() + name.size() &&
+            (bits == 8 || bits == 16 || bits == 32 || bits == 64 || bits == 128)) {
+            return HelixType{.type      = ::llvm::Type::getIntNTy(*context, bits),
+                             .is_signed = name[0] == 'i'};
+        }
+    }
+
+    unsupported("type " + name);
+    return std::nullopt;
+}
+
+__LLVM_CODEGEN_N::LLVMEmitter::TypedValue
+__LLVM_CODEGEN_N::LLVMEmitter::lower_expr(const __AST_N::NodeT<> &node) {
+    if (!ok()) {
+        return {};
+    }
+
+    if (node == nullptr) {
+        unsupported("a missing expression");
+        return {};
+    }
+
+    result = {};
+    node->accept(*this);
+
+    if (ok() && result.value == nullptr) {
+        unsupported(node->getNodeName() + " used as a value");
+    }
+
+    if (!ok()) {
+        return {};
+    }
+
+    return std::exchange(result, {});
+}
+
+bool __LLVM_CODEGEN_N::LLVMEmitter::addressable(const __AST_N::NodeT<> &node) {
+    switch (node->getNodeType()) {
+        case __AST_NODE::nodes::IdentExpr:
+        case __AST_NODE::nodes::PathExpr: {
+            const auto name = simple_name(node);
+            return name.has_value() && find_local(*name) != nullptr;
+        }
+        case __AST_NODE::nodes::ParenthesizedExpr:
+            return addressable(__AST_NODE::Node::as<__AST_NODE::ParenthesizedExpr>(node)->value);
+        case __AST_NODE::nodes::DotPathExpr:
+            return addressable(__AST_NODE::Node::as<__AST_NODE::DotPathExpr>(node)->lhs);
+        default:
+            return false;
+    }
+}
+
+std::optional<__LLVM_CODEGEN_N::LLVMEmitter::Local>
+__LLVM_CODEGEN_N::LLVMEmitter::lower_address(const __AST_N::NodeT<> &node) {
+    switch (node->getNodeType()) {
+        case __AST_NODE::nodes::IdentExpr:
+        case __AST_NODE::nodes::PathExpr: {
+            const auto name = simple_name(node);
+
+            if (!name.has_value()) {
+                break;
+            }
+
+            if (Local *local = find_local(*name); local != nullptr) {
+                return *local;
+            }
+
+            unsupported("unknown name " + *name);
+            return std::nullopt;
+        }
+
+        case __AST_NODE::nodes::ParenthesizedExpr:
+            return lower_address(__AST_NODE::Node::as<__AST_NODE::ParenthesizedExpr>(node)->value);
+
+        case __AST_NODE::nodes::DotPathExpr: {
+            const auto dot  = __AST_NODE::Node::as<__AST_NODE::DotPathExpr>(node);
+            const auto base = lower_address(dot->lhs);
+
+            if (!base.has_value()) {
+                return std::nullopt;
+            }
+
+            const auto field = simple_name(dot->rhs);
+
+            if (base->type.layout == nullptr || !field.has_value()) {
+                unsupported("member access that is not a struct field");
+                return std::nullopt;
+            }
+
+            const auto index = base->type.layout->field(*field);
+
+            if (!index.has_value()) {
+                unsupported("unknown field " + *field);
+                return std::nullopt;
+            }
+
+            const StructLayout &layout = *base->type.layout;
+
+            return Local{.slot = builder.CreateStructGEP(layout.type, base->slot, *index, *field),
+                         .type = layout.field_types[*index]};
+        }
+
+        default:
+            break;
+    }
+
+    unsupported("assignment to " + node->getNodeName());
+    return std::nullopt;
+}
+
+std::optional<__LLVM_CODEGEN_N::LLVMEmitter::TypedValue>
+__LLVM_CODEGEN_N::LLVMEmitter::convert(TypedValue value, const HelixType &to) {
+    ::llvm::Type *from = value.type.type;
+
+    if (from == to.type) {
+        return TypedValue{value.value, to};  // at most the signedness changes
+    }
+
+    if (to.is_bool() && (value.type.is_integer() || value.type.is_float())) {
+        return TypedValue{to_bool(value), to};
+    }
+
+    if (value.type.is_integer() && to.is_integer()) {
+        const bool sign_extend = value.type.is_signed && !value.type.is_bool();
+        return TypedValue{builder.CreateIntCast(value.value, to.type, sign_extend), to};
+    }
+
+    if (value.type.is_integer() && to.is_float()) {
+        return TypedValue{value.type.is_signed && !value.type.is_bool()
+                              ? builder.CreateSIToFP(value.value, to.type)
+                              : builder.CreateUIToFP(value.value, to.type),
+                          to};
+    }
+
+    if (value.type.is_float() && to.is_integer()) {
+        return TypedValue{to.is_signed ? builder.CreateFPToSI(value.value, to.type)
+                                       : builder.CreateFPToUI(value.value, to.type),
+                          to};
+    }
+
+    if (value.type.is_float() && to.is_float()) {
+        return TypedValue{builder.CreateFPCast(value.value, to.type), to};
+    }
+
+    return std::nullopt;
+}
+
+std::optional<__LLVM_CODEGEN_N::HelixType>
+__LLVM_CODEGEN_N::LLVMEmitter::common_type(const HelixType &lhs, const HelixType &rhs) {
+    const auto arithmetic_type = [](const HelixType &type) {
+        return type.is_integer() || type.is_float();
+    };
+
+    if (!arithmetic_type(lhs) || !arithmetic_type(rhs)) {
+        return std::nullopt;
+    }
+
+    if (lhs.is_float() || rhs.is_float()) {
+        if (!lhs.is_float()) {
+            return rhs;
+        }
+
+        if (!rhs.is_float()) {
+            return lhs;
+        }
+
+        return lhs.type->getPrimitiveSizeInBits() >= rhs.type->getPrimitiveSizeInBits() ? lhs
+                                                                                        : rhs;
+    }
+
+    // integral promotion, everything narrower than int becomes an int
+    const auto promote = [&](const HelixType &type) {
+        return type.type->getIntegerBitWidth() < 32
+                   ? HelixType{.type = ::llvm::Type::getInt32Ty(*context), .is_signed = true}
+                   : type;
+    };
+
+    const HelixType left  = promote(lhs);
+    const HelixType right = promote(rhs);
+
+    const unsigned left_bits  = left.type->getIntegerBitWidth();
+    const unsigned right_bits = right.type->getIntegerBitWidth();
+
+    if (left_bits != right_bits) {
+        return left_bits > right_bits ? left : right;
+    }
+
+    return HelixType{.type = left.type, .is_signed = left.is_signed && right.is_signed};
+}
+
+::llvm::Value *__LLVM_CODEGEN_N::LLVMEmitter::to_bool(const TypedValue &value) {
+    if (value.type.is_bool()) {
+        return value.value;
+    }
+
+    if (value.type.is_integer()) {
+        return builder.CreateICmpNE(value.value, ::llvm::Constant::getNullValue(value.type.type));
+    }
+
+    if (value.type.is_float()) {
+        return builder.CreateFCmpUNE(value.value, ::llvm::Constant::getNullValue(value.type.type));
+    }
+
+    unsupported("a condition that is not a number or bool");
+    return nullptr;
+}
+
+__LLVM_CODEGEN_N::LLVMEmitter::TypedValue __LLVM_CODEGEN_N::LLVMEmitter::arithmetic(
+    const __TOKEN_N::Token &op, TypedValue lhs, TypedValue rhs) {
+    const __TOKEN_N::tokens kind = op.token_kind();
+    std::optional<HelixType> type;
+
+    // the result of a shift has the (promoted) type of its left operand
+    if (kind == __TOKEN_N::OPERATOR_BITWISE_L_SHIFT ||
+        kind == __TOKEN_N::OPERATOR_BITWISE_R_SHIFT) {
+        type = common_type(lhs.type, lhs.type);
+    } else {
+        type = common_type(lhs.type, rhs.type);
+    }
+
+    if (!type.has_value()) {
+        unsupported("operator " + op.value() + " on non arithmetic operands");
+        return {};
+    }
+
+    const auto left  = convert(lhs, *type);
+    const auto right = convert(rhs, *type);
+
+    if (!left.has_value() || !right.has_value()) {
+        unsupported("operator " + op.value() + " on mismatched operands");
+        return {};
+    }
+
+    ::llvm::Value  *l        = left->value;
+    ::llvm::Value  *r        = right->value;
+    const bool      floating = type->is_float();
+    const bool      is_signed = type->is_signed;
+    const HelixType boolean{.type = ::llvm::Type::getInt1Ty(*context)};
+
+    switch (kind) {
+        case __TOKEN_N::OPERATOR_ADD:
+            return {floating ? builder.CreateFAdd(l, r) : builder.CreateAdd(l, r), *type};
+        case __TOKEN_N::OPERATOR_SUB:
+            return {floating ? builder.CreateFSub(l, r) : builder.CreateSub(l, r), *type};
+        case __TOKEN_N::OPERATOR_MUL:
+            return {floating ? builder.CreateFMul(l, r) : builder.CreateMul(l, r), *type};
+        case __TOKEN_N::OPERATOR_DIV:
+            return {floating    ? builder.CreateFDiv(l, r)
+                    : is_signed ? builder.CreateSDiv(l, r)
+                                : builder.CreateUDiv(l, r),
+                    *type};
+        case __TOKEN_N::OPERATOR_MOD:
+            return {floating    ? builder.CreateFRem(l, r)
+                    : is_signed ? builder.CreateSRem(l, r)
+                                : builder.CreateURem(l, r),
+                    *type};
+
+        case __TOKEN_N::OPERATOR_EQUAL:
+            return {floating ? builder.CreateFCmpOEQ(l, r) : builder.CreateICmpEQ(l, r), boolean};
+        case __TOKEN_N::OPERATOR_NOT_EQUAL:
+            return {floating ? builder.CreateFCmpUNE(l, r) : builder.CreateICmpNE(l, r), boolean};
+        case __TOKEN_N::PUNCTUATION_OPEN_ANGLE:
+            return {floating    ? builder.CreateFCmpOLT(l, r)
+                    : is_signed ? builder.CreateICmpSLT(l, r)
+                                : builder.CreateICmpULT(l, r),
+                    boolean};
+        case __TOKEN_N::PUNCTUATION_CLOSE_ANGLE:
+            return {floating    ? builder.CreateFCmpOGT(l, r)
+                    : is_signed ? builder.CreateICmpSGT(l, r)
+                                : builder.CreateICmpUGT(l, r),
+                    boolean};
+        case __TOKEN_N::OPERATOR_LESS_THAN_EQUALS:
+            return {floating    ? builder.CreateFCmpOLE(l, r)
+                    : is_signed ? builder.CreateICmpSLE(l, r)
+                                : builder.CreateICmpULE(l, r),
+                    boolean};
+        case __TOKEN_N::OPERATOR_GREATER_THAN_EQUALS:
+            return {floating    ? builder.CreateFCmpOGE(l, r)
+                    : is_signed ? builder.CreateICmpSGE(l, r)
+                                : builder.CreateICmpUGE(l, r),
+                    boolean};
+
+        default:
+            break;
+    }
+
+    if (floating) {
+        unsupported("operator " + op.value() + " on floating point operands");
+        return {};
+    }
+
+    switch (kind) {
+        case __TOKEN_N::OPERATOR_BITWISE_AND:
+            return {builder.CreateAnd(l, r), *type};
+        case __TOKEN_N::OPERATOR_BITWISE_OR:
+            return {builder.CreateOr(l, r), *type};
+        case __TOKEN_N::OPERATOR_BITWISE_XOR:
+            return {builder.CreateXor(l, r), *type};
+        case __TOKEN_N::OPERATOR_BITWISE_L_SHIFT:
+            return {builder.CreateShl(l, r), *type};
+        case __TOKEN_N::OPERATOR_BITWISE_R_SHIFT:
+            return {is_signed ? builder.CreateAShr(l, r) : builder.CreateLShr(l, r), *type};
+        default:
+            break;
+    }
+
+    unsupported("operator " + op.value());
+    return {};
+}
+
+::llvm::AllocaInst *__LLVM_CODEGEN_N::LLVMEmitter::entry_alloca(const HelixType   &type,
+                                                              const std::string &name) {
+    ::llvm::BasicBlock &entry = current->function->getEntryBlock();
+    ::llvm::IRBuilder<> at_entry(&entry, entry.begin());
+
+    return at_entry.CreateAlloca(type.type, nullptr, name);
+}
+
+::llvm::BasicBlock *__LLVM_CODEGEN_N::LLVMEmitter::new_block(const char *name) {
+    return ::llvm::BasicBlock::Create(*context, name, current->function);
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::branch_to(::llvm::BasicBlock *block) {
+    if (builder.GetInsertBlock()->getTerminator() == nullptr) {
+        builder.CreateBr(block);
+    }
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::start_dead_block() {
+    builder.SetInsertPoint(new_block("dead"));
+}
+
+__LLVM_CODEGEN_N::LLVMEmitter::Local *
+__LLVM_CODEGEN_N::LLVMEmitter::find_local(const std::string &name) {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        if (const auto found = scope->find(name); found != scope->end()) {
+            return &found->second;
+        }
+    }
+
+    return nullptr;
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_condition_branch(const __AST_N::NodeT<> &condition,
+                                                           bool                    negate,
+                                                           ::llvm::BasicBlock     *if_true,
+                                                           ::llvm::BasicBlock     *if_false) {
+    const TypedValue value = lower_expr(condition);
+
+    if (!ok()) {
+        return;
+    }
+
+    ::llvm::Value *truth = to_bool(value);
+
+    if (truth == nullptr) {
+        return;
+    }
+
+    builder.CreateCondBr(truth, negate ? if_false : if_true, negate ? if_true : if_false);
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_var(const __AST_NODE::VarDecl &node) {
+    const std::string name = node.var->path->name.value();
+    TypedValue        value;
+    HelixType         type;
+
+    if (node.var->type != nullptr) {
+        const auto declared = lower_type(node.var->type);
+
+        if (!declared.has_value()) {
+            return;
+        }
+
+        type = *declared;
+    }
+
+    if (node.value != nullptr) {
+        value = lower_expr(node.value);
+
+        if (!ok()) {
+            return;
+        }
+
+        if (type.type == nullptr) {
+            type = value.type;
+        }
+
+        const auto converted = convert(value, type);
+
+        if (!converted.has_value()) {
+            unsupported("initializing " + name + " from an unrelated type");
+            return;
+        }
+
+        value = *converted;
+    } else if (type.type == nullptr) {
+        unsupported("let " + name + " without a type or a value");
+        return;
+    }
+
+    if (type.type->isVoidTy()) {
+        unsupported("a void variable");
+        return;
+    }
+
+    ::llvm::AllocaInst *slot = entry_alloca(type, name);
+
+    builder.CreateStore(value.value != nullptr ? value.value
+                                               : ::llvm::Constant::getNullValue(type.type),
+                        slot);
+
+    scopes.back()[name] = Local{.slot = slot, .type = type};
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_assignment(const __AST_NODE::BinaryExpr &node) {
+    const auto slot = lower_address(node.lhs);
+
+    if (!slot.has_value()) {
+        return;
+    }
+
+    TypedValue value = lower_expr(node.rhs);
+
+    if (!ok()) {
+        return;
+    }
+
+    if (node.op.token_kind() != __TOKEN_N::OPERATOR_ASSIGN) {
+        const auto op = compound_operator(node.op.token_kind());
+
+        if (!op.has_value()) {
+            unsupported("operator " + node.op.value());
+            return;
+        }
+
+        // `a += b` is `a = a + b`, the token only carries the kind and the text for errors
+        const __TOKEN_N::Token binary(*op, node.op.file_name(), node.op.value());
+
+        value = arithmetic(binary,
+                           {builder.CreateLoad(slot->type.type, slot->slot), slot->type},
+                           value);
+
+        if (!ok()) {
+            return;
+        }
+    }
+
+    const auto converted = convert(value, slot->type);
+
+    if (!converted.has_value()) {
+        unsupported("assignment from an unrelated type");
+        return;
+    }
+
+    builder.CreateStore(converted->value, slot->slot);
+    result = *converted;
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_logical(const __AST_NODE::BinaryExpr &node) {
+    const bool is_and = node.op.token_kind() == __TOKEN_N::OPERATOR_LOGICAL_AND;
+
+    const TypedValue lhs = lower_expr(node.lhs);
+
+    if (!ok()) {
+        return;
+    }
+
+    ::llvm::Value *left = to_bool(lhs);
+
+    if (left == nullptr) {
+        return;
+    }
+
+    ::llvm::BasicBlock *from      = builder.GetInsertBlock();
+    ::llvm::BasicBlock *rhs_block = new_block("logic.rhs");
+    ::llvm::BasicBlock *end       = new_block("logic.end");
+
+    // short circuit, the right side only runs if the left did not decide the result
+    builder.CreateCondBr(left, is_and ? rhs_block : end, is_and ? end : rhs_block);
+    builder.SetInsertPoint(rhs_block);
+
+    const TypedValue rhs = lower_expr(node.rhs);
+
+    if (!ok()) {
+        return;
+    }
+
+    ::llvm::Value *right = to_bool(rhs);
+
+    if (right == nullptr) {
+        return;
+    }
+
+    ::llvm::BasicBlock *rhs_end = builder.GetInsertBlock();
+    builder.CreateBr(end);
+    builder.SetInsertPoint(end);
+
+    ::llvm::PHINode *phi = builder.CreatePHI(::llvm::Type::getInt1Ty(*context), 2);
+    phi->addIncoming(builder.getInt1(!is_and), from);
+    phi->addIncoming(right, rhs_end);
+
+    result = {phi, HelixType{.type = ::llvm::Type::getInt1Ty(*context)}};
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_c_for(const __AST_NODE::ForCStatementCore &node) {
+    scopes.emplace_back();
+
+    if (node.init != nullptr) {
+        node.init->accept(*this);
+    }
+
+    ::llvm::BasicBlock *condition = new_block("for.cond");
+    ::llvm::BasicBlock *body      = new_block("for.body");
+    ::llvm::BasicBlock *update    = new_block("for.inc");
+    ::llvm::BasicBlock *end       = new_block("for.end");
+
+    branch_to(condition);
+    builder.SetInsertPoint(condition);
+
+    if (node.condition != nullptr) {
+        lower_condition_branch(node.condition, false, body, end);
+    } else {
+        builder.CreateBr(body);
+    }
+
+    builder.SetInsertPoint(body);
+    loops.push_back({.continue_to = update, .break_to = end});
+
+    if (node.body != nullptr && ok()) {
+        node.body->accept(*this);
+    }
+
+    loops.pop_back();
+    branch_to(update);
+    builder.SetInsertPoint(update);
+
+    if (node.update != nullptr && ok()) {
+        node.update->accept(*this);
+    }
+
+    builder.CreateBr(condition);
+    builder.SetInsertPoint(end);
+    scopes.pop_back();
+}
+
+void __LLVM_CODEGEN_N::LLVMEmitter::lower_counted_for(const __AST_NODE::ForPyStatementCore &node) {
+    const auto range = node.vars != nullptr && node.vars->vars.size() == 1
+                           ? as_counted_range(node.range)
+                           : std::nullopt;
+
+    if (!range.has_value()) {
+        unsupported("for loop over something other than a range literal");
+        return;
+    }
+
+    const auto &var = node.vars->vars[0];
+
+    // the bounds are evaluated once, before the loop
+    const TypedValue start = lower_expr(range->start);
+    const TypedValue end   = lower_expr(range->end);
+    const TypedValue step  = range->step != nullptr ? lower_expr(range->step) : TypedValue{};
+
+    if (!ok()) {
+        return;
+    }
+
+    std::optional<HelixType> type = var->type != nullptr ? lower_type(var->type)
+                                                          : common_type(start.type, end.type);
+
+    if (!ok()) {
+        return;
+    }
+
+    if (!type.has_value() || !type->is_integer() || type->is_bool()) {
+        unsupported("a range that is not over integers");
+        return;
+    }
+
+    const auto first = convert(start, *type);
+    const auto last  = convert(end, *type);
+    const auto by    = range->step != nullptr
+                           ? convert(step, *type)
+                           : TypedValue{::llvm::ConstantInt::get(type->type, 1), *type};
+
+    if (!first.has_value() || !last.has_value() || !by.has_value()) {
+        unsupported("a range with bounds of unrelated types");
+        return;
+    }
+
+    // a step only known at run time is checked by the cx-ir lowering, which can throw
+    const auto *constant_step = ::llvm::dyn_cast<::llvm::ConstantInt>(by->value);
+
+    if (constant_step == nullptr ||
+        (type->is_signed ? !constant_step->getValue().isStrictlyPositive()
+                         : constant_step->isZero())) {
+        unsupported("a range with a step that is not a positive constant");
+        return;
+    }
+
+    const std::string   name = var->path->name.value();
+    ::llvm::AllocaInst *slot = entry_alloca(*type, name);
+    builder.CreateStore(first->value, slot);
+
+    ::llvm::BasicBlock *body   = new_block("range.body");
+    ::llvm::BasicBlock *update = new_block("range.inc");
+    ::llvm::BasicBlock *next   = new_block("range.next");
+    ::llvm::BasicBlock *done   = new_block("range.end");
+
+    const auto below = [&](::llvm::Value *lhs, ::llvm::Value *rhs, bool or_equal) {
+        if (type->is_signed) {
+            return or_equal ? builder.CreateICmpSLE(lhs, rhs) : builder.CreateICmpSLT(lhs, rhs);
+        }
+
+        return or_equal ? builder.CreateICmpULE(lhs, rhs) : builder.CreateICmpULT(lhs, rhs);
+    };
+
+    builder.CreateCondBr(below(first->value, last->value, range->inclusive), body, done);
+
+    builder.SetInsertPoint(body);
+    scopes.emplace_back();
+    scopes.back()[name] = Local{.slot = slot, .type = *type};
+    loops.push_back({.continue_to = update, .break_to = done});
+
+    if (node.body != nullptr) {
+        node.body->accept(*this);
+    }
+
+    loops.pop_back();
+    scopes.pop_back();
+    branch_to(update);
+
+    // the next value is only computed when it is still in the range, so `0..=255` over u8 or a
+    // step past the maximum ends the loop instead of wrapping around. the distance to the end
+    // is unsigned, it does not overflow for a range wider than the signed maximum
+    builder.SetInsertPoint(update);
+    ::llvm::Value *index    = builder.CreateLoad(type->type, slot, name);
+    ::llvm::Value *distance = builder.CreateSub(last->value, index);
+    ::llvm::Value *fits     = range->inclusive ? builder.CreateICmpULE(by->value, distance)
+                                               : builder.CreateICmpULT(by->value, distance);
+
+    builder.CreateCondBr(
+        builder.CreateAnd(below(index, last->value, false), fits), next, done);
+
+    builder.SetInsertPoint(next);
+    builder.CreateStore(builder.CreateAdd(index, by->value), slot);
+    builder.CreateBr(body);
+
+    builder.SetInsertPoint(done);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+LLVM_VISIT_IMPL(Program) { lower(node); }
+
+LLVM_VISIT_IMPL(LiteralExpr) {
+    if (node.contains_format_args) {
+        unsupported("format strings");
+        return;
+    }
+
+    std::string text = node.value.value();
+
+    switch (node.type) {
+        case __AST_NODE::LiteralExpr::LiteralType::Boolean:
+            result = {builder.getInt1(text == "true"),
+                      HelixType{.type = ::llvm::Type::getInt1Ty(*context)}};
+            return;
+
+        case __AST_NODE::LiteralExpr::LiteralType::Integer: {
+            std::erase(text, '_');
+
+            ::llvm::APInt value;
+
+            // radix 0 takes the 0x, 0b and 0o prefixes, a suffix makes the literal unsupported
+            if (::llvm::StringRef(text).getAsInteger(0, value)) {
+                unsupported("integer literal " + text);
+                return;
+            }
+
+            // like c++, an int unless the value needs a long
+            const unsigned bits = value.getActiveBits() < 32 ? 32 : 64;
+
+            if (value.getActiveBits() >= 64) {
+                unsupported("integer literal " + text + " wider than 64 bits");
+                return;
+            }
+
+            ::llvm::Type *type = ::llvm::Type::getIntNTy(*context, bits);
+
+            result = {::llvm::ConstantInt::get(*context, value.zextOrTrunc(bits)),
+                      HelixType{.type = type, .is_signed = true}};
+            return;
+        }
+
+        case __AST_NODE::LiteralExpr::LiteralType::Float: {
+            std::erase(text, '_');
+
+            const bool single = !text.empty() && (text.back() == 'f' || text.back() == 'F');
+
+            if (single) {
+                text.pop_back();
+            }
+
+            double     value  = 0;
+            const auto parsed = std::from_chars(text.data(), text.data() + text.size(), value);
+
+            if (parsed.ec != std::errc{} || parsed.ptr != text.data() + text.size()) {
+                unsupported("float literal " + text);
+                return;
+            }
+
+            ::llvm::Type *type =
+                single ? ::llvm::Type::getFloatTy(*context) : ::llvm::Type::getDoubleTy(*context);
+
+            result = {::llvm::ConstantFP::get(type, value),
+                      HelixType{.type = type, .is_signed = true}};
+            return;
+        }
+
+        case __AST_NODE::LiteralExpr::LiteralType::Char:
+            // a single plain character, escapes are left to cx-ir
+            if (text.size() == 3 && text[1] != '\\') {
+                result = {builder.getInt8(static_cast<u8>(text[1])),
+                          HelixType{.type = ::llvm::Type::getInt8Ty(*context), .is_signed = true}};
+                return;
+            }
+
+            unsupported("char literal " + text);
+            return;
+
+        case __AST_NODE::LiteralExpr::LiteralType::String:
+        case __AST_NODE::LiteralExpr::LiteralType::Null:
+            break;
+    }
+
+    unsupported("string and null literals");
+}
+
+LLVM_VISIT_IMPL(BinaryExpr) {
+    switch (node.op.token_kind()) {
+        case __TOKEN_N::OPERATOR_ASSIGN:
+            lower_assignment(node);
+            return;
+
+        case __TOKEN_N::OPERATOR_LOGICAL_AND:
+        case __TOKEN_N::OPERATOR_LOGICAL_OR:
+            lower_logical(node);
+            return;
+
+        default:
+            if (compound_operator(node.op.token_kind()).has_value()) {
+                lower_assignment(node);
+                return;
+            }
+
+            break;
+    }
+
+    const TypedValue lhs = lower_expr(node.lhs);
+    const TypedValue rhs = lower_expr(node.rhs);
+
+    if (!ok()) {
+        return;
+    }
+
+    result = arithmetic(node.op, lhs, rhs);
+}
+
+LLVM_VISIT_IMPL(UnaryExpr) {
+    if (node.in_type) {
+        unsupported("pointer and reference types");
+        return;
+    }
+
+    const __TOKEN_N::tokens kind = node.op.token_kind();
+
+    if (kind == __TOKEN_N::OPERATOR_INC || kind == __TOKEN_N::OPERATOR_DEC) {
+        const auto slot = lower_address(node.opd);
+
+        if (!slot.has_value()) {
+            return;
+        }
+
+        if (slot->type.is_bool() || !(slot->type.is_integer() || slot->type.is_float())) {
+            unsupported("++ or -- on a non arithmetic value");
+            return;
+        }
+
+        ::llvm::Value *old  = builder.CreateLoad(slot->type.type, slot->slot);
+        ::llvm::Value *step = slot->type.is_float() ? ::llvm::ConstantFP::get(slot->type.type, 1.0)
+                                                    : ::llvm::ConstantInt::get(slot->type.type, 1);
+        ::llvm::Value *updated = nullptr;
+
+        if (kind == __TOKEN_N::OPERATOR_INC) {
+            updated = slot->type.is_float() ? builder.CreateFAdd(old, step)
+                                            : builder.CreateAdd(old, step);
+        } else {
+            updated = slot->type.is_float() ? builder.CreateFSub(old, step)
+                                            : builder.CreateSub(old, step);
+        }
+
+        builder.CreateStore(updated, slot->slot);
+
+        result = {node.type == __AST_NODE::UnaryExpr::PosType::PreFix ? updated : old, slot->type};
+        return;
+    }
+
+    const TypedValue operand = lower_expr(node.opd);
+
+    if (!ok()) {
+        return;
+    }
+
+    if (kind == __TOKEN_N::OPERATOR_LOGICAL_NOT) {
+        ::llvm::Value *truth = to_bool(operand);
+
+        if (truth != nullptr) {
+            result = {builder.CreateNot(truth),
+                      HelixType{.type = ::llvm::Type::getInt1Ty(*context)}};
+        }
+
+        return;
+    }
+
+    const auto type = common_type(operand.type, operand.type);  // the promoted type
+
+    if (!type.has_value()) {
+        unsupported("operator " + node.op.value() + " on a non arithmetic value");
+        return;
+    }
+
+    const auto promoted = convert(operand, *type);
+
+    switch (kind) {
+        case __TOKEN_N::OPERATOR_ADD:
+            result = *promoted;
+            return;
+
+        case __TOKEN_N::OPERATOR_SUB:
+            result = {type->is_float() ? builder.CreateFNeg(promoted->value)
+                                       : builder.CreateNeg(promoted->value),
+                      *type};
+            return;
+
+        case __TOKEN_N::OPERATOR_BITWISE_NOT:
+            if (!type->is_float()) {
+                result = {builder.CreateNot(promoted->value), *type};
+                return;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    unsupported("unary operator " + node.op.value());
+}
+
+LLVM_VISIT_IMPL(IdentExpr) {
+    const std::string name = node.name.value();
+
+    if (Local *local = find_local(name); local != nullptr) {
+        result = {builder.CreateLoad(local->type.type, local->slot, name), local->type};
+        return;
+    }
+
+    unsupported("unknown name " + name);
+}
+
+LLVM_VISIT_IMPL(DotPathExpr) {
+    const auto field = simple_name(node.rhs);
+
+    if (!field.has_value()) {
+        unsupported("method calls");
+        return;
+    }
+
+    // a field of a local is read in place, anything else is a temporary struct value
+    if (addressable(node.lhs)) {
+        const auto base = lower_address(node.lhs);
+
+        if (!base.has_value()) {
+            return;
+        }
+
+        if (base->type.layout == nullptr) {
+            unsupported("member access on a non struct");
+            return;
+        }
+
+        const auto index = base->type.layout->field(*field);
+
+        if (!index.has_value()) {
+            unsupported("unknown field " + *field);
+            return;
+        }
+
+        const HelixType &type = base->type.layout->field_types[*index];
+        ::llvm::Value   *slot =
+            builder.CreateStructGEP(base->type.layout->type, base->slot, *index, *field);
+
+        result = {builder.CreateLoad(type.type, slot, *field), type};
+        return;
+    }
+
+    const TypedValue base = lower_expr(node.lhs);
+
+    if (!ok()) {
+        return;
+    }
+
+    if (base.type.layout == nullptr) {
+        unsupported("member access on a non struct");
+        return;
+    }
+
+    const auto index = base.type.layout->field(*field);
+
+    if (!index.has_value()) {
+        unsupported("unknown field " + *field);
+        return;
+    }
+
+    result = {builder.CreateExtractValue(base.value, *index, *field),
+              base.type.layout->field_types[*index]};
+}
+
+LLVM_VISIT_IMPL(PathExpr) {
+    if (node.type != __AST_NODE::PathExpr::PathType::Identifier) {
+        unsupported("scoped names");
+        return;
+    }
+
+    result = lower_expr(node.path);
+}
+
+LLVM_VISIT_IMPL(FunctionCallExpr) {
+    const auto name = simple_name(node.path);
+
+    if (!name.has_value() || node.generic != nullptr) {
+        unsupported("calls to scoped or generic functions");
+        return;
+    }
+
+    const auto found = functions.find(*name);
+
+    if (found == functions.end()) {
+        unsupported("call to " + *name + " which is not a helix function in this file");
+        return;
+    }
+
+    const FunctionInfo        &callee = found->second;
+    const __AST_N::NodeV<>    &given  = node.args != nullptr ? node.args->args : __AST_N::NodeV<>{};
+    std::vector<::llvm::Value *> args;
+
+    if (given.size() > callee.params.size()) {
+        unsupported("too many arguments to " + *name);
+        return;
+    }
+
+    for (size_t i = 0; i < callee.params.size(); ++i) {
+        __AST_N::NodeT<> value;
+
+        if (i < given.size()) {
+            if (given[i]->getNodeType() != __AST_NODE::nodes::ArgumentExpr) {
+                unsupported("keyword arguments");
+                return;
+            }
+
+            value = __AST_NODE::Node::as<__AST_NODE::ArgumentExpr>(given[i])->value;
+        } else {
+            value = callee.decls[i]->value;  // the default, evaluated at the call like in c++
+        }
+
+        if (value == nullptr) {
+            unsupported("too few arguments to " + *name);
+            return;
+        }
+
+        const TypedValue arg = lower_expr(value);
+
+        if (!ok()) {
+            return;
+        }
+
+        const auto converted = convert(arg, callee.params[i]);
+
+        if (!converted.has_value()) {
+            unsupported("argument of an unrelated type to " + *name);
+            return;
+        }
+
+        args.push_back(converted->value);
+    }
+
+    result = {builder.CreateCall(callee.function, args), callee.returns};
+}
+
+LLVM_VISIT_IMPL(ObjInitExpr) {
+    const auto name = simple_name(node.path);
+
+    if (!name.has_value() || !structs.contains(*name)) {
+        unsupported("initializer of something other than a struct");
+        return;
+    }
+
+    const StructLayout &layout = structs.at(*name);
+
+    // fields that are not named are value initialized, which is zero for everything here
+    ::llvm::Value *value = ::llvm::Constant::getNullValue(layout.type);
+
+    for (const auto &kwarg : node.kwargs) {
+        const std::string field = kwarg->name->name.value();
+        const auto        index = layout.field(field);
+
+        if (!index.has_value()) {
+            unsupported("unknown field " + field);
+            return;
+        }
+
+        const TypedValue member = lower_expr(kwarg->value);
+
+        if (!ok()) {
+            return;
+        }
+
+        const auto converted = convert(member, layout.field_types[*index]);
+
+        if (!converted.has_value()) {
+            unsupported("field " + field + " initialized from an unrelated type");
+            return;
+        }
+
+        value = builder.CreateInsertValue(value, converted->value, *index);
+    }
+
+    result = {value, HelixType{.type = layout.type, .layout = &layout}};
+}
+
+LLVM_VISIT_IMPL(TernaryExpr) {
+    ::llvm::BasicBlock *if_true  = new_block("select.true");
+    ::llvm::BasicBlock *if_false = new_block("select.false");
+    ::llvm::BasicBlock *end      = new_block("select.end");
+
+    lower_condition_branch(node.condition, false, if_true, if_false);
+
+    builder.SetInsertPoint(if_true);
+    const TypedValue   true_value = lower_expr(node.if_true);
+    ::llvm::BasicBlock *true_end  = builder.GetInsertBlock();
+
+    builder.SetInsertPoint(if_false);
+    const TypedValue   false_value = lower_expr(node.if_false);
+    ::llvm::BasicBlock *false_end  = builder.GetInsertBlock();
+
+    if (!ok()) {
+        return;
+    }
+
+    // the branches end only now, once the type both sides convert to is known
+    std::optional<HelixType> type = true_value.type.type == false_value.type.type
+                                        ? std::optional(true_value.type)
+                                        : common_type(true_value.type, false_value.type);
+
+    if (!type.has_value() || type->type->isVoidTy()) {
+        unsupported("a ternary with branches of unrelated types");
+        return;
+    }
+
+    builder.SetInsertPoint(true_end);
+    const auto true_converted = convert(true_value, *type);
+    builder.CreateBr(end);
+
+    builder.SetInsertPoint(false_end);
+    const auto false_converted = convert(false_value, *type);
+    builder.CreateBr(end);
+
+    builder.SetInsertPoint(end);
+
+    ::llvm::PHINode *phi = builder.CreatePHI(type->type, 2);
+    phi->addIncoming(true_converted->value, true_end);
+    phi->addIncoming(false_converted->value, false_end);
+
+    result = {phi, *type};
+}
+
+LLVM_VISIT_IMPL(ParenthesizedExpr) { result = lower_expr(node.value); }
+
+LLVM_VISIT_IMPL(CastExpr) {
+    const TypedValue value = lower_expr(node.value);
+
+    if (!ok()) {
+        return;
+    }
+
+    const auto type = lower_type(node.type);
+
+    if (!type.has_value()) {
+        return;
+    }
+
+    const auto converted = convert(value, *type);
+
+    if (!converted.has_value()) {
+        unsupported("cast between unrelated types");
+        return;
+    }
+
+    result = *converted;
+}
+
+LLVM_VISIT_IMPL(ForState) {
+    if (node.parallel) {
+        unsupported("parallel for, it needs the task pool of the prelude");
+        return;
+    }
+
+    if (node.type == __AST_NODE::ForState::ForType::C) {
+        lower_c_for(*__AST_NODE::Node::as<__AST_NODE::ForCStatementCore>(node.core));
+    } else {
+        lower_counted_for(*__AST_NODE::Node::as<__AST_NODE::ForPyStatementCore>(node.core));
+    }
+}
+
+LLVM_VISIT_IMPL(WhileState) {
+    ::llvm::BasicBlock *condition = new_block("while.cond");
+    ::llvm::BasicBlock *body      = new_block("while.body");
+    ::llvm::BasicBlock *end       = new_block("while.end");
+
+    builder.CreateBr(condition);
+    builder.SetInsertPoint(condition);
+    lower_condition_branch(node.condition, false, body, end);
+
+    builder.SetInsertPoint(body);
+    loops.push_back({.continue_to = condition, .break_to = end});
+
+    if (node.body != nullptr && ok()) {
+        node.body->accept(*this);
+    }
+
+    loops.pop_back();
+    branch_to(condition);
+    builder.SetInsertPoint(end);
+}
+
+LLVM_VISIT_IMPL(IfState) {
+    ::llvm::BasicBlock *end  = new_block("if.end");
+    ::llvm::BasicBlock *then = new_block("if.then");
+    ::llvm::BasicBlock *next = new_block("if.else");
+
+    lower_condition_branch(
+        node.condition, node.type == __AST_NODE::IfState::IfType::Unless, then, next);
+
+    builder.SetInsertPoint(then);
+
+    if (node.body != nullptr && ok()) {
+        node.body->accept(*this);
+    }
+
+    branch_to(end);
+
+    for (const auto &branch : node.else_body) {
+        if (!ok()) {
+            return;
+        }
+
+        builder.SetInsertPoint(next);
+
+        if (branch->type == __AST_NODE::ElseState::ElseType::Else) {
+            if (branch->body != nullptr) {
+                branch->body->accept(*this);
+            }
+
+            branch_to(end);
+            next = nullptr;
+            break;
+        }
+
+        then = new_block("if.then");
+        next = new_block("if.else");
+
+        lower_condition_branch(branch->condition,
+                               branch->type == __AST_NODE::ElseState::ElseType::ElseUnless,
+                               then,
+                               next);
+
+        builder.SetInsertPoint(then);
+
+        if (branch->body != nullptr && ok()) {
+            branch->body->accept(*this);
+        }
+
+        branch_to(end);
+    }
+
+    if (next != nullptr) {
+        builder.SetInsertPoint(next);
+        builder.CreateBr(end);
+    }
+
+    builder.SetInsertPoint(end);
+}
+
+LLVM_VISIT_IMPL(ReturnState) {
+    ::llvm::Type *returns = current->function->getReturnType();
+
+    if (node.value == nullptr || current->returns_void) {
+        if (node.value != nullptr) {
+            unsupported("returning a value from a void function");
+            return;
+        }
+
+        if (returns->isVoidTy()) {
+            builder.CreateRetVoid();
+        } else {
+            builder.CreateRet(::llvm::ConstantInt::get(returns, 0));  // void main
+        }
+
+        start_dead_block();
+        return;
+    }
+
+    const TypedValue value = lower_expr(node.value);
+
+    if (!ok()) {
+        return;
+    }
+
+    const auto converted = convert(value, current->returns);
+
+    if (!converted.has_value()) {
+        unsupported("returning an unrelated type");
+        return;
+    }
+
+    builder.CreateRet(converted->value);
+    start_dead_block();
+}
+
+LLVM_VISIT_IMPL(BreakState) {
+    if (loops.empty()) {
+        unsupported("break outside of a loop");
+        return;
+    }
+
+    builder.CreateBr(loops.back().break_to);
+    start_dead_block();
+}
+
+LLVM_VISIT_IMPL(ContinueState) {
+    if (loops.empty()) {
+        unsupported("continue outside of a loop");
+        return;
+    }
+
+    builder.CreateBr(loops.back().continue_to);
+    start_dead_block();
+}
+
+LLVM_VISIT_IMPL(BlockState) {
+    scopes.emplace_back();
+
+    for (const auto &statement : node.body) {
+        if (!ok()) {
+            break;
+        }
+
+        statement->accept(*this);
+    }
+
+    scopes.pop_back();
+}
+
+LLVM_VISIT_IMPL(SuiteState) {
+    if (node.body != nullptr) {
+        node.body->accept(*this);
+    }
+}
+
+LLVM_VISIT_IMPL(ExprState) { lower_expr(node.value); }
+
+LLVM_VISIT_IMPL(StructDecl) {}  // declared by lower() before any function
+
+LLVM_VISIT_IMPL(FuncDecl) {
+    FunctionInfo &info = functions.at(node.name->get_back_name().value());
+
+    if (node.body == nullptr) {
+        return;  // defined elsewhere, the declaration is all there is
+    }
+
+    current = &info;
+    scopes.assign(1, {});
+    builder.SetInsertPoint(::llvm::BasicBlock::Create(*context, "entry", info.function));
+
+    for (size_t i = 0; i < info.params.size(); ++i) {
+        ::llvm::Argument  *arg  = info.function->getArg(static_cast<unsigned>(i));
+        const std::string  name = arg->getName().str();
+        ::llvm::AllocaInst *slot = entry_alloca(info.params[i], name);
+
+        builder.CreateStore(arg, slot);
+        scopes.back()[name] = Local{.slot = slot, .type = info.params[i]};
+    }
+
+    node.body->accept(*this);
+
+    if (ok() && builder.GetInsertBlock()->getTerminator() == nullptr) {
+        ::llvm::BasicBlock *block   = builder.GetInsertBlock();
+        ::llvm::Type       *returns = info.function->getReturnType();
+
+        // falling off the end returns nothing, 0 from main, and is an error everywhere else. a
+        // block nothing branches to (after an if whose every arm returns) is never reached
+        if (returns->isVoidTy()) {
+            builder.CreateRetVoid();
+        } else if (info.function->getName() == "main") {
+            builder.CreateRet(::llvm::ConstantInt::get(returns, 0));
+        } else if (block != &info.function->getEntryBlock() && ::llvm::pred_empty(block)) {
+            builder.CreateUnreachable();
+        } else {
+            const __TOKEN_N::Token name = node.name->get_back_name();
+
+            CODEGEN_ERROR(name, "function '" + name.value() +
+                                    "' can reach its end without returning a value");
+            unsupported("function without a return on every path");
+        }
+    }
+
+    current = nullptr;
+    scopes.clear();
+}
+
+LLVM_VISIT_IMPL(VarDecl) { lower_var(node); }
+
+LLVM_VISIT_IMPL(LetDecl) {
+    if (!node.modifiers.empty()) {
+        unsupported("let with modifiers");
+        return;
+    }
+
+    for (const auto &var : node.vars) {
+        if (!ok()) {
+            return;
+        }
+
+        lower_var(*var);
+    }
+}
+
+LLVM_VISIT_IMPL(ConstDecl) {
+    if (!node.modifiers.empty()) {
+        unsupported("const with modifiers");
+        return;
+    }
+
+    for (const auto &var : node.vars) {
+        if (!ok()) {
+            return;
+        }
+
+        lower_var(*var);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// everything below is outside the subset, or only ever reached through the nodes above
+
+#define LLVM_UNSUPPORTED(type) \
+    LLVM_VISIT_IMPL(type) { unsupported(node.getNodeName()); }
+
+LLVM_UNSUPPORTED(NamedArgumentExpr)
+LLVM_UNSUPPORTED(ArgumentExpr)
+LLVM_UNSUPPORTED(ArgumentListExpr)
+LLVM_UNSUPPORTED(GenericInvokeExpr)
+LLVM_UNSUPPORTED(GenericInvokePathExpr)
+LLVM_UNSUPPORTED(ScopePathExpr)
+LLVM_UNSUPPORTED(ArrayAccessExpr)
+LLVM_UNSUPPORTED(ArrayLiteralExpr)
+LLVM_UNSUPPORTED(TupleLiteralExpr)
+LLVM_UNSUPPORTED(SetLiteralExpr)
+LLVM_UNSUPPORTED(MapPairExpr)
+LLVM_UNSUPPORTED(MapLiteralExpr)
+LLVM_UNSUPPORTED(LambdaExpr)
+LLVM_UNSUPPORTED(InstOfExpr)
+LLVM_UNSUPPORTED(AsyncThreading)
+LLVM_UNSUPPORTED(Type)
+LLVM_UNSUPPORTED(NamedVarSpecifier)
+LLVM_UNSUPPORTED(NamedVarSpecifierList)
+LLVM_UNSUPPORTED(ForPyStatementCore)
+LLVM_UNSUPPORTED(ForCStatementCore)
+LLVM_UNSUPPORTED(ElseState)
+LLVM_UNSUPPORTED(SwitchCaseState)
+LLVM_UNSUPPORTED(SwitchState)
+LLVM_UNSUPPORTED(YieldState)
+LLVM_UNSUPPORTED(DeleteState)
+LLVM_UNSUPPORTED(AliasState)
+LLVM_UNSUPPORTED(SingleImportState)
+LLVM_UNSUPPORTED(MultiImportState)
+LLVM_UNSUPPORTED(ImportState)
+LLVM_UNSUPPORTED(CatchState)
+LLVM_UNSUPPORTED(FinallyState)
+LLVM_UNSUPPORTED(TryState)
+LLVM_UNSUPPORTED(WithState)
+LLVM_UNSUPPORTED(PanicState)
+LLVM_UNSUPPORTED(RequiresParamDecl)
+LLVM_UNSUPPORTED(RequiresParamList)
+LLVM_UNSUPPORTED(EnumMemberDecl)
+LLVM_UNSUPPORTED(UDTDeriveDecl)
+LLVM_UNSUPPORTED(TypeBoundList)
+LLVM_UNSUPPORTED(TypeBoundDecl)
+LLVM_UNSUPPORTED(RequiresDecl)
+LLVM_UNSUPPORTED(ModuleDecl)
+LLVM_UNSUPPORTED(ClassDecl)
+LLVM_UNSUPPORTED(InterDecl)
+LLVM_UNSUPPORTED(EnumDecl)
+LLVM_UNSUPPORTED(TypeDecl)
+LLVM_UNSUPPORTED(FFIDecl)
+LLVM_UNSUPPORTED(OpDecl)
+
+#undef LLVM_UNSUPPORTED
@@ -14,6 +14,8 @@
 
 #include "controller/include/config/Controller_config.def"
 #include "controller/include/shared/file_system.hh"
+#include "controller/include/shared/object_cache.hh"
+#include "controller/include/shared/prelude_cache.hh"
 #include "parser/ast/include/private/base/AST_base.hh"
 #include "parser/ast/include/types/AST_jsonify_visitor.hh"
 #include "parser/ast/include/types/AST_types.hh"
@@ -31,15 +33,23 @@
 #include <array>
 #include <chrono>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <neo-panic/include/error.hh>
 #include <neo-pprint/include/hxpprint.hh>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "controller/include/Controller.hh"
+#include "controller/include/jobs/job_pool.hh"
+#include "controller/include/tooling/clang_backend.hh"
+#include "controller/include/tooling/diagnostics.hh"
+#include "controller/include/tooling/jit.hh"
+#include "controller/include/tooling/toolchain.hh"
 #include "generator/include/CX-IR/CXIR.hh"
+#include "generator/include/llvm_emitter.hh"
 #include "lexer/include/lexer.hh"
 #include "parser/preprocessor/include/preprocessor.hh"
 
@@ -119,61 +129,303 @@ class CXIRCompiler {
     }
 #endif
 
+    /// the header shared by the units of a split program, see CXIR::split_units
+    static constexpr const char *split_header_name = "_H1HJA9ZLO_17.helix-compiler.hh";
+
+    [[nodiscard]] const __CONTROLLER_FS_N::ObjectCache &get_cache() const { return cache; }
+
+    /// `toolchain` is the --toolchain spec, empty to use the built in clang or the host compiler
     void compile_CXIR(generator::CXIR::CXIR &emitter,
                       const std::string     &out,
                       bool                   is_debug   = false,
-                      bool                   is_verbose = false) const {
+                      bool                   is_verbose = false,
+                      size_t                 jobs       = 0,
+                      const std::string     &toolchain  = "") const {
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
-        compile_CXIR_Windows(emitter, out, is_debug);
+        compile_CXIR_Windows(emitter, out, is_debug, toolchain);
 #else
-        compile_CXIR_NonWindows(emitter, out, is_debug, is_verbose);
+        compile_CXIR_NonWindows(emitter, out, is_debug, is_verbose, jobs, toolchain);
 #endif
     }
 
+#if !defined(_WIN32) && !defined(WIN32) && !defined(_WIN64) && !defined(WIN64)
+    /// what became of a program lowered straight to llvm ir
+    enum class LLVMBuild : char { LINKED, FALLBACK, FAILED };
+
+    /// write the object of an already lowered module and link it, with lld if clang is built in
+    /// and the host compiler otherwise. FALLBACK if nothing was linked yet and cx-ir should be
+    /// used instead, FAILED once a linker ran and rejected the object
+    LLVMBuild compile_LLVM(__LLVM_CODEGEN_N::LLVMEmitter &emitter,
+                           const std::string             &out,
+                           bool                           is_verbose) const {
+        using Backend = __CONTROLLER_TOOL_N::ClangBackend;
+
+        const std::filesystem::path path = __CONTROLLER_FS_N::get_cwd();
+
+        // in the temporary directory and unique, two builds from one directory must not share it
+        std::error_code       err;
+        std::filesystem::path object = __CONTROLLER_FS_N::temporary_sibling(
+            std::filesystem::temp_directory_path(err) / "_H1HJA9ZLO_17.helix-compiler");
+        object += ".o";
+
+        if (err) {
+            log<LogLevel::Warning>("creating temporary file: ", err.message());
+            return LLVMBuild::FALLBACK;
+        }
+
+        std::string error;
+        std::string output;
+        bool        linked = false;
+
+        if (!emitter.emit_object(object.string(), error)) {
+            log<LogLevel::Warning>("could not write the llvm object: " + error);
+            return LLVMBuild::FALLBACK;
+        }
+
+        // the module only calls itself, no prelude or c++ runtime to link against
+        if (Backend::available()) {
+            auto result = Backend::link({object}, path / out, {});
+
+            linked = result.success;
+            output = std::move(result.output);
+        } else if (const auto toolchain = __CONTROLLER_TOOL_N::Toolchain::discover();
+                   toolchain.has_value()) {
+            auto result = exec("\"" + toolchain->path.string() + "\" \"" + object.string() +
+                               "\" -o \"" + (path / out).string() + "\" 2>&1");
+
+            linked = result.return_code == 0;
+            output = std::move(result.output);
+        } else {
+            std::filesystem::remove(object, err);
+            log<LogLevel::Warning>("no linker for the llvm object, compiling through cx-ir");
+            return LLVMBuild::FALLBACK;
+        }
+
+        std::filesystem::remove(object, err);
+
+        // a linker that rejects the object has the last word, cx-ir would only hide its error
+        // behind a second, slower build of the same program
+        if (!linked) {
+            log<LogLevel::Error>("could not link the llvm object:\n" + output);
+            return LLVMBuild::FAILED;
+        }
+
+        if (is_verbose && !output.empty()) {
+            log<LogLevel::Debug>(output);
+        }
+
+        log<LogLevel::Info>("compiled successfully to " + (path / out).string());
+        return LLVMBuild::LINKED;
+    }
+
+    /// compile the cx-ir to llvm ir in memory with the built in clang, for --run
+    bool compile_CXIR_to_module(generator::CXIR::CXIR         &emitter,
+                                bool                           is_debug,
+                                ::llvm::orc::ThreadSafeModule &module) const {
+        using Backend = __CONTROLLER_TOOL_N::ClangBackend;
+
+        if (!Backend::available()) {
+            log<LogLevel::Error>("--run needs the built in clang, its resource directory was not "
+                                 "found");
+            return false;
+        }
+
+        const std::filesystem::path path        = __CONTROLLER_FS_N::get_cwd();
+        const std::filesystem::path source_file = path / "_H1HJA9ZLO_17.helix-compiler.cc";
+
+        // orc shares one copy of a thread_local between all threads, the prelude keeps its per
+        // thread state in pthread keys instead and print writes every call right away
+        const std::vector<std::string> codegen_flags = {"-std=c++23",
+                                                        is_debug ? "-g" : "-O2",
+                                                        "-fno-omit-frame-pointer",
+                                                        "-D_H1HJA9ZLO_NO_THREAD_LOCALS"};
+        std::vector<std::string>       compile_flags = codegen_flags;
+
+        if (!prepare_prelude_in_process(codegen_flags, compile_flags)) {
+            return false;
+        }
+
+        std::ostringstream cxir;
+        emitter.write_CXIR(cxir);
+
+        const std::string source = std::move(cxir).str();
+        const auto        result =
+            Backend::compile_to_module(source_file, {{source_file, source}}, compile_flags, module);
+
+        if (!result.success) {
+            report_diagnostics(result.diagnostics);
+            log<LogLevel::Error>("compilation failed");
+            return false;
+        }
+
+        log<LogLevel::Info>("compiled cxir to llvm ir in memory");
+        return true;
+    }
+#endif
+
   private:
+    /// compiled outputs from previous runs, a cache so it is mutable
+    mutable __CONTROLLER_FS_N::ObjectCache cache;
+
+    /// stream the cx-ir straight into the file the c++ compiler reads, the emitted c++ is never
+    /// held in memory as a whole
+    static bool write_source_file(const std::filesystem::path                &source_file,
+                                  const std::function<void(std::ostream &)> &write) {
+        std::array<char, 1 << 16> buffer{};
+        std::ofstream             file;
+
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());  // must precede open()
+        file.open(source_file);
+
+        if (!file) {
+            return false;
+        }
+
+        write(file);
+        file.close();
+
+        return !file.fail();
+    }
+
+    /// make sure the prelude header is in the cache and try to precompile it, a missing pch is
+    /// not an error since the compiler falls back to parsing the header
+    bool prepare_prelude(const __CONTROLLER_FS_N::PreludeCache &prelude,
+                         const std::string                     &compiler,
+                         const std::string                     &codegen_flags,
+                         bool                                   is_clang,
+                         bool                                   is_verbose) const {
+        if (!prelude.ensure_header()) {
+            return false;
+        }
+
+        if (prelude.has_pch(is_clang)) {
+            return true;
+        }
+
+        const std::filesystem::path pch = prelude.pch(is_clang);
+        const std::filesystem::path tmp = __CONTROLLER_FS_N::temporary_sibling(pch);
+
+        log<LogLevel::Info>("precompiling the prelude into " + pch.string());
+
+        auto result = exec(compiler + " " + codegen_flags + "-x c++-header \"" +
+                           prelude.header().string() + "\" -o \"" + tmp.string() + "\" 2>&1");
+
+        std::error_code err;
+
+        if (result.return_code == 0) {
+            std::filesystem::rename(tmp, pch, err);  // another build may have won the race
+        }
+
+        if (result.return_code != 0 || err) {
+            std::filesystem::remove(tmp, err);
+            log<LogLevel::Warning>("could not precompile the prelude, it will be parsed instead");
+
+            if (is_verbose) {
+                log<LogLevel::Debug>(result.output);
+            }
+        }
+
+        return true;
+    }
+
+    /// prepare_prelude for the built in clang, adds the flags that include the prelude to
+    /// `compile_flags`
+    static bool prepare_prelude_in_process(const std::vector<std::string> &codegen_flags,
+                                           std::vector<std::string>       &compile_flags) {
+        using Backend = __CONTROLLER_TOOL_N::ClangBackend;
+
+        std::string joined;
+
+        for (const auto &flag : codegen_flags) {
+            joined += flag + " ";
+        }
+
+        __CONTROLLER_FS_N::PreludeCache prelude(Backend::version(), joined);
+
+        if (!prelude.ensure_header()) {
+            log<LogLevel::Error>("aborting. could not write the prelude to " +
+                                 prelude.directory().string());
+            return false;
+        }
+
+        if (!prelude.has_pch(true)) {
+            const std::filesystem::path pch = prelude.pch(true);
+            const std::filesystem::path tmp = __CONTROLLER_FS_N::temporary_sibling(pch);
+
+            log<LogLevel::Info>("precompiling the prelude into " + pch.string());
+
+            const auto result = Backend::precompile_header(prelude.header(), tmp, codegen_flags);
+            std::error_code err;
+
+            if (result.success) {
+                std::filesystem::rename(tmp, pch, err);  // another build may have won the race
+            }
+
+            if (!result.success || err) {
+                std::filesystem::remove(tmp, err);
+                log<LogLevel::Warning>(
+                    "could not precompile the prelude, it will be parsed instead");
+            }
+        }
+
+        compile_flags.insert(compile_flags.end(),
+                             {"-I", prelude.directory().string(),
+                              "-include", prelude.header().string()});
+
+        return true;
+    }
+
+    /// the host compiler, probed once and then taken from the toolchain cache
+    static std::optional<__CONTROLLER_TOOL_N::Toolchain> find_toolchain(const std::string &spec) {
+        if (!spec.empty()) {
+            auto toolchain = __CONTROLLER_TOOL_N::Toolchain::from_spec(spec);
+
+            if (!toolchain.has_value()) {
+                log<LogLevel::Error>("can not tell the vendor of '" + spec +
+                                     "', prefix it with 'clang:', 'gcc:' or 'msvc:'");
+            }
+
+            return toolchain;
+        }
+
+        auto toolchain = __CONTROLLER_TOOL_N::Toolchain::discover();
+
+        if (!toolchain.has_value()) {
+            log<LogLevel::Error>("no c++ compiler found, pass one with --toolchain");
+        }
+
+        return toolchain;
+    }
+
     void compile_CXIR_Windows(generator::CXIR::CXIR &emitter,
                               const std::string     &out,
-                              bool                   is_debug) const {
-        std::string           cxx  = emitter.to_CXIR();
+                              bool                   is_debug,
+                              const std::string     &toolchain) const {
         std::filesystem::path path = __CONTROLLER_FS_N::get_cwd();
         std::error_code       ec;
         std::filesystem::path source_file =
             std::filesystem::temp_directory_path(ec) / "_H1HJA9ZLO_17.helix-compiler.cc";
-        std::ofstream file(source_file);
 
         if (ec) {
             log<LogLevel::Error>("creating temporary file: ", ec.message());
             return;
         }
 
-        if (!file) {
+        if (!write_source_file(source_file,
+                               [&](std::ostream &file) { emitter.write_CXIR(file); })) {
             log<LogLevel::Error>("creating ", source_file.string());
             return;
         }
 
-        file << cxx;
-        file.close();
-
         {
-            std::string vswhere_cmd =
-                R"("C:\Program Files (x86)\Microsoft Visual Studio\Installer\vswhere.exe" -latest -products * -requires Microsoft.VisualStudio.Component.VC.Tools.x86.x64 -property installationPath)";
-            auto vs_result = exec(vswhere_cmd);
+            const auto host = find_toolchain(toolchain);
 
-            if (vs_result.return_code != 0 || vs_result.output.empty()) {
-                log<LogLevel::Error>("visual studio not found or vswhere failed");
+            if (!host.has_value() || host->vendor != __CONTROLLER_TOOL_N::Toolchain::Vendor::MSVC) {
+                log<LogLevel::Error>("visual studio not found, only msvc is supported on windows");
                 goto cleanup;
             }
 
-            std::string vs_path = vs_result.output;
-            vs_path.erase(vs_path.find_last_not_of(" \n\r\t") + 1);
-
-            if (!std::filesystem::exists(vs_path)) {
-                log<LogLevel::Error>("visual studio path not found at " + vs_path);
-                goto cleanup;
-            }
-
-            std::filesystem::path msvc_tools_path =
-                std::filesystem::path(vs_path) / "VC" / "Auxiliary" / "Build" / "vcvars64.bat";
+            const std::filesystem::path &msvc_tools_path = host->path;
 
             if (!std::filesystem::exists(msvc_tools_path)) {
                 log<LogLevel::Error>("msvc environment setup script not found at " +
@@ -237,125 +489,134 @@ class CXIRCompiler {
         }
     }
 
-    std::tuple<token::Token, std::string, std::string>
-    parse_clang_err(std::string clang_out) const {
-        std::string filePath;
-        int         lineNumber   = 0;
-        int         columnNumber = 0;
-        std::string message;
-
-        std::istringstream stream(clang_out);
-        std::getline(stream, filePath, ':');  // Extract file path
-        stream >> lineNumber;                 // Extract line number
-        stream.ignore();                      // Ignore the next colon
-        stream >> columnNumber;               // Extract column number
-        stream.ignore();                      // Ignore the next colon
-        std::getline(stream, message);        // Extract the message
-
-        auto pof = token::Token(lineNumber, 0, 1, columnNumber, "/*error*/", filePath, "<other>");
-
-        return {pof, message, filePath};
-    }
-
     void compile_CXIR_NonWindows(generator::CXIR::CXIR &emitter,
                                  const std::string     &out,
                                  bool                   is_debug,
-                                 bool                   is_verbose = false) const {
-        std::string cxx = emitter.to_CXIR();
+                                 bool                   is_verbose,
+                                 size_t                 jobs,
+                                 const std::string     &toolchain) const {
+        // an explicit --toolchain always wins over the built in clang
+        if (toolchain.empty()) {
+            if (__CONTROLLER_TOOL_N::ClangBackend::available()) {
+                compile_CXIR_InProcess(emitter, out, is_debug, is_verbose, jobs);
+                return;
+            }
+
+            log<LogLevel::Warning>("clang resource directory not found, using the system compiler");
+        }
 
         std::filesystem::path path        = __CONTROLLER_FS_N::get_cwd();
         std::filesystem::path source_file = path / "_H1HJA9ZLO_17.helix-compiler.cc";
-        std::ofstream         file(source_file);
 
-        if (!file) {
-            log<LogLevel::Error>("error creating " + source_file.string() + " file");
+        const auto host = find_toolchain(toolchain);
+
+        if (!host.has_value()) {
             return;
         }
 
-        file << cxx;
-        file.close();
+        std::string compiler = "\"" + host->path.string() + "\"";
+        bool        is_clang = host->vendor == __CONTROLLER_TOOL_N::Toolchain::Vendor::Clang;
 
-        std::string compiler        = "c++";
-        auto        compiler_result = exec(compiler + " --version");
-        std::string compile_flags   = "-std=c++23 ";
-        compile_flags += is_debug ? "-g " : "-O2 ";
+        // everything that has to match between the prelude pch and the translation unit
+        std::string codegen_flags = "-std=c++23 ";
+        codegen_flags += is_debug ? "-g " : "-O2 ";
+        codegen_flags += "-fno-omit-frame-pointer ";
 
-        if ((compiler_result.output.find("clang") != std::string::npos) ||
-            (compiler_result.output.find("gcc") != std::string::npos)) {
-            log<LogLevel::Info>(
-                "using system's '" +
-                std::string((compiler_result.output.find("clang") != std::string::npos) ? "clang"
-                                                                                        : "gcc") +
-                "' compiler, with the '" +
-                ((compiler_result.output.find("clang") != std::string::npos) ? "lld" : "ld") +
-                "' linker");
-
-            // -fdiagnostics-format=json << gcc
-            /// -fdiagnostics-show-hotness -fdiagnostics-print-source-range-info  << clang
-            compile_flags += " -fcaret-diagnostics-max-lines=0 -fno-diagnostics-fixit-info "
-                             "-fno-elide-type -fno-diagnostics-show-line-numbers "
-                             "-fno-color-diagnostics -fno-diagnostics-show-option ";
+        std::string compile_flags = codegen_flags;
+        std::string link_flags    = codegen_flags + "-Wl,-w,-rpath,/usr/local/lib ";
+
+        if (is_clang || host->vendor == __CONTROLLER_TOOL_N::Toolchain::Vendor::GCC) {
+            log<LogLevel::Info>("using system's '" + std::string(is_clang ? "clang" : "gcc") +
+                                "' compiler, with the '" + (is_clang ? "lld" : "ld") + "' linker");
+
+            // diagnostics as data, see parse_diagnostics. support for the flags is probed
+            if (host->sarif_diagnostics) {
+                compile_flags += "-fdiagnostics-format=sarif -Wno-sarif-format-unstable ";
+            } else if (host->json_diagnostics) {
+                compile_flags += "-fdiagnostics-format=json ";
+            } else {
+                log<LogLevel::Warning>("the compiler can not write json diagnostics, its "
+                                       "output is shown as is");
+                compile_flags += "-fdiagnostics-color=never ";
+            }
 
         } else {
-            log<LogLevel::Error>("aborting. unknown compiler: " + compiler_result.output);
+            log<LogLevel::Error>("aborting. unsupported compiler: " + host->path.string() + " (" +
+                                 std::string(host->vendor_name()) + ")");
             return;
         }
 
-        compile_flags += "-fno-omit-frame-pointer -Wl,-w,-rpath,/usr/local/lib ";
-        compile_flags += "\"" + source_file.string() + "\" -o \"" + (path / out).string() + "\"";
-
-        auto compile_result = exec("c++ " + compile_flags + " 2>&1");
-
-        if (compile_result.return_code != 0) {
-            std::vector<std::string> lines;
-            std::istringstream       stream(compile_result.output);
+        {
+            __CONTROLLER_FS_N::PreludeCache prelude(host->identity, codegen_flags);
 
-            for (std::string line; std::getline(stream, line);) {
-                if (line.starts_with('/')) {
-                    lines.push_back(line);
-                }
+            if (!prepare_prelude(prelude, compiler, codegen_flags, is_clang, is_verbose)) {
+                log<LogLevel::Error>("aborting. could not write the prelude to " +
+                                     prelude.directory().string());
+                return;
             }
 
-            for (auto &line : lines) {
-                auto err = parse_clang_err(line);
+            // -include is what makes clang use the pch, the include in the cx-ir is then a no-op
+            compile_flags += "-I\"" + prelude.directory().string() + "\" -include \"" +
+                             prelude.header().string() + "\" ";
+        }
 
-                if (!std::filesystem::exists(std::get<2>(err))) {
-                    error::Panic(error::CompilerError{
-                        .err_code     = 0.8245,
-                        .err_fmt_args = {"error at: " + std::get<2>(err) + std::get<1>(err)},
-                    });
+        const auto                        &units = emitter.get_units();
+        std::vector<std::filesystem::path> temporaries;
+        ExecResult                         compile_result;
 
-                    continue;
-                }
+        // everything besides the sources that decides what the compiler produces
+        const std::string identity = host->identity + compile_flags + link_flags;
 
-                std::pair<size_t, size_t> err_t = {std::get<1>(err).find_first_not_of(' '),
-                                                   std::get<1>(err).find(':') -
-                                                       std::get<1>(err).find_first_not_of(' ')};
+        if (units.sources.empty()) {
+            temporaries.push_back(source_file);
 
-                error::Level level = std::map<string, error::Level>{
-                    {"error", error::Level::ERR},                       //
-                    {"warning", error::Level::WARN},                    //
-                    {"note", error::Level::NOTE}                        //
-                }[std::get<1>(err).substr(err_t.first, err_t.second)];  //
+            if (!write_source_file(source_file, [&](std::ostream &file) {
+                    emitter.write_CXIR(file);
+                })) {
+                log<LogLevel::Error>("error creating " + source_file.string() + " file");
+                return;
+            }
 
-                std::string msg = std::get<1>(err).substr(err_t.first + err_t.second + 1);
+            const std::string key = cache.key({source_file}, identity);
 
-                msg = msg.substr(msg.find_first_not_of(' '));
+            if (cache.fetch(key, path / out)) {
+                log<LogLevel::Info>("up to date, reused the cached executable");
+            } else {
+                compile_result = exec(compiler + " " + compile_flags + link_flags + "\"" +
+                                      source_file.string() + "\" -o \"" + (path / out).string() +
+                                      "\" 2>&1");
 
-                error::Panic(error::CodeError{
-                    .pof          = &std::get<0>(err),
-                    .err_code     = 0.8245,
-                    .err_fmt_args = {msg},
-                    .mark_pof     = false,
-                    .level        = level,
-                    .indent       = static_cast<size_t>((level == error::NOTE) ? 1 : 0),
-                });
+                if (compile_result.return_code == 0) {
+                    cache.store(key, path / out);
+                }
             }
+        } else {
+            log<LogLevel::Info>("compiling " + std::to_string(units.sources.size()) +
+                                " translation units in parallel");
+
+            compile_result = compile_units(units,
+                                           path,
+                                           compiler,
+                                           compile_flags,
+                                           link_flags,
+                                           identity,
+                                           path / out,
+                                           jobs,
+                                           temporaries);
+        }
+
+        if (compile_result.return_code != 0) {
+            std::string linker_output;
+            auto        diagnostics =
+                __CONTROLLER_TOOL_N::parse_diagnostics(compile_result.output, &linker_output);
+
+            map_to_helix_source(diagnostics, temporaries);
+            report_diagnostics(diagnostics);
 
             if (is_verbose || !error::HAS_ERRORED) {
                 log<LogLevel::Info>("compilation passed");
-                log<LogLevel::Error>((is_verbose ? "compiler output:\n" : "linker failed. ") +
-                                     compile_result.output);
+                log<LogLevel::Error>(is_verbose ? "compiler output:\n" + compile_result.output
+                                                : "linker failed. " + linker_output);
             } else {
                 log<LogLevel::Error>("compilation failed");
             }
@@ -371,7 +632,318 @@ class CXIRCompiler {
         log<LogLevel::Info>("compiled successfully to " + (path / out).string());
 
     cleanup:
-        std::filesystem::remove(source_file);
+        for (const auto &file : temporaries) {
+            std::error_code err;
+            std::filesystem::remove(file, err);
+        }
+    }
+
+    /// compile with the clang and lld linked into helix, the cx-ir never touches the disk and
+    /// the diagnostics arrive as structured data, see ClangBackend
+    void compile_CXIR_InProcess(generator::CXIR::CXIR &emitter,
+                                const std::string     &out,
+                                bool                   is_debug,
+                                bool                   is_verbose,
+                                size_t                 jobs) const {
+        using Backend = __CONTROLLER_TOOL_N::ClangBackend;
+
+        const std::filesystem::path path        = __CONTROLLER_FS_N::get_cwd();
+        const std::filesystem::path source_file = path / "_H1HJA9ZLO_17.helix-compiler.cc";
+
+        log<LogLevel::Info>("using the built in '" + Backend::version() +
+                            "' compiler, with the 'lld' linker");
+
+        // everything that has to match between the prelude pch and the translation unit
+        std::vector<std::string> codegen_flags = {
+            "-std=c++23", is_debug ? "-g" : "-O2", "-fno-omit-frame-pointer"};
+
+        std::vector<std::string> compile_flags = codegen_flags;
+        std::vector<std::string> link_flags    = codegen_flags;
+        link_flags.emplace_back("-Wl,-rpath,/usr/local/lib");
+
+        const auto join = [](const std::vector<std::string> &flags) {
+            std::string joined;
+
+            for (const auto &flag : flags) {
+                joined += flag + " ";
+            }
+
+            return joined;
+        };
+
+        if (!prepare_prelude_in_process(codegen_flags, compile_flags)) {
+            return;
+        }
+
+        const auto                        &units = emitter.get_units();
+        std::vector<std::filesystem::path> temporaries;
+        Backend::Result                    result;
+
+        // everything besides the sources that decides what the compiler produces
+        const std::string identity = Backend::version() + join(compile_flags) + join(link_flags);
+
+        if (units.sources.empty()) {
+            std::ostringstream cxir;
+            emitter.write_CXIR(cxir);
+
+            const std::string source = std::move(cxir).str();
+            const std::string key    = cache.key(std::vector<std::string_view>{source}, identity);
+
+            if (cache.fetch(key, path / out)) {
+                log<LogLevel::Info>("up to date, reused the cached executable");
+            } else {
+                std::filesystem::path object = source_file;
+                object.replace_extension(".o");
+                temporaries.push_back(object);
+
+                result = Backend::compile(
+                    source_file, {{source_file, source}}, object, compile_flags);
+
+                if (result.success) {
+                    result.merge(Backend::link({object}, path / out, link_flags));
+                }
+
+                if (result.success) {
+                    cache.store(key, path / out);
+                }
+            }
+        } else {
+            log<LogLevel::Info>("compiling " + std::to_string(units.sources.size()) +
+                                " translation units in parallel");
+
+            result = compile_units_in_process(
+                units, path, compile_flags, link_flags, identity, path / out, jobs, temporaries);
+        }
+
+        if (!result.success) {
+            report_diagnostics(result.diagnostics);
+
+            if (is_verbose || !error::HAS_ERRORED) {
+                log<LogLevel::Info>("compilation passed");
+                log<LogLevel::Error>((is_verbose ? "linker output:\n" : "linker failed. ") +
+                                     result.output);
+            } else {
+                log<LogLevel::Error>("compilation failed");
+            }
+
+            log<LogLevel::Error>("aborting...");
+        } else {
+            log<LogLevel::Info>("lowered " +
+                                (emitter.get_file_name().has_value()
+                                     ? emitter.get_file_name().value()
+                                     : source_file.string()) +
+                                " and compiled cxir");
+            log<LogLevel::Info>("compiled successfully to " + (path / out).string());
+        }
+
+        for (const auto &file : temporaries) {
+            std::error_code err;
+            std::filesystem::remove(file, err);
+        }
+    }
+
+    /// compile_units for the in-process compiler, the header and units stay in memory and only
+    /// the objects are written (lld and the object cache read them from disk)
+    __CONTROLLER_TOOL_N::ClangBackend::Result
+    compile_units_in_process(const generator::CXIR::CX_Units    &units,
+                             const std::filesystem::path        &dir,
+                             const std::vector<std::string>     &compile_flags,
+                             const std::vector<std::string>     &link_flags,
+                             const std::string                  &identity,
+                             const std::filesystem::path        &out,
+                             size_t                              jobs,
+                             std::vector<std::filesystem::path> &temporaries) const {
+        using Backend = __CONTROLLER_TOOL_N::ClangBackend;
+
+        const std::filesystem::path header = dir / split_header_name;
+        std::ostringstream          header_stream;
+
+        generator::CXIR::CXIR::write_tokens(units.header, header_stream);
+        const std::string header_text = std::move(header_stream).str();
+
+        std::vector<std::filesystem::path> objects;
+        std::vector<Backend::Result>       results(units.sources.size());
+        __CONTROLLER_JOBS_N::JobPool       pool(jobs);
+
+        for (size_t i = 0; i < units.sources.size(); ++i) {
+            const std::string stem   = "_H1HJA9ZLO_17.helix-compiler." + std::to_string(i);
+            const auto        source = dir / (stem + ".cc");
+            const auto        object = dir / (stem + ".o");
+
+            temporaries.push_back(object);
+            objects.push_back(object);
+
+            pool.submit([&, i, source, object] {
+                std::ostringstream source_stream;
+                generator::CXIR::CXIR::write_tokens(units.sources[i], source_stream);
+
+                const std::string source_text = std::move(source_stream).str();
+
+                // the header is part of every unit, so it is part of every key
+                const std::string key = cache.key(
+                    std::vector<std::string_view>{header_text, source_text}, identity, dir);
+
+                if (cache.fetch(key, object)) {
+                    return;
+                }
+
+                results[i] = Backend::compile(
+                    source, {{header, header_text}, {source, source_text}}, object, compile_flags);
+
+                if (results[i].success) {
+                    cache.store(key, object);
+                }
+            });
+        }
+
+        pool.wait();
+
+        Backend::Result combined;
+
+        for (auto &result : results) {
+            combined.merge(std::move(result));
+        }
+
+        if (!combined.success) {
+            return combined;
+        }
+
+        return Backend::link(objects, out, link_flags);
+    }
+
+    /// write every unit of a split program, compile them to objects on up to `jobs` threads and
+    /// link the objects. the output of every compiler invocation is concatenated
+    ExecResult compile_units(const generator::CXIR::CX_Units    &units,
+                             const std::filesystem::path        &dir,
+                             const std::string                  &compiler,
+                             const std::string                  &compile_flags,
+                             const std::string                  &link_flags,
+                             const std::string                  &identity,
+                             const std::filesystem::path        &out,
+                             size_t                              jobs,
+                             std::vector<std::filesystem::path> &temporaries) const {
+        const std::filesystem::path header = dir / split_header_name;
+        temporaries.push_back(header);
+
+        if (!write_source_file(header, [&](std::ostream &file) {
+                generator::CXIR::CXIR::write_tokens(units.header, file);
+            })) {
+            return {"error creating " + header.string() + " file", 1};
+        }
+
+        std::vector<std::filesystem::path> objects;
+        std::vector<ExecResult>            results(units.sources.size());
+        __CONTROLLER_JOBS_N::JobPool       pool(jobs);
+
+        for (size_t i = 0; i < units.sources.size(); ++i) {
+            const std::string stem = "_H1HJA9ZLO_17.helix-compiler." + std::to_string(i);
+            const auto        source = dir / (stem + ".cc");
+            const auto        object = dir / (stem + ".o");
+
+            temporaries.push_back(source);
+            temporaries.push_back(object);
+            objects.push_back(object);
+
+            pool.submit([&, i, source, object] {
+                if (!write_source_file(source, [&](std::ostream &file) {
+                        generator::CXIR::CXIR::write_tokens(units.sources[i], file);
+                    })) {
+                    results[i] = {"error creating " + source.string() + " file\n", 1};
+                    return;
+                }
+
+                // the header is part of every unit, so it is part of every key
+                const std::string key = cache.key({header, source}, identity);
+
+                if (cache.fetch(key, object)) {
+                    return;
+                }
+
+                results[i] = exec(compiler + " " + compile_flags + "-c \"" + source.string() +
+                                  "\" -o \"" + object.string() + "\" 2>&1");
+
+                if (results[i].return_code == 0) {
+                    cache.store(key, object);
+                }
+            });
+        }
+
+        pool.wait();
+
+        ExecResult combined;
+
+        for (const auto &result : results) {
+            combined.output += result.output;
+            combined.return_code |= result.return_code;
+        }
+
+        if (combined.return_code != 0) {
+            return combined;
+        }
+
+        std::string link_cmd = compiler + " " + link_flags;
+
+        for (const auto &object : objects) {
+            link_cmd += "\"" + object.string() + "\" ";
+        }
+
+        return exec(link_cmd + "-o \"" + out.string() + "\" 2>&1");
+    }
+
+    /// point diagnostics in the `generated` c++ files back at helix source, the files are only
+    /// read back here, after a failed compile
+    static void map_to_helix_source(std::vector<__CONTROLLER_TOOL_N::Diagnostic> &diagnostics,
+                                    const std::vector<std::filesystem::path>     &generated) {
+        for (const auto &file : generated) {
+            if (file.extension() != ".cc" && file.extension() != ".hh") {
+                continue;
+            }
+
+            const __CONTROLLER_TOOL_N::LineMap map(file.string(),
+                                                   __CONTROLLER_FS_N::read_file(file.string()));
+
+            for (auto &diagnostic : diagnostics) {
+                map.apply(diagnostic);
+            }
+        }
+    }
+
+    /// report the diagnostics of the c++ compiler as helix errors, locations outside of helix
+    /// source (the prelude, the standard library) can not be shown with a code excerpt
+    void report_diagnostics(const std::vector<__CONTROLLER_TOOL_N::Diagnostic> &diagnostics) const {
+        using Level = __CONTROLLER_TOOL_N::Diagnostic::Level;
+
+        for (const auto &diagnostic : diagnostics) {
+            if (diagnostic.file.empty() || !std::filesystem::exists(diagnostic.file)) {
+                error::Panic(error::CompilerError{
+                    .err_code     = 0.8245,
+                    .err_fmt_args = {"error at: " + diagnostic.file + ": " + diagnostic.message},
+                });
+
+                continue;
+            }
+
+            const error::Level level = diagnostic.level == Level::Error     ? error::Level::ERR
+                                       : diagnostic.level == Level::Warning ? error::Level::WARN
+                                                                            : error::Level::NOTE;
+
+            auto pof = token::Token(diagnostic.line,
+                                    0,
+                                    1,
+                                    diagnostic.column,
+                                    "/*error*/",
+                                    diagnostic.file,
+                                    "<other>");
+
+            error::Panic(error::CodeError{
+                .pof          = &pof,
+                .err_code     = 0.8245,
+                .err_fmt_args = {diagnostic.message},
+                .mark_pof     = false,
+                .level        = level,
+                .indent       = static_cast<size_t>((level == error::NOTE) ? 1 : 0),
+            });
+        }
     }
 };
 
@@ -440,13 +1012,63 @@ class CompilationUnit {
             return 0;
         }
 
+#if !defined(_WIN32) && !defined(WIN32) && !defined(_WIN64) && !defined(WIN64)
+        if (parsed_args.run) {
+            return run_in_memory(*ast, emitter, parsed_args, in_file_path);
+        }
+
+        // a debug build wants a binary fast, a program inside the subset LLVMEmitter knows skips
+        // cx-ir and the c++ compiler entirely. everything else continues with cx-ir below
+        if (parsed_args.emit_llvm ||
+            (parsed_args.build_mode == __CONTROLLER_CLI_N::CLIArgs::MODE::DEBUG_ &&
+             parsed_args.toolchain.compiler.empty() && !parsed_args.emit_ir &&
+             !parsed_args.inline_report)) {
+            switch (compile_llvm(*ast, parsed_args, in_file_path)) {
+                case CXIRCompiler::LLVMBuild::LINKED:
+                    log_time(start, parsed_args.verbose, std::chrono::high_resolution_clock::now());
+                    return 0;
+                case CXIRCompiler::LLVMBuild::FAILED:
+                    return 1;
+                case CXIRCompiler::LLVMBuild::FALLBACK:
+                    break;
+            }
+        }
+
+        // msvc has no equivalent of `-include` + pch that works from a plain header, keep the
+        // prelude inline there. everywhere else it comes precompiled from the prelude cache
+        emitter.reference_prelude(!parsed_args.emit_ir);
+        emitter.split_units(parsed_args.jobs != 0
+                                ? parsed_args.jobs
+                                : std::max(1U, std::thread::hardware_concurrency()),
+                            CXIRCompiler::split_header_name);
+#else
+        if (parsed_args.run) {
+            log<LogLevel::Error>("--run is not supported on windows yet");
+            return 1;
+        }
+#endif
+
         ast->accept(emitter);
         log<LogLevel::Info>("emitted cx-ir");
 
+        if (parsed_args.verbose) {
+            log<LogLevel::Debug>(emitter.get_units().sources.empty()
+                                     ? "single translation unit: " + emitter.get_split_reason()
+                                     : "translation units: " +
+                                           std::to_string(emitter.get_units().sources.size()));
+            log<LogLevel::Debug>(
+                "generic instantiations: " +
+                std::to_string(emitter.get_instantiations().get_instantiations().size()));
+        }
+
         if (parsed_args.emit_ir) {
             emit_cxir(emitter, parsed_args.verbose);
         }
 
+        if (parsed_args.inline_report) {
+            print(emitter.get_inlining().report());
+        }
+
         std::string out_file = determine_output_file(parsed_args, in_file_path);
         log<LogLevel::Info>("output file: " + out_file);
 
@@ -458,7 +1080,13 @@ class CompilationUnit {
         compiler.compile_CXIR(emitter,
                               out_file,
                               parsed_args.build_mode == __CONTROLLER_CLI_N::CLIArgs::MODE::DEBUG_,
-                              parsed_args.verbose);
+                              parsed_args.verbose,
+                              parsed_args.jobs,
+                              parsed_args.toolchain.compiler);
+
+        if (parsed_args.cache_stats) {
+            print(compiler.get_cache().report());
+        }
 
         log_time(start, parsed_args.verbose, std::chrono::high_resolution_clock::now());
         return 0;
@@ -467,6 +1095,169 @@ class CompilationUnit {
   private:
     CXIRCompiler compiler;
 
+#if !defined(_WIN32) && !defined(WIN32) && !defined(_WIN64) && !defined(WIN64)
+    /// lower straight to llvm ir, FALLBACK if the program is outside the supported subset
+    CXIRCompiler::LLVMBuild compile_llvm(const parser::ast::node::Program   &ast,
+                                         const __CONTROLLER_CLI_N::CLIArgs &parsed_args,
+                                         const std::filesystem::path       &in_file_path) {
+        const bool is_debug = parsed_args.build_mode == __CONTROLLER_CLI_N::CLIArgs::MODE::DEBUG_;
+
+        __LLVM_CODEGEN_N::LLVMEmitter llvm_emitter(in_file_path.filename().string());
+
+        if (!llvm_emitter.lower(ast)) {
+            if (error::HAS_ERRORED) {
+                return CXIRCompiler::LLVMBuild::FAILED;  // reported, not just outside the subset
+            }
+
+            if (parsed_args.verbose || parsed_args.emit_llvm) {
+                log<LogLevel::Info>("falling back to cx-ir: " +
+                                    llvm_emitter.get_unsupported_reason());
+            }
+
+            return CXIRCompiler::LLVMBuild::FALLBACK;
+        }
+
+        llvm_emitter.optimize(is_debug ? llvm::OptimizationLevel::O0
+                                       : llvm::OptimizationLevel::O2);
+        log<LogLevel::Info>("lowered to llvm ir");
+
+        if (parsed_args.emit_llvm) {
+            log<LogLevel::Debug>(
+                "\n", colors::fg16::yellow, llvm_emitter.to_string(), colors::reset);
+        }
+
+        std::string out_file = determine_output_file(parsed_args, in_file_path);
+        log<LogLevel::Info>("output file: " + out_file);
+
+        return compiler.compile_LLVM(llvm_emitter, out_file, parsed_args.verbose);
+    }
+
+    /// the headers of the `ffi "c++" import "..."` declarations in `ast` that exist, looked up
+    /// in the working directory the cx-ir is compiled from. they are part of the program as much
+    /// as the .hlx file is
+    static std::vector<std::filesystem::path>
+    ffi_headers(const parser::ast::node::Program &ast) {
+        namespace node = parser::ast::node;
+
+        std::vector<std::filesystem::path> headers;
+        const std::filesystem::path        cwd = __CONTROLLER_FS_N::get_cwd();
+
+        for (const auto &child : ast.children) {
+            if (child == nullptr || child->getNodeType() != node::nodes::FFIDecl) {
+                continue;
+            }
+
+            const auto ffi = std::static_pointer_cast<node::FFIDecl>(child);
+
+            if (ffi->name->value.value() != "\"c++\"" || ffi->value == nullptr ||
+                ffi->value->getNodeType() != node::nodes::SingleImportState) {
+                continue;
+            }
+
+            const auto import = std::static_pointer_cast<node::SingleImportState>(ffi->value);
+
+            if (import->path == nullptr ||
+                import->path->getNodeType() != node::nodes::LiteralExpr) {
+                continue;
+            }
+
+            std::string name =
+                std::static_pointer_cast<node::LiteralExpr>(import->path)->value.value();
+
+            if (name.size() >= 2 && name.front() == '"' && name.back() == '"') {
+                name = name.substr(1, name.size() - 2);
+            }
+
+            std::error_code err;
+
+            if (std::filesystem::is_regular_file(cwd / name, err)) {
+                headers.push_back(cwd / name);
+            }
+        }
+
+        return headers;
+    }
+
+    /// --run, the program is compiled to llvm ir in memory (straight from the ast when it is in
+    /// the subset LLVMEmitter knows, through cx-ir and the built in clang otherwise) and run by
+    /// the jit. the exit code is the one of the program
+    int run_in_memory(const parser::ast::node::Program   &ast,
+                      generator::CXIR::CXIR             &emitter,
+                      const __CONTROLLER_CLI_N::CLIArgs &parsed_args,
+                      const std::filesystem::path       &in_file_path) {
+        using Session = __CONTROLLER_TOOL_N::JITSession;
+
+        const bool is_debug = parsed_args.build_mode == __CONTROLLER_CLI_N::CLIArgs::MODE::DEBUG_;
+        Session   &session  = Session::global();
+        std::string error;
+
+        if (!session.available()) {
+            log<LogLevel::Error>("the jit is not available: " + session.get_unavailable_reason());
+            return 1;
+        }
+
+        // an unchanged program that already ran in this session is not compiled again, the
+        // headers it imports are part of it
+        std::vector<__CONTROLLER_FS_N::fs_path> inputs = ffi_headers(ast);
+        inputs.insert(inputs.begin(), in_file_path);
+
+        const std::string key =
+            __CONTROLLER_FS_N::ObjectCache::key(inputs, is_debug ? "jit -g" : "jit");
+
+        if (!session.contains(key)) {
+            ::llvm::orc::ThreadSafeModule module;
+            __LLVM_CODEGEN_N::LLVMEmitter llvm_emitter(in_file_path.filename().string());
+
+            if (llvm_emitter.lower(ast)) {
+                if (!is_debug) {
+                    llvm_emitter.optimize(llvm::OptimizationLevel::O2);
+                }
+
+                if (parsed_args.emit_llvm) {
+                    log<LogLevel::Debug>(
+                        "\n", colors::fg16::yellow, llvm_emitter.to_string(), colors::reset);
+                }
+
+                module = llvm_emitter.take_module();
+            } else {
+                if (parsed_args.verbose || parsed_args.emit_llvm) {
+                    log<LogLevel::Info>("falling back to cx-ir: " +
+                                        llvm_emitter.get_unsupported_reason());
+                }
+
+                emitter.reference_prelude(true);
+                ast.accept(emitter);
+                log<LogLevel::Info>("emitted cx-ir");
+
+                if (error::HAS_ERRORED ||
+                    !compiler.compile_CXIR_to_module(emitter, is_debug, module)) {
+                    log<LogLevel::Error>("aborting...");
+                    return 1;
+                }
+            }
+
+            if (!session.add(key, std::move(module), error)) {
+                log<LogLevel::Error>("the jit could not load the program: " + error);
+                return 1;
+            }
+        }
+
+        std::vector<std::string> args = {in_file_path.stem().string()};
+        args.insert(args.end(), parsed_args.program_args.begin(), parsed_args.program_args.end());
+
+        log<LogLevel::Info>("running " + in_file_path.string());
+
+        const auto exit_code = session.run(key, args, error);
+
+        if (!exit_code.has_value()) {
+            log<LogLevel::Error>("could not run the program: " + error);
+            return 1;
+        }
+
+        return *exit_code;
+    }
+#endif
+
     static void remove_comments(__TOKEN_N::TokenList &tokens) {
         __TOKEN_N::TokenList new_tokens;
 
@@ -1,6 +1,15 @@
 #ifndef __BACKEND_H__
 #define __BACKEND_H__
 
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "controller/include/tooling/jit.hh"
+
 namespace helix::backend {
 // class CodeGen {
 //   public:
@@ -35,10 +44,38 @@ namespace helix::backend {
 }  // namespace helix::backend
 
 namespace helix {
-class RuntimeInitialize;  ///> initialize the JIT process
-class JIT;                ///> invoke the JIT without cli or stdout
-class RuntimeCleanup;     ///> close the JIT process (if this is not done you will be left
-                          ///  with a ghost process)
+/// initialize the JIT process
+class RuntimeInitialize {
+  public:
+    RuntimeInitialize() { static_cast<void>(__CONTROLLER_TOOL_N::JITSession::global()); }
+};
+
+/// invoke the JIT without cli or stdout, programs stay loaded until RuntimeCleanup
+class JIT {
+  public:
+    /// load a program under `key`, a key that is already loaded is kept as it is
+    static bool
+    add(const std::string &key, llvm::orc::ThreadSafeModule module, std::string &error) {
+        return __CONTROLLER_TOOL_N::JITSession::global().add(key, std::move(module), error);
+    }
+
+    /// true if `key` is loaded and can be run again without compiling it
+    static bool contains(const std::string &key) {
+        return __CONTROLLER_TOOL_N::JITSession::global().contains(key);
+    }
+
+    /// run `main` of a loaded program, the exit code or nullopt with `error` set
+    static std::optional<int>
+    run(const std::string &key, const std::vector<std::string> &args, std::string &error) {
+        return __CONTROLLER_TOOL_N::JITSession::global().run(key, args, error);
+    }
+};
+
+/// close the JIT process (if this is not done you will be left with a ghost process)
+class RuntimeCleanup {
+  public:
+    RuntimeCleanup() { __CONTROLLER_TOOL_N::JITSession::shutdown(); }
+};
 
 class Compile;    ///> invoke a raw compile without cli or stdout
 class Toolchain;  ///> invoke the full toolchain with cli args and everything else
@@ -27,5 +27,6 @@
 #include "parser/ast/include/types/AST_modifiers.hh"
 #include "parser/ast/include/types/AST_types.hh"
 #include "parser/ast/include/types/AST_visitor.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
 
 #endif  // __AST_H__
\ No newline at end of file
@@ -77,7 +77,7 @@ __AST_NODE_BEGIN {
     class ForState final : public Node {
         BASE_CORE_METHODS(ForState);
 
-        // := 'for' (ForPyStatementCore | ForCStatementCore)
+        // := 'parallel'? 'for' (ForPyStatementCore | ForCStatementCore)
 
         enum class ForType {
             Python,
@@ -90,6 +90,7 @@ __AST_NODE_BEGIN {
 
         NodeT<> core;
         ForType type;
+        bool    parallel = false;  ///< `parallel for`, the iterations run on the task pool
     };
 
     class WhileState final : public Node {
@@ -239,7 +240,7 @@ __AST_NODE_BEGIN {
     class ReturnState final : public Node {
         BASE_CORE_METHODS(ReturnState);
 
-        // := 'return' expr ';'
+        // := 'return' expr? ';'
 
         explicit ReturnState(NodeT<> value)
             : value(std::move(value)) {}
@@ -351,6 +352,21 @@ __AST_NODE_BEGIN {
         bool no_catch;
     };
 
+    class WithState final : public Node {
+        BASE_CORE_METHODS(WithState);
+
+        // := 'with' E ('as' IdentExpr)? SuiteState
+
+        WithState(NodeT<> value, NodeT<IdentExpr> name, NodeT<SuiteState> body)
+            : value(std::move(value))
+            , name(std::move(name))
+            , body(std::move(body)) {}
+
+        NodeT<>           value;
+        NodeT<IdentExpr>  name;  ///< null without 'as'
+        NodeT<SuiteState> body;
+    };
+
     class PanicState final : public Node {
         BASE_CORE_METHODS(PanicState);
 
@@ -89,6 +89,8 @@ __AST_NODE_BEGIN {
                 return parse_FinallyState(std ::forward<Args>(args)...);
             } else if constexpr (std ::is_same_v<T, TryState>) {
                 return parse_TryState(std ::forward<Args>(args)...);
+            } else if constexpr (std ::is_same_v<T, WithState>) {
+                return parse_WithState(std ::forward<Args>(args)...);
             } else if constexpr (std ::is_same_v<T, PanicState>) {
                 return parse_PanicState(std ::forward<Args>(args)...);
             } else if constexpr (std ::is_same_v<T, ExprState>) {
@@ -122,6 +124,7 @@ __AST_NODE_BEGIN {
         ParseResult<ExprState>             parse_ExprState();
         ParseResult<BlockState>            parse_BlockState();
         ParseResult<TryState>              parse_TryState();
+        ParseResult<WithState>             parse_WithState();
         ParseResult<CatchState>            parse_CatchState();
         ParseResult<FinallyState>          parse_FinallyState();
         ParseResult<PanicState>            parse_PanicState();
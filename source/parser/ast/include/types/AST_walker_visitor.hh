@@ -0,0 +1,57 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+//                                                                                                //
+//  This file defines the Walker visitor, a visitor that does nothing but visit every child of    //
+//  every node. Analysis passes derive from it and only override the nodes they care about,       //
+//  calling back into Walker::visit(node) to keep descending.                                     //
+//                                                                                                //
+//===-----------------------------------------------------------------------------------------====//
+
+#ifndef __AST_WALKER_VISIT_H__
+#define __AST_WALKER_VISIT_H__
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/types/AST_types.hh"
+#include "parser/ast/include/types/AST_visitor.hh"
+
+__AST_VISITOR_BEGIN {
+    class Walker : public Visitor {
+      public:
+        Walker()                          = default;
+        Walker(const Walker &)            = default;
+        Walker(Walker &&)                 = default;
+        Walker &operator=(const Walker &) = default;
+        Walker &operator=(Walker &&)      = default;
+        ~Walker() override                = default;
+
+        GENERATE_VISIT_EXTENDS;
+
+      protected:
+        /// visit a child if its not null, every optional child in the ast is a nullable NodeT
+        template <typename T>
+        void walk(const NodeT<T> &child) {
+            if (child != nullptr) {
+                child->accept(*this);
+            }
+        }
+
+        template <typename T>
+        void walk(const NodeV<T> &children) {
+            for (const auto &child : children) {
+                walk(child);
+            }
+        }
+    };
+}  // namespace __AST_VISITOR_BEGIN
+
+#endif  // __AST_WALKER_VISIT_H__
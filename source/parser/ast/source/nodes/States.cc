@@ -70,6 +70,7 @@
 ///                            (CatchState | FinallyState)?                                      ///
 /// [x] * FinallyState       * 'finally' SuiteState                                              ///
 /// [x] * PanicState         * 'panic' ';'                                                       ///
+/// [x] * WithState          * 'with' E ('as' Ident)? SuiteState                                 ///
 ///                                                                                              ///
 /// [ ] * ImportState        * 'import' (SingleImportState | MultiImportState)                   ///
 /// [ ] * AliasState         * Ident 'as' Ident ';'                                              ///
@@ -228,6 +229,19 @@ AST_BASE_IMPL(Statement, parse) {  // NOLINT(readability-function-cognitive-comp
     __TOKEN_N::Token tok = CURRENT_TOK;  /// get the current token from the iterator
     // modifiers        = get_modifiers(iter);  /// get the modifiers for the statement
 
+    // `parallel` is only a keyword in front of a for loop, anywhere else it is a name
+    if (tok.token_kind() == __TOKEN_N::IDENTIFIER && tok.value() == "parallel" &&
+        iter.peek().has_value() && NEXT_TOK.token_kind() == __TOKEN_N::KEYWORD_FOR) {
+        return parse_ForState();
+    }
+
+    // `with` is only a keyword in front of a name (`with arena { ... }`), two names in a row are
+    // not an expression so `with` stays usable as a name
+    if (tok.token_kind() == __TOKEN_N::IDENTIFIER && tok.value() == "with" &&
+        iter.peek().has_value() && NEXT_TOK.token_kind() == __TOKEN_N::IDENTIFIER) {
+        return parse_WithState();
+    }
+
     switch (tok.token_kind()) {
         // TODO: case __TOKEN_N::KEYWORD_IMPORT
         case __TOKEN_N::KEYWORD_IF:
@@ -517,9 +531,15 @@ AST_NODE_IMPL_VISITOR(Jsonify, ForCStatementCore) {
 AST_NODE_IMPL(Statement, ForState) {
     IS_NOT_EMPTY;
 
-    // := 'for' ForPyStatementCore | ForCStatementCore SuiteState
+    // := 'parallel'? 'for' ForPyStatementCore | ForCStatementCore SuiteState
 
     bool except_closing_paren = false;
+    bool parallel             = false;
+
+    if (CURRENT_TOKEN_IS(__TOKEN_N::IDENTIFIER) && CURRENT_TOK.value() == "parallel") {
+        parallel = true;
+        iter.advance();  // skip 'parallel'
+    }
 
     IS_EXCEPTED_TOKEN(__TOKEN_N::KEYWORD_FOR);
     iter.advance();  // skip 'for'
@@ -543,7 +563,10 @@ AST_NODE_IMPL(Statement, ForState) {
         ParseResult<ForCStatementCore> c_for = parse<ForCStatementCore>(true);
         RETURN_IF_ERROR(c_for);
 
-        return make_node<ForState>(c_for.value(), ForState::ForType::C);
+        NodeT<ForState> node = make_node<ForState>(c_for.value(), ForState::ForType::C);
+        node->parallel       = parallel;
+
+        return node;
     }
 
     // if we dont have (',' | ':' | 'in') then we are in a c style loop
@@ -560,11 +583,17 @@ AST_NODE_IMPL(Statement, ForState) {
     ParseResult<ForPyStatementCore> py_for = parse<ForPyStatementCore>(true);
     RETURN_IF_ERROR(py_for);
 
-    return make_node<ForState>(py_for.value(), ForState::ForType::Python);
+    NodeT<ForState> node = make_node<ForState>(py_for.value(), ForState::ForType::Python);
+    node->parallel       = parallel;
+
+    return node;
 }
 
 AST_NODE_IMPL_VISITOR(Jsonify, ForState) {
-    json.section("ForState").add("core", get_node_json(node.core)).add("type", (int)node.type);
+    json.section("ForState")
+        .add("core", get_node_json(node.core))
+        .add("type", (int)node.type)
+        .add("parallel", (int)node.parallel);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -965,6 +994,11 @@ AST_NODE_IMPL(Statement, ReturnState) {
     IS_EXCEPTED_TOKEN(__TOKEN_N::KEYWORD_RETURN);
     iter.advance();  // skip 'return'
 
+    if (CURRENT_TOKEN_IS(__TOKEN_N::PUNCTUATION_SEMICOLON)) {  // 'return' ';'
+        iter.advance();  // skip ';'
+        return make_node<ReturnState>(nullptr);
+    }
+
     ParseResult<> expr = expr_parser.parse();
     RETURN_IF_ERROR(expr);
 
@@ -1158,6 +1192,52 @@ AST_NODE_IMPL(Statement, TryState) {
     return node;
 }
 
+AST_NODE_IMPL(Statement, WithState) {
+    IS_NOT_EMPTY;
+
+    // := 'with' E ('as' Ident)? SuiteState
+
+    IS_EXCEPTED_TOKEN(__TOKEN_N::IDENTIFIER);
+    iter.advance();  // skip 'with'
+
+    ParseResult<> value = expr_parser.parse();
+    RETURN_IF_ERROR(value);
+
+    NodeT<>          managed = value.value();
+    NodeT<IdentExpr> name    = nullptr;
+
+    // the expression parser reads `E as name` as a cast, a cast to a plain name is the name
+    if (managed->getNodeType() == nodes::CastExpr) {
+        const auto cast = Node::as<CastExpr>(managed);
+        NodeT<>    type = cast->type != nullptr ? cast->type->value : nullptr;
+
+        if (type != nullptr && type->getNodeType() == nodes::PathExpr &&
+            Node::as<PathExpr>(type)->type == PathExpr::PathType::Identifier) {
+            type = Node::as<PathExpr>(type)->path;
+        }
+
+        if (type != nullptr && type->getNodeType() == nodes::IdentExpr &&
+            cast->type->generics == nullptr) {
+            managed = cast->value;
+            name    = Node::as<IdentExpr>(type);
+        }
+    }
+
+    ParseResult<SuiteState> body = parse<SuiteState>();
+    RETURN_IF_ERROR(body);
+
+    return make_node<WithState>(managed, name, body.value());
+}
+
+AST_NODE_IMPL_VISITOR(Jsonify, WithState) {
+    json.section("WithState")
+        .add("value", get_node_json(node.value))
+        .add("name", get_node_json(node.name))
+        .add("body", get_node_json(node.body));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 AST_NODE_IMPL_VISITOR(Jsonify, TryState) {
     std::vector<neo::json> catch_states;
 
@@ -0,0 +1,298 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include "parser/ast/include/config/AST_config.def"
+#include "parser/ast/include/nodes/AST_nodes.hh"
+#include "parser/ast/include/private/base/AST_base.hh"
+#include "parser/ast/include/types/AST_walker_visitor.hh"
+
+// ---------------------------------------------------------------------------------------------- //
+//                                          expressions                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+AST_NODE_IMPL_VISITOR(Walker, LiteralExpr) { walk(node.format_args); }
+
+AST_NODE_IMPL_VISITOR(Walker, BinaryExpr) {
+    walk(node.lhs);
+    walk(node.rhs);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, UnaryExpr) { walk(node.opd); }
+AST_NODE_IMPL_VISITOR(Walker, IdentExpr) {}
+
+AST_NODE_IMPL_VISITOR(Walker, NamedArgumentExpr) {
+    walk(node.name);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ArgumentExpr) { walk(node.value); }
+AST_NODE_IMPL_VISITOR(Walker, ArgumentListExpr) { walk(node.args); }
+AST_NODE_IMPL_VISITOR(Walker, GenericInvokeExpr) { walk(node.args); }
+
+AST_NODE_IMPL_VISITOR(Walker, GenericInvokePathExpr) {
+    walk(node.path);
+    walk(node.generic);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ScopePathExpr) {
+    walk(node.path);
+    walk(node.access);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, DotPathExpr) {
+    walk(node.lhs);
+    walk(node.rhs);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ArrayAccessExpr) {
+    walk(node.lhs);
+    walk(node.rhs);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, PathExpr) { walk(node.path); }
+
+AST_NODE_IMPL_VISITOR(Walker, FunctionCallExpr) {
+    walk(node.path);
+    walk(node.generic);
+    walk(node.args);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ArrayLiteralExpr) { walk(node.values); }
+AST_NODE_IMPL_VISITOR(Walker, TupleLiteralExpr) { walk(node.values); }
+AST_NODE_IMPL_VISITOR(Walker, SetLiteralExpr) { walk(node.values); }
+
+AST_NODE_IMPL_VISITOR(Walker, MapPairExpr) {
+    walk(node.key);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, MapLiteralExpr) { walk(node.values); }
+
+AST_NODE_IMPL_VISITOR(Walker, ObjInitExpr) {
+    walk(node.path);
+    walk(node.kwargs);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, LambdaExpr) {
+    walk(node.args);
+    walk(node.ret);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, TernaryExpr) {
+    walk(node.condition);
+    walk(node.if_true);
+    walk(node.if_false);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ParenthesizedExpr) { walk(node.value); }
+
+AST_NODE_IMPL_VISITOR(Walker, CastExpr) {
+    walk(node.value);
+    walk(node.type);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, InstOfExpr) {
+    walk(node.value);
+    walk(node.type);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, AsyncThreading) { walk(node.value); }
+
+AST_NODE_IMPL_VISITOR(Walker, Type) {
+    walk(node.value);
+    walk(node.generics);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+//                                           statements                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+AST_NODE_IMPL_VISITOR(Walker, NamedVarSpecifier) {
+    walk(node.path);
+    walk(node.type);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, NamedVarSpecifierList) { walk(node.vars); }
+
+AST_NODE_IMPL_VISITOR(Walker, ForPyStatementCore) {
+    walk(node.vars);
+    walk(node.range);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ForCStatementCore) {
+    walk(node.init);
+    walk(node.condition);
+    walk(node.update);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ForState) { walk(node.core); }
+
+AST_NODE_IMPL_VISITOR(Walker, WhileState) {
+    walk(node.condition);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ElseState) {
+    walk(node.condition);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, IfState) {
+    walk(node.condition);
+    walk(node.body);
+    walk(node.else_body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, SwitchCaseState) {
+    walk(node.condition);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, SwitchState) {
+    walk(node.condition);
+    walk(node.cases);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, WithState) {
+    walk(node.value);
+    walk(node.name);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, YieldState) { walk(node.value); }
+AST_NODE_IMPL_VISITOR(Walker, DeleteState) { walk(node.value); }
+AST_NODE_IMPL_VISITOR(Walker, AliasState) {}
+
+AST_NODE_IMPL_VISITOR(Walker, SingleImportState) {
+    walk(node.path);
+    walk(node.alias);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, MultiImportState) {}
+AST_NODE_IMPL_VISITOR(Walker, ImportState) {}
+AST_NODE_IMPL_VISITOR(Walker, ReturnState) { walk(node.value); }
+AST_NODE_IMPL_VISITOR(Walker, BreakState) {}
+AST_NODE_IMPL_VISITOR(Walker, BlockState) { walk(node.body); }
+AST_NODE_IMPL_VISITOR(Walker, SuiteState) { walk(node.body); }
+AST_NODE_IMPL_VISITOR(Walker, ContinueState) {}
+
+AST_NODE_IMPL_VISITOR(Walker, CatchState) {
+    walk(node.catch_state);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, FinallyState) { walk(node.body); }
+
+AST_NODE_IMPL_VISITOR(Walker, TryState) {
+    walk(node.body);
+    walk(node.catch_states);
+    walk(node.finally_state);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, PanicState) { walk(node.expr); }
+AST_NODE_IMPL_VISITOR(Walker, ExprState) { walk(node.value); }
+
+// ---------------------------------------------------------------------------------------------- //
+//                                          declarations                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+AST_NODE_IMPL_VISITOR(Walker, RequiresParamDecl) {
+    walk(node.var);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, RequiresParamList) { walk(node.params); }
+
+AST_NODE_IMPL_VISITOR(Walker, EnumMemberDecl) {
+    walk(node.name);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, UDTDeriveDecl) {
+    for (const auto &derive : node.derives) {
+        walk(derive.first);
+    }
+}
+
+AST_NODE_IMPL_VISITOR(Walker, TypeBoundList) { walk(node.bounds); }
+AST_NODE_IMPL_VISITOR(Walker, TypeBoundDecl) { walk(node.bound); }
+
+AST_NODE_IMPL_VISITOR(Walker, RequiresDecl) {
+    walk(node.params);
+    walk(node.bounds);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ModuleDecl) {
+    walk(node.name);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, StructDecl) {
+    walk(node.generics);
+    walk(node.name);
+    walk(node.derives);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, ConstDecl) { walk(node.vars); }
+
+AST_NODE_IMPL_VISITOR(Walker, ClassDecl) {
+    walk(node.generics);
+    walk(node.name);
+    walk(node.derives);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, InterDecl) {
+    walk(node.generics);
+    walk(node.name);
+    walk(node.derives);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, EnumDecl) {
+    walk(node.name);
+    walk(node.derives);
+    walk(node.members);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, TypeDecl) {
+    walk(node.generics);
+    walk(node.name);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, FuncDecl) {
+    walk(node.generics);
+    walk(node.name);
+    walk(node.params);
+    walk(node.returns);
+    walk(node.body);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, VarDecl) {
+    walk(node.var);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, FFIDecl) {
+    walk(node.name);
+    walk(node.value);
+}
+
+AST_NODE_IMPL_VISITOR(Walker, LetDecl) { walk(node.vars); }
+AST_NODE_IMPL_VISITOR(Walker, OpDecl) { walk(node.func); }
+
+void __AST_VISITOR::Walker::visit(const __AST_NODE::Program &node) { walk(node.children); }
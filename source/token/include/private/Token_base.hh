@@ -67,6 +67,7 @@ __TOKEN_BEGIN {
         [[nodiscard]] std::string &get_value() const;
         std::string                token_kind_repr() const;
         std::string                file_name() const;
+        [[nodiscard]] const std::string &get_file_name() const;  ///< file_name without the copy
         std::string                to_string() const;
 
         bool          operator==(const Token &rhs) const;
@@ -144,6 +144,8 @@ __TOKEN_BEGIN {
 
     std::string Token::file_name() const { return filename; }
 
+    const std::string &Token::get_file_name() const { return filename; }
+
     void Token::set_file_name(const std::string &file_name) {
         this->filename = std::string(file_name);
     }
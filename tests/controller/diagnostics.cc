@@ -0,0 +1,118 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <catch2>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/tooling/diagnostics.hh"
+
+namespace {
+using __CONTROLLER_TOOL_N::Diagnostic;
+using __CONTROLLER_TOOL_N::LineMap;
+using __CONTROLLER_TOOL_N::parse_diagnostics;
+
+constexpr std::string_view sarif_log =
+    R"({"version":"2.1.0","runs":[{"tool":{"driver":{"name":"clang"}},"results":[)"
+    R"({"level":"error","message":{"text":"use of undeclared identifier 'x'"},)"
+    R"("locations":[{"physicalLocation":{"artifactLocation":{"uri":"file:///tmp/a%20b/main.cc"},)"
+    R"("region":{"startLine":12,"startColumn":5}}}]},)"
+    R"({"level":"note","message":{"text":"no location"}}]}]})";
+
+constexpr std::string_view gcc_array =
+    R"([{"kind":"warning","message":"unused variable 'y'","column-origin":1,)"
+    R"("locations":[{"caret":{"file":"main.cc","line":3,"column":9}}],)"
+    R"("children":[{"kind":"note","message":"declared here",)"
+    R"("locations":[{"caret":{"file":"main.cc","line":2,"column":1}}]}]},)"
+    R"({"kind":"fatal error","message":"missing header","locations":[]}])";
+}  // namespace
+
+TEST_CASE("parse_diagnostics reads a SARIF log", "[controller::diagnostics]") {
+    const auto diagnostics = parse_diagnostics(sarif_log);
+
+    REQUIRE(diagnostics.size() == 2);
+
+    REQUIRE(diagnostics[0].level == Diagnostic::Level::Error);
+    REQUIRE(diagnostics[0].file == "/tmp/a b/main.cc");
+    REQUIRE(diagnostics[0].line == 12);
+    REQUIRE(diagnostics[0].column == 5);
+    REQUIRE(diagnostics[0].message == "use of undeclared identifier 'x'");
+
+    REQUIRE(diagnostics[1].level == Diagnostic::Level::Note);
+    REQUIRE(diagnostics[1].file.empty());
+}
+
+TEST_CASE("parse_diagnostics reads a gcc json array with its notes", "[controller::diagnostics]") {
+    const auto diagnostics = parse_diagnostics(gcc_array);
+
+    REQUIRE(diagnostics.size() == 3);
+
+    REQUIRE(diagnostics[0].level == Diagnostic::Level::Warning);
+    REQUIRE(diagnostics[0].file == "main.cc");
+    REQUIRE(diagnostics[0].line == 3);
+    REQUIRE(diagnostics[0].column == 9);
+
+    REQUIRE(diagnostics[1].level == Diagnostic::Level::Note);  // the child follows its parent
+    REQUIRE(diagnostics[1].message == "declared here");
+    REQUIRE(diagnostics[1].line == 2);
+
+    REQUIRE(diagnostics[2].level == Diagnostic::Level::Error);
+    REQUIRE(diagnostics[2].file.empty());
+}
+
+TEST_CASE("parse_diagnostics keeps the text that is not a document", "[controller::diagnostics]") {
+    const std::string output = "/usr/bin/ld: cannot find -lfoo\n" + std::string(gcc_array) +
+                               "\n[not json\ncollect2: error: ld returned 1 exit status\n";
+
+    std::string rest;
+    const auto  diagnostics = parse_diagnostics(output, &rest);
+
+    REQUIRE(diagnostics.size() == 3);
+    REQUIRE(rest == "/usr/bin/ld: cannot find -lfoo\n\n[not json\n"
+                    "collect2: error: ld returned 1 exit status\n");
+}
+
+TEST_CASE("LineMap points diagnostics back at the helix source", "[controller::diagnostics]") {
+    constexpr std::string_view generated = "// prelude\n"            // 1
+                                           "int prelude();\n"         // 2
+                                           "#line 10 \"main.hlx\"\n"  // 3
+                                           "int a;\n"                 // 4, main.hlx:10
+                                           "int b;\n"                 // 5, main.hlx:11
+                                           "#line 3 \"lib.hlx\"\n"    // 6
+                                           "int c;\n";                // 7, lib.hlx:3
+
+    const LineMap map("/tmp/out/./main.cc", generated);
+
+    const auto mapped = [&map](std::string file, u64 line) {
+        Diagnostic diagnostic{.level   = Diagnostic::Level::Error,
+                              .file    = std::move(file),
+                              .line    = line,
+                              .column  = 0,
+                              .message = {}};
+        map.apply(diagnostic);
+        return diagnostic;
+    };
+
+    REQUIRE(mapped("/tmp/out/main.cc", 4).file == "main.hlx");
+    REQUIRE(mapped("/tmp/out/main.cc", 4).line == 10);
+    REQUIRE(mapped("/tmp/out/main.cc", 5).line == 11);
+
+    REQUIRE(mapped("/tmp/out/main.cc", 7).file == "lib.hlx");
+    REQUIRE(mapped("/tmp/out/main.cc", 7).line == 3);
+
+    // before the first directive, or in another file, nothing changes
+    REQUIRE(mapped("/tmp/out/main.cc", 2).file == "/tmp/out/main.cc");
+    REQUIRE(mapped("/tmp/out/main.cc", 2).line == 2);
+    REQUIRE(mapped("/tmp/out/other.cc", 5).file == "/tmp/out/other.cc");
+    REQUIRE(mapped("", 5).file.empty());
+}
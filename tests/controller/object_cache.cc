@@ -0,0 +1,110 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <catch2>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "controller/include/shared/object_cache.hh"
+
+namespace {
+using __CONTROLLER_FS_N::fs_path;
+using __CONTROLLER_FS_N::ObjectCache;
+
+/// a directory of its own for one test case, removed again at the end
+struct Scratch {
+    fs_path dir = std::filesystem::temp_directory_path() / "helix-object-cache-test";
+
+    Scratch() {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    ~Scratch() { std::filesystem::remove_all(dir); }
+
+    Scratch(const Scratch &)            = delete;
+    Scratch &operator=(const Scratch &) = delete;
+
+    [[nodiscard]] fs_path write(const std::string &name, std::string_view text) const {
+        std::ofstream(dir / name, std::ios::binary) << text;
+        return dir / name;
+    }
+};
+
+std::string key_of(std::string_view source, std::string_view identity, const fs_path &dir) {
+    return ObjectCache::key(std::vector<std::string_view>{source}, identity, dir);
+}
+}  // namespace
+
+TEST_CASE("ObjectCache::key depends on every input", "[ObjectCache::key]") {
+    const Scratch scratch;
+
+    SECTION("the same inputs give the same key") {
+        REQUIRE(key_of("int main() {}", "g++ -O2", scratch.dir) ==
+                key_of("int main() {}", "g++ -O2", scratch.dir));
+        REQUIRE(key_of("int main() {}", "g++ -O2", scratch.dir).size() == 32);
+    }
+
+    SECTION("the source and the identity are both part of it") {
+        const auto key = key_of("int main() {}", "g++ -O2", scratch.dir);
+
+        REQUIRE(key != key_of("int main() { return 1; }", "g++ -O2", scratch.dir));
+        REQUIRE(key != key_of("int main() {}", "g++ -O0", scratch.dir));
+    }
+
+    SECTION("bytes moved between two inputs change it") {
+        const auto first  = ObjectCache::key(std::vector<std::string_view>{"ab", "c"}, "id");
+        const auto second = ObjectCache::key(std::vector<std::string_view>{"a", "bc"}, "id");
+
+        REQUIRE(first != second);
+    }
+
+    SECTION("a file input is the same as its contents") {
+        const auto file = scratch.write("main.cc", "int main() {}");
+
+        REQUIRE(ObjectCache::key(std::vector<fs_path>{file}, "id") ==
+                key_of("int main() {}", "id", scratch.dir));
+    }
+}
+
+TEST_CASE("ObjectCache::key follows quoted includes", "[ObjectCache::key]") {
+    const Scratch          scratch;
+    const std::string_view source = "#include \"ffi.hh\"\n#include <vector>\nint main() {}\n";
+
+    static_cast<void>(scratch.write("ffi.hh", "  #  include \"nested.hh\"\nint ffi();\n"));
+    static_cast<void>(scratch.write("nested.hh", "int nested();\n"));
+
+    const auto key = key_of(source, "id", scratch.dir);
+
+    SECTION("an edit to an included header is a new key") {
+        static_cast<void>(scratch.write("ffi.hh", "#include \"nested.hh\"\nlong ffi();\n"));
+
+        REQUIRE(key != key_of(source, "id", scratch.dir));
+    }
+
+    SECTION("so is an edit to a header that header includes") {
+        static_cast<void>(scratch.write("nested.hh", "long nested();\n"));
+
+        REQUIRE(key != key_of(source, "id", scratch.dir));
+    }
+
+    SECTION("a header that is not found is left out") {
+        std::filesystem::remove(scratch.dir / "ffi.hh");
+        std::filesystem::remove(scratch.dir / "nested.hh");
+
+        REQUIRE(key_of(source, "id", scratch.dir) == key_of(source, "id", scratch.dir / "none"));
+    }
+}
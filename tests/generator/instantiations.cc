@@ -0,0 +1,84 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <catch2>
+#include <cctype>
+#include <sstream>
+#include <string>
+
+#include "generator/include/CX-IR/CXIR.hh"
+#include "lexer/include/lexer.hh"
+#include "parser/ast/include/AST.hh"
+
+namespace {
+/// the explicit instantiations `source` emits, without `#line` directives and whitespace
+std::string instantiations_of(const std::string &source) {
+    parser::lexer::Lexer lexer(source, "instantiations.hlx");
+    __TOKEN_N::TokenList tokens = lexer.tokenize();
+
+    auto program = parser::ast::make_node<parser::ast::node::Program>(tokens);
+    program->parse();
+
+    generator::CXIR::CXIR emitter;
+    emitter.reference_prelude(true);
+    program->accept(emitter);
+
+    const size_t before = emitter.to_CXIR().size();
+    emitter.emit_instantiations(emitter.get_instantiations(), true);
+
+    std::istringstream emitted(emitter.to_CXIR().substr(before));
+    std::string        line;
+    std::string        compact;
+
+    while (std::getline(emitted, line)) {
+        if (!line.starts_with("#line")) {
+            std::erase_if(line, [](unsigned char chr) { return std::isspace(chr) != 0; });
+            compact += line;
+        }
+    }
+
+    return compact;
+}
+}  // namespace
+
+TEST_CASE("explicit instantiations spell the return type of the declaration",
+          "[generator::instantiations]") {
+    SECTION("a plain generic function") {
+        REQUIRE(instantiations_of("fn twice(x: T) -> T requires <T> {\n"
+                                  "    return x + x;\n"
+                                  "}\n"
+                                  "fn main() -> i32 {\n"
+                                  "    return twice::<i32>(21);\n"
+                                  "}\n") == "externtemplatei32twice<i32>(i32);");
+    }
+
+    SECTION("an async function returns a future") {
+        REQUIRE(instantiations_of("async fn twice(x: T) -> T requires <T> {\n"
+                                  "    return x + x;\n"
+                                  "}\n"
+                                  "fn main() -> i32 {\n"
+                                  "    return helix::std::block_on(twice::<i32>(21));\n"
+                                  "}\n") == "externtemplatehelix::future<i32>twice<i32>(i32);");
+    }
+
+    SECTION("a function that yields returns a generator") {
+        REQUIRE(instantiations_of("fn count(n: T) -> T requires <T> {\n"
+                                  "    yield n;\n"
+                                  "}\n"
+                                  "fn main() {\n"
+                                  "    for v in count::<i32>(3) {\n"
+                                  "        print(v);\n"
+                                  "    }\n"
+                                  "}\n") == "externtemplatehelix::generator<i32>count<i32>(i32);");
+    }
+}
@@ -0,0 +1,128 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <catch2>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+// a key without ::std::hash falls back to the tree instead of failing to compile
+static_assert(std::is_same_v<map<int, int>, helix::std::hash_map<int, int>>);
+static_assert(std::is_same_v<map<std::tuple<int, int>, int>, std::map<std::tuple<int, int>, int>>);
+static_assert(std::is_same_v<set<std::tuple<int, int>>, std::set<std::tuple<int, int>>>);
+
+TEST_CASE("map and set take keys without a std::hash", "[runtime::map]") {
+    map<std::tuple<int, int>, std::string> grid;
+
+    grid[{1, 2}] = "a";
+    grid[{3, 4}] = "b";
+
+    REQUIRE(grid.size() == 2);
+    REQUIRE(grid.at({1, 2}) == "a");
+
+    auto literal = helix::std::map_literal(helix::std::map_entry(std::tuple{1, 2}, 3),
+                                           helix::std::map_entry(std::tuple{1, 2}, 4));
+
+    REQUIRE(literal.size() == 1);
+    REQUIRE(literal.at({1, 2}) == 4);
+
+    auto points = helix::std::set_literal(std::tuple{0, 0}, std::tuple{0, 1}, std::tuple{0, 0});
+
+    REQUIRE(points.size() == 2);
+    REQUIRE(points.contains({0, 1}));
+}
+
+TEST_CASE("hash_map agrees with std::unordered_map", "[runtime::hash_map]") {
+    helix::std::hash_map<std::uint64_t, int> map;
+    std::unordered_map<std::uint64_t, int>   reference;
+
+    // inserts, overwrites and erases mixed, enough to rehash several times and leave tombstones
+    for (std::uint64_t i = 0; i < 20'000; ++i) {
+        const std::uint64_t key = (i * 2654435761U) % 5'000;
+
+        if (i % 3 == 0) {
+            REQUIRE(map.erase(key) == reference.erase(key));
+        } else {
+            map[key]       = static_cast<int>(i);
+            reference[key] = static_cast<int>(i);
+        }
+    }
+
+    REQUIRE(map.size() == reference.size());
+
+    for (const auto &[key, value] : reference) {
+        REQUIRE(map.contains(key));
+        REQUIRE(map.at(key) == value);
+    }
+
+    size_t visited = 0;
+
+    for (const auto &entry : map) {
+        REQUIRE(reference.at(entry.first) == entry.second);
+        ++visited;
+    }
+
+    REQUIRE(visited == reference.size());
+    REQUIRE_THROWS_AS(map.at(5'000), std::out_of_range);
+}
+
+TEST_CASE("hash_map erase while iterating", "[runtime::hash_map]") {
+    helix::std::hash_map<int, int> map;
+
+    for (int i = 0; i < 1'000; ++i) {
+        map[i] = i;
+    }
+
+    // erase returns the next element, every element is seen once and the odd ones survive
+    size_t seen = 0;
+
+    for (auto it = map.begin(); it != map.end();) {
+        ++seen;
+        it = it->first % 2 == 0 ? map.erase(it) : std::next(it);
+    }
+
+    REQUIRE(seen == 1'000);
+    REQUIRE(map.size() == 500);
+
+    for (int i = 0; i < 1'000; ++i) {
+        REQUIRE(map.contains(i) == (i % 2 != 0));
+    }
+
+    SECTION("the erased slots are reused") {
+        for (int i = 0; i < 1'000; i += 2) {
+            map[i] = -i;
+        }
+
+        REQUIRE(map.size() == 1'000);
+        REQUIRE(map.at(10) == -10);
+    }
+}
+
+TEST_CASE("hash_set insert, find and erase", "[runtime::hash_set]") {
+    helix::std::hash_set<std::string> set = {"a", "b", "c"};
+
+    REQUIRE(set.insert("a").second == false);
+    REQUIRE(set.insert("d").second);
+    REQUIRE(set.size() == 4);
+    REQUIRE(set.find("b") != set.end());
+    REQUIRE(set.erase("b") == 1);
+    REQUIRE(set.find("b") == set.end());
+    REQUIRE(set.erase("b") == 0);
+}
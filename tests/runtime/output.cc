@@ -0,0 +1,150 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <array>
+#include <catch2>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace {
+template <typename T>
+std::string appended(const T &value) {
+    std::string out;
+    helix::std::__internal_interfaces::append_to_string(out, value);
+    return out;
+}
+
+template <typename T>
+std::string streamed(const T &value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+}
+}  // namespace
+
+TEST_CASE("append_to_string writes what an ostream writes", "[runtime::print]") {
+    REQUIRE(appended(0) == streamed(0));
+    REQUIRE(appended(-42) == streamed(-42));
+    REQUIRE(appended(std::numeric_limits<std::int64_t>::min()) ==
+            streamed(std::numeric_limits<std::int64_t>::min()));
+    REQUIRE(appended(std::numeric_limits<std::uint64_t>::max()) ==
+            streamed(std::numeric_limits<std::uint64_t>::max()));
+    REQUIRE(appended(3.5) == streamed(3.5));
+    REQUIRE(appended(1.0 / 3.0) == streamed(1.0 / 3.0));
+    REQUIRE(appended(1e300) == streamed(1e300));
+    REQUIRE(appended(0.25F) == streamed(0.25F));
+    REQUIRE(appended(true) == streamed(true));
+    REQUIRE(appended('x') == streamed('x'));
+    REQUIRE(appended(static_cast<std::int8_t>('A')) == streamed(static_cast<std::int8_t>('A')));
+    REQUIRE(appended(static_cast<std::uint8_t>('z')) == streamed(static_cast<std::uint8_t>('z')));
+    REQUIRE(appended(std::string_view("text")) == "text");
+    REQUIRE(appended(std::string("text")) == "text");
+}
+
+TEST_CASE("format_string puts the arguments between the segments", "[runtime::print]") {
+    // f"{a} + {b} = {a + b}!"
+    const int a = 2;
+    const int b = 3;
+
+    REQUIRE(helix::std::format_string({"", " + ", " = ", "!"}, a, b, a + b) == "2 + 3 = 5!");
+
+    // f"hi: {name=}" and a literal without arguments
+    const std::string name = "helix";
+
+    REQUIRE(helix::std::format_string({"hi: name=", ""}, name) == "hi: name=helix");
+    REQUIRE(helix::std::format_string(std::array<std::string_view, 1>{"plain"}) == "plain");
+
+    // empty segments around adjacent arguments, f"{a}{b}"
+    REQUIRE(helix::std::format_string({"", "", ""}, a, b) == "23");
+}
+
+#if !defined(_WIN32)
+TEST_CASE("print buffers its lines until they are flushed", "[runtime::print]") {
+    std::cout.flush();
+
+    int ends[2];
+    REQUIRE(::pipe(ends) == 0);
+
+    const int saved = ::dup(1);
+    ::dup2(ends[1], 1);  // a pipe is not a terminal, print keeps its lines in the buffer
+
+    print("a", 1, ' ', 2.5);
+    print("no newline", helix::endl(""));
+    print();
+
+    std::string before(64, '\0');
+    ::fcntl(ends[0], F_SETFL, O_NONBLOCK);
+    const auto early = ::read(ends[0], before.data(), before.size());
+
+    helix::std::flush_output();
+
+    std::string text(64, '\0');
+    const auto  read = ::read(ends[0], text.data(), text.size());
+
+    ::dup2(saved, 1);
+    ::close(saved);
+    ::close(ends[0]);
+    ::close(ends[1]);
+
+    REQUIRE(early < 0);  // nothing was written before the flush
+    REQUIRE(read > 0);
+    text.resize(static_cast<size_t>(read));
+    REQUIRE(text == "a1 2.5\nno newline\n");
+}
+
+TEST_CASE("the output of a task comes after the output that started it", "[runtime::print]") {
+    std::cout.flush();
+
+    int ends[2];
+    REQUIRE(::pipe(ends) == 0);
+
+    const int saved = ::dup(1);
+    ::dup2(ends[1], 1);
+
+    const auto task = []() -> helix::future<int> {
+        print("task");
+        co_return 1;
+    };
+
+    print("before");
+    const int value = helix::std::block_on(task());
+    print("after ", value);
+    helix::std::flush_output();
+
+    ::dup2(saved, 1);
+    ::close(saved);
+    ::close(ends[1]);
+
+    std::string text;
+    char        chunk[64];
+
+    for (auto read = ::read(ends[0], chunk, sizeof(chunk)); read > 0;
+         read      = ::read(ends[0], chunk, sizeof(chunk))) {
+        text.append(chunk, static_cast<size_t>(read));
+    }
+
+    ::close(ends[0]);
+
+    REQUIRE(text == "before\ntask\nafter 1\n");
+}
+#endif
@@ -0,0 +1,131 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <algorithm>
+#include <catch2>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+TEST_CASE("par_for visits every index once", "[runtime::par_for]") {
+    std::vector<int> hits(10'000, 0);
+
+    helix::std::par_for(0, 10'000, [&](int i) { ++hits[static_cast<size_t>(i)]; }, 7);
+
+    REQUIRE(std::all_of(hits.begin(), hits.end(), [](int hit) { return hit == 1; }));
+
+    SECTION("an empty or reversed range runs nothing") {
+        int calls = 0;
+
+        helix::std::par_for(5, 5, [&](int) { ++calls; });
+        helix::std::par_for(5, 2, [&](int) { ++calls; });
+
+        REQUIRE(calls == 0);
+    }
+}
+
+TEST_CASE("par_each and par_map keep every element", "[runtime::par_map]") {
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<int> seen(values.size(), 0);
+    helix::std::par_each(values, [&](int value) { seen[static_cast<size_t>(value)] = 1; }, 3);
+
+    REQUIRE(std::accumulate(seen.begin(), seen.end(), 0) == 1'000);
+
+    const auto squares = helix::std::par_map(values, [](int value) { return value * value; }, 9);
+    const auto odd     = helix::std::par_map(values, [](int value) { return value % 2 == 1; });
+
+    REQUIRE(squares.size() == values.size());
+    REQUIRE(squares[999] == 999 * 999);
+    REQUIRE(odd[1]);
+    REQUIRE_FALSE(odd[2]);
+}
+
+TEST_CASE("par_reduce matches std::accumulate", "[runtime::par_reduce]") {
+    std::vector<int> twos(1'000, 2);
+
+    SECTION("into another type with an identity and a combine") {
+        const auto square_sum = [](double acc, int value) { return acc + value * value; };
+        const auto plus       = [](double a, double b) { return a + b; };
+
+        const double expected = std::accumulate(twos.begin(), twos.end(), 0.0, square_sum);
+
+        REQUIRE(expected == 4000.0);
+        REQUIRE(helix::std::par_reduce(twos, 0.0, square_sum, plus) == expected);
+        REQUIRE(helix::std::par_reduce(twos, 0.0, square_sum, plus, 1) == expected);
+        REQUIRE(helix::std::par_reduce(twos, 0.0, square_sum, plus, 999) == expected);
+    }
+
+    SECTION("of the element type with one associative op") {
+        std::mt19937_64            rng(7);
+        std::vector<std::uint64_t> values(12'345);
+
+        for (auto &value : values) {
+            value = rng() % 1'000;
+        }
+
+        const auto plus = [](std::uint64_t a, std::uint64_t b) { return a + b; };
+        const auto max  = [](std::uint64_t a, std::uint64_t b) { return std::max(a, b); };
+
+        REQUIRE(helix::std::par_reduce(values, std::uint64_t{5}, plus, 100) ==
+                std::accumulate(values.begin(), values.end(), std::uint64_t{5}));
+        REQUIRE(helix::std::par_reduce(values, std::uint64_t{0}, max) ==
+                *std::max_element(values.begin(), values.end()));
+    }
+
+    SECTION("an empty list is the init or the identity") {
+        const std::vector<int> empty;
+
+        REQUIRE(helix::std::par_reduce(empty, 3, [](int a, int b) { return a + b; }) == 3);
+        REQUIRE(helix::std::par_reduce(
+                    empty,
+                    0.5,
+                    [](double acc, int value) { return acc + value; },
+                    [](double a, double b) { return a + b; }) == 0.5);
+    }
+}
+
+TEST_CASE("par_sort sorts and is deterministic", "[runtime::par_sort]") {
+    std::mt19937_64  rng(42);
+    std::vector<int> values(50'000);
+
+    for (auto &value : values) {
+        value = static_cast<int>(rng() % 100'000);
+    }
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    helix::std::par_sort(values, std::less<>(), 1'000);
+    REQUIRE(values == expected);
+
+    SECTION("equal keys land in the same order on every run") {
+        std::vector<std::pair<int, int>> pairs;
+
+        for (int i = 0; i < 20'000; ++i) {
+            pairs.emplace_back(static_cast<int>(rng() % 10), i);
+        }
+
+        const auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+        auto       again  = pairs;
+
+        helix::std::par_sort(pairs, by_key, 512);
+        helix::std::par_sort(again, by_key, 512);
+
+        REQUIRE(std::is_sorted(pairs.begin(), pairs.end(), by_key));
+        REQUIRE(pairs == again);
+    }
+}
@@ -0,0 +1,72 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <atomic>
+#include <catch2>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+// what a counted for over `first..=last` or `(first..last).step_by(step)` lowers to
+template <bool Inclusive, typename T>
+std::vector<T> counted(T first, T last, T step) {
+    std::vector<T> seen;
+
+    for (T i = first, end = last, by = step, more = helix::std::range_first<Inclusive>(i, end, by);
+         more;
+         more = helix::std::range_next<Inclusive>(i, end, by)) {
+        seen.push_back(i);
+    }
+
+    return seen;
+}
+}  // namespace
+
+TEST_CASE("an inclusive range ends at the maximum of its type", "[runtime::range]") {
+    std::vector<std::uint8_t> seen;
+
+    for (std::uint8_t i = 250, end = 255, more = helix::std::range_first<true>(i, end); more;
+         more = helix::std::range_next<true>(i, end)) {
+        seen.push_back(i);
+    }
+
+    REQUIRE(seen == std::vector<std::uint8_t>{250, 251, 252, 253, 254, 255});
+}
+
+TEST_CASE("a stepped range never steps past the end", "[runtime::range]") {
+    constexpr int max = std::numeric_limits<int>::max();
+    constexpr int min = std::numeric_limits<int>::min();
+
+    REQUIRE(counted<false>(0, 10, 5) == std::vector<int>{0, 5});
+    REQUIRE(counted<true>(0, 10, 5) == std::vector<int>{0, 5, 10});
+    REQUIRE(counted<true>(max - 6, max, 3) == std::vector<int>{max - 6, max - 3, max});
+    REQUIRE(counted<false>(min, max, max) == std::vector<int>{min, -1, max - 1});
+    REQUIRE(counted<true>(3, 1, 1).empty());
+
+    REQUIRE_THROWS_AS(counted<false>(0, 10, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(counted<true>(0, 10, -1), std::invalid_argument);
+}
+
+TEST_CASE("par_for_to includes the maximum of its type", "[runtime::par_for]") {
+    std::atomic<int> calls{0};
+
+    helix::std::par_for_to(std::uint8_t{0}, std::uint8_t{255}, [&](std::uint8_t) { ++calls; });
+    REQUIRE(calls == 256);
+
+    calls = 0;
+    helix::std::par_for_to(1, 0, [&](int) { ++calls; });
+    REQUIRE(calls == 0);
+}
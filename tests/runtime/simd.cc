@@ -0,0 +1,78 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <array>
+#include <catch2>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+using i32x4 = helix::simd<std::int32_t, 4>;
+
+TEST_CASE("simd load fills the lanes past the end with 0", "[runtime::simd]") {
+    const std::vector<std::int32_t> values = {1, 2, 3, 4, 5, 6};
+
+    const auto full = i32x4::load(values, 0);
+    const auto tail = i32x4::load(values, 4);
+    const auto none = i32x4::load(values, 6);
+
+    for (size_t lane = 0; lane < 4; ++lane) {
+        REQUIRE(full[lane] == values[lane]);
+        REQUIRE(none[lane] == 0);
+    }
+
+    REQUIRE(tail[0] == 5);
+    REQUIRE(tail[1] == 6);
+    REQUIRE(tail[2] == 0);
+    REQUIRE(tail[3] == 0);
+
+    REQUIRE_THROWS_AS(i32x4::load(values, 7), std::out_of_range);
+}
+
+TEST_CASE("simd store drops the lanes past the end", "[runtime::simd]") {
+    // the span is a prefix of a bigger buffer, a store past its size would show up in the rest
+    std::array<std::int32_t, 8> buffer{};
+    buffer.fill(-1);
+
+    std::span<std::int32_t> values(buffer.data(), 6);
+
+    i32x4(7).store(values, 0);
+    i32x4(9).store(values, 4);
+    i32x4(3).store(values, 6);  // empty, nothing to write
+
+    REQUIRE(buffer == std::array<std::int32_t, 8>{7, 7, 7, 7, 9, 9, -1, -1});
+    REQUIRE_THROWS_AS(i32x4(1).store(values, 7), std::out_of_range);
+}
+
+TEST_CASE("a loop over a list with a short last chunk", "[runtime::simd]") {
+    std::vector<std::int32_t> values(10);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<std::int32_t>(i + 1);
+    }
+
+    std::int32_t sum = 0;
+
+    for (size_t offset = 0; offset < values.size(); offset += i32x4::size()) {
+        const auto chunk = i32x4::load(values, offset);
+
+        (chunk * i32x4(2)).store(values, offset);
+        sum += reduce_add(chunk);
+    }
+
+    REQUIRE(sum == 55);
+    REQUIRE(values.back() == 20);
+    REQUIRE(values.size() == 10);
+}
@@ -0,0 +1,134 @@
+//===------------------------------------------ C++ ------------------------------------------====//
+//                                                                                                //
+//  Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).       //
+//  You are allowed to use, modify, redistribute, and create derivative works, even for           //
+//  commercial purposes, provided that you give appropriate credit, and indicate if changes       //
+//   were made. For more information, please visit: https://creativecommons.org/licenses/by/4.0/  //
+//                                                                                                //
+//  SPDX-License-Identifier: CC-BY-4.0                                                            //
+//  Copyright (c) 2024 (CC BY 4.0)                                                                //
+//                                                                                                //
+//====----------------------------------------------------------------------------------------====//
+
+#include <catch2>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "_H1HJA9ZLO_prelude.hh"
+
+namespace {
+// counts the live objects, an element constructed twice or never destroyed shows up here
+struct Tracked {
+    static inline int live = 0;
+
+    explicit Tracked(int value)
+        : value(value) {
+        ++live;
+    }
+    Tracked(const Tracked &other)
+        : value(other.value) {
+        ++live;
+    }
+    Tracked(Tracked &&other) noexcept
+        : value(other.value) {
+        ++live;
+    }
+    Tracked &operator=(const Tracked &) = default;
+    Tracked &operator=(Tracked &&)      = default;
+    ~Tracked() { --live; }
+
+    int value;
+};
+}  // namespace
+
+TEST_CASE("small_vector stays inline up to N and spills past it", "[runtime::small_vector]") {
+    helix::std::small_vector<int, 4> values = {1, 2, 3};
+
+    REQUIRE(values.is_inline());
+    REQUIRE(values.capacity() == 4);
+
+    values.push_back(4);
+    REQUIRE(values.is_inline());
+
+    values.push_back(5);
+    REQUIRE_FALSE(values.is_inline());
+    REQUIRE(values == helix::std::small_vector<int, 4>{1, 2, 3, 4, 5});
+    REQUIRE(static_cast<std::vector<int>>(values) == std::vector<int>{1, 2, 3, 4, 5});
+
+    REQUIRE_THROWS_AS(values.at(5), std::out_of_range);
+}
+
+TEST_CASE("small_vector insert and erase keep the order", "[runtime::small_vector]") {
+    helix::std::small_vector<std::string, 2> words = {"b", "d"};
+
+    words.insert(words.begin(), "a");
+    words.insert(words.begin() + 2, "c");
+    words.insert(words.end(), "e");
+
+    REQUIRE(std::vector<std::string>(words.begin(), words.end()) ==
+            std::vector<std::string>{"a", "b", "c", "d", "e"});
+
+    words.erase(words.begin() + 1, words.begin() + 3);
+    words.erase(words.begin());
+
+    REQUIRE(std::vector<std::string>(words.begin(), words.end()) ==
+            std::vector<std::string>{"d", "e"});
+}
+
+TEST_CASE("small_vector copies, moves and destroys every element once",
+          "[runtime::small_vector]") {
+    Tracked::live = 0;
+
+    {
+        helix::std::small_vector<Tracked, 2> inline_values;
+        inline_values.emplace_back(1);
+        inline_values.emplace_back(2);
+
+        helix::std::small_vector<Tracked, 2> heap_values = inline_values;
+        heap_values.emplace_back(3);
+        REQUIRE(Tracked::live == 5);
+
+        auto moved_inline = std::move(inline_values);
+        auto moved_heap   = std::move(heap_values);
+
+        REQUIRE(moved_inline.size() == 2);
+        REQUIRE(moved_heap.size() == 3);
+        REQUIRE(moved_heap.back().value == 3);
+
+        moved_heap.resize(1, Tracked(0));
+        moved_inline.clear();
+        REQUIRE(Tracked::live == 1);
+    }
+
+    REQUIRE(Tracked::live == 0);
+}
+
+TEST_CASE("small_vector_of sizes the inline capacity from the literal",
+          "[runtime::small_vector]") {
+    helix::std::small_vector_of<int, 2> pair  = {1, 2};
+    helix::std::small_vector_of<int, 8> eight = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    REQUIRE(pair.capacity() == 4);
+    REQUIRE(eight.capacity() == 16);
+
+    eight.push_back(9);  // a literal that is grown has room for more than its elements
+    REQUIRE(eight.is_inline());
+}
+
+TEST_CASE("small_string appends a view of itself", "[runtime::small_vector]") {
+    helix::std::small_string<4> text = "ab";
+
+    text += text;  // inline to the heap
+    REQUIRE(text == "abab");
+    REQUIRE_FALSE(text.is_inline());
+
+    text.append(text);  // the heap block the view points into is replaced
+    REQUIRE(text == "abababab");
+
+    text.append(std::string_view(text).substr(2, 4));  // a part in the middle
+    REQUIRE(text == "abababababab");
+    REQUIRE(std::string_view(text.c_str()) == "abababababab");
+}
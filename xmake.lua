@@ -16,7 +16,7 @@ function install_llvm_clang(package)
 	local threads_avaliable = os.cpuinfo("ncpu") - 3
 	local configs = {}
 
-	table.insert(configs, "-DLLVM_ENABLE_PROJECTS=clang")
+	table.insert(configs, "-DLLVM_ENABLE_PROJECTS=clang;lld")  -- lld is linked in, see clang_backend.hh
 	table.insert(configs, "-DCMAKE_BUILD_TYPE=Release")                      -- always build in release mode
 
 	table.insert(configs, "-DLLVM_ENABLE_ZSTD=ON")                           -- disable ZSTD support
@@ -334,18 +334,61 @@ setup_env()
 
 helix_src_setup()
 
+-- writes the prelude (a string inside the compiler) to $(buildir)/prelude as the header the
+-- generated code includes, so the runtime tests and the benchmarks can compile against it
+target("dump-prelude")
+    set_kind("binary")
+    set_default(false)
+    remove_files("source/**.cc", "libs/neo-panic/**.cc") -- only the prelude header is needed
+    add_files("benchmarks/prelude/dump_prelude.cc")
+
+    after_build(function (target)
+        import("core.project.config")
+
+        local prelude_dir = path.join(config.buildir(), "prelude")
+        os.mkdir(prelude_dir)
+        os.execv(target:targetfile(), {}, {stdout = path.join(prelude_dir, "_H1HJA9ZLO_prelude.hh")})
+    end)
+target_end()
+
 target("tests")
     set_kind("binary")
     add_files("tests/**.cc")        -- add all files in the tests directory
     add_includedirs("tests/lib")    -- add all libs in the tests dir
 
     remove_files("source/helix.cc") -- exclude main from the source directory
+
+    add_deps("dump-prelude")                                -- tests/runtime include the prelude
+    add_includedirs("$(buildir)/prelude")
+    set_policy("build.across_targets_in_parallel", false)  -- the header exists before compiling
 target_end()
 
+-- one target per benchmark, `xmake build bench-hash_map && xmake run bench-hash_map`
+for _, file in ipairs(os.files("benchmarks/*.cc")) do
+    target("bench-" .. path.basename(file))
+        set_kind("binary")
+        set_default(false)
+        remove_files("source/**.cc", "libs/neo-panic/**.cc")
+        add_files(file)
+
+        add_deps("dump-prelude")
+        add_includedirs("$(buildir)/prelude")
+        set_policy("build.across_targets_in_parallel", false)
+    target_end()
+end
+
 target("helix") -- target config defined in the config seciton
     before_build(function (target)
         print_all_info()
     end)
+    after_build(function (target) -- the in-process clang looks for its headers next to helix
+        local llvm_clang = target:pkg("llvm-clang")
+        if llvm_clang then
+            local lib_dir = path.join(path.directory(target:targetdir()), "lib")
+            os.mkdir(lib_dir)
+            os.cp(path.join(llvm_clang:installdir(), "lib", "clang"), lib_dir)
+        end
+    end)
     set_kind("binary")
     set_languages(cxx_standard)
 target_end() -- empty target